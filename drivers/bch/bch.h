@@ -48,6 +48,10 @@
 #include <semaphore.h>
 #include <nuttx/fs/fs.h>
 
+#ifdef CONFIG_BCH_BLKCACHE
+#  include <nuttx/drivers/blkcache.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -55,6 +59,20 @@
 #define bchlib_semgive(d) nxsem_post(&(d)->sem)  /* To match bchlib_semtake */
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+/* Sector transfers to and from the block driver */
+
+#ifdef CONFIG_BCH_BLKCACHE
+#  define bchlib_hwread(b,p,s,n)  blkcache_read(&(b)->cache, p, s, n)
+#  define bchlib_hwwrite(b,p,s,n) blkcache_write(&(b)->cache, p, s, n)
+#  define bchlib_hwflush(b)       blkcache_flush(&(b)->cache)
+#else
+#  define bchlib_hwread(b,p,s,n) \
+     (b)->inode->u.i_bops->read((b)->inode, p, s, n)
+#  define bchlib_hwwrite(b,p,s,n) \
+     (b)->inode->u.i_bops->write((b)->inode, p, s, n)
+#  define bchlib_hwflush(b)       (OK)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -72,6 +90,10 @@ struct bchlib_s
   bool unlinked;           /* true: The driver has been unlinked */
   FAR uint8_t *buffer;     /* One sector buffer */
 
+#ifdef CONFIG_BCH_BLKCACHE
+  struct blkcache_s cache; /* Cache of recently used sectors */
+#endif
+
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
 #endif
@@ -120,7 +120,6 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 
 int bchlib_flushsector(FAR struct bchlib_s *bch)
 {
-  FAR struct inode *inode;
   ssize_t ret = OK;
 
   /* Check if the sector has been modified and is out of synch with the
@@ -129,8 +128,6 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 
   if (bch->dirty)
     {
-      inode = bch->inode;
-
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Encrypt data as necessary */
 
@@ -139,7 +136,7 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 
       /* Write the sector to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+      ret = bchlib_hwwrite(bch, bch->buffer, bch->sector, 1);
       if (ret < 0)
         {
           ferr("Write failed: %d\n");
@@ -174,17 +171,14 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
-  FAR struct inode *inode;
   ssize_t ret = OK;
 
   if (bch->sector != sector)
     {
-      inode = bch->inode;
-
       (void)bchlib_flushsector(bch);
       bch->sector = (size_t)-1;
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      ret = bchlib_hwread(bch, bch->buffer, sector, 1);
       if (ret < 0)
         {
           ferr("Read failed: %d\n");
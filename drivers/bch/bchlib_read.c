@@ -154,8 +154,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
           nsectors = bch->nsectors - sector;
         }
 
-      ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-                                       sector, nsectors);
+      ret = bchlib_hwread(bch, (FAR uint8_t *)buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Read failed: %d\n");
@@ -134,6 +134,24 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
       goto errout_with_bch;
     }
 
+#ifdef CONFIG_BCH_BLKCACHE
+  /* Set up the cache of recently used sectors */
+
+  bch->cache.inode      = bch->inode;
+  bch->cache.sectsize   = bch->sectsize;
+  bch->cache.nsectors   = bch->nsectors;
+  bch->cache.nentries   = CONFIG_BCH_BLKCACHE_NSECTORS;
+  bch->cache.nreadahead = CONFIG_BCH_BLKCACHE_READAHEAD;
+
+  ret = blkcache_initialize(&bch->cache);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to allocate sector cache\n");
+      kmm_free(bch->buffer);
+      goto errout_with_bch;
+    }
+#endif
+
   *handle = bch;
   return OK;
 
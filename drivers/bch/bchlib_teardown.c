@@ -79,6 +79,12 @@ int bchlib_teardown(FAR void *handle)
 
   bchlib_flushsector(bch);
 
+#ifdef CONFIG_BCH_BLKCACHE
+  /* Write back and release the sector cache */
+
+  (void)blkcache_uninitialize(&bch->cache);
+#endif
+
   /* Close the block driver */
 
   (void)close_blockdriver(bch->inode);
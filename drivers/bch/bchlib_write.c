@@ -143,8 +143,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
       /* Write the contiguous sectors */
 
-      ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-                                        sector, nsectors);
+      ret = bchlib_hwwrite(bch, (FAR uint8_t *)buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Write failed: %d\n", ret);
@@ -187,6 +186,11 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
   /* Finally, flush any cached writes to the device as well */
 
   ret = bchlib_flushsector(bch);
+  if (ret >= 0)
+    {
+      ret = bchlib_hwflush(bch);
+    }
+
   if (ret < 0)
     {
       ferr("ERROR: Flush failed: %d\n", ret);
@@ -0,0 +1,642 @@
+/****************************************************************************
+ * drivers/blkcache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <sched.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/drivers/blkcache.h>
+
+#ifdef CONFIG_DRVR_BLKCACHE
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* A list of all caches, for procfs.  Protected by sched_lock(). */
+
+static FAR struct blkcache_s *g_blkcaches;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_find
+ *
+ * Description:
+ *   Return the entry holding 'sector' or NULL if the sector is not cached.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_entry_s *
+blkcache_find(FAR struct blkcache_s *cache, size_t sector)
+{
+  FAR struct blkcache_entry_s *entry;
+  int i;
+
+  for (i = 0; i < cache->nentries; i++)
+    {
+      entry = &cache->entries[i];
+      if (entry->valid && entry->sector == sector)
+        {
+          return entry;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: blkcache_touch
+ *
+ * Description:
+ *   Make 'entry' the most recently used entry.
+ *
+ ****************************************************************************/
+
+static void blkcache_touch(FAR struct blkcache_s *cache,
+                           FAR struct blkcache_entry_s *entry)
+{
+  if (cache->lru.head != &entry->node)
+    {
+      dq_rem(&entry->node, &cache->lru);
+      dq_addfirst(&entry->node, &cache->lru);
+    }
+}
+
+/****************************************************************************
+ * Name: blkcache_writeback
+ *
+ * Description:
+ *   Write 'entry' to the media if it is dirty.
+ *
+ ****************************************************************************/
+
+static int blkcache_writeback(FAR struct blkcache_s *cache,
+                              FAR struct blkcache_entry_s *entry)
+{
+  FAR struct inode *inode = cache->inode;
+  ssize_t ret;
+
+  if (entry->valid && entry->dirty)
+    {
+      ret = inode->u.i_bops->write(inode, entry->data, entry->sector, 1);
+      if (ret < 0)
+        {
+          ferr("ERROR: Write of sector %lu failed: %d\n",
+               (unsigned long)entry->sector, (int)ret);
+          return (int)ret;
+        }
+
+      entry->dirty = false;
+      cache->nwriteback++;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_evict
+ *
+ * Description:
+ *   Write back and invalidate the least recently used entry, then make it
+ *   the most recently used entry, holding 'sector'.  The caller must fill
+ *   in the data.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_entry_s *
+blkcache_evict(FAR struct blkcache_s *cache, size_t sector, FAR int *result)
+{
+  FAR struct blkcache_entry_s *entry;
+  int ret;
+
+  entry = (FAR struct blkcache_entry_s *)cache->lru.tail;
+  DEBUGASSERT(entry != NULL);
+
+  ret = blkcache_writeback(cache, entry);
+  if (ret < 0)
+    {
+      *result = ret;
+      return NULL;
+    }
+
+  entry->sector = sector;
+  entry->valid  = false;
+  blkcache_touch(cache, entry);
+  return entry;
+}
+
+/****************************************************************************
+ * Name: blkcache_fill
+ *
+ * Description:
+ *   Read 'sector' into the cache.  If the access continues a sequential
+ *   run, the sectors that follow are read in the same transfer.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_entry_s *
+blkcache_fill(FAR struct blkcache_s *cache, size_t sector, FAR int *result)
+{
+  FAR struct inode *inode = cache->inode;
+  FAR struct blkcache_entry_s *entry;
+  FAR struct blkcache_entry_s *next;
+  unsigned int nread = 1;
+  unsigned int i;
+  ssize_t ret;
+
+  /* Decide how far to read ahead.  Stop at the end of the media and at
+   * the first sector that is already cached (it may be dirty).
+   */
+
+  if (cache->rabuffer != NULL && sector == cache->nextsector)
+    {
+      while (nread <= cache->nreadahead &&
+             sector + nread < cache->nsectors &&
+             blkcache_find(cache, sector + nread) == NULL)
+        {
+          nread++;
+        }
+    }
+
+  entry = blkcache_evict(cache, sector, result);
+  if (entry == NULL)
+    {
+      return NULL;
+    }
+
+  if (nread == 1)
+    {
+      ret = inode->u.i_bops->read(inode, entry->data, sector, 1);
+    }
+  else
+    {
+      ret = inode->u.i_bops->read(inode, cache->rabuffer, sector, nread);
+    }
+
+  if (ret < 1)
+    {
+      ferr("ERROR: Read of sector %lu failed: %d\n",
+           (unsigned long)sector, (int)ret);
+      /* Make the unused entry the first to be reused */
+
+      dq_rem(&entry->node, &cache->lru);
+      dq_addlast(&entry->node, &cache->lru);
+
+      *result = ret < 0 ? (int)ret : -EIO;
+      return NULL;
+    }
+
+  if (nread > 1)
+    {
+      memcpy(entry->data, cache->rabuffer, cache->sectsize);
+
+      /* Install the sectors that were read ahead.  nreadahead is less than
+       * nentries, so this never evicts the requested sector.
+       */
+
+      for (i = 1; i < (unsigned int)ret; i++)
+        {
+          next = blkcache_evict(cache, sector + i, result);
+          if (next == NULL)
+            {
+              break;
+            }
+
+          memcpy(next->data, &cache->rabuffer[i * cache->sectsize],
+                 cache->sectsize);
+          next->valid = true;
+          cache->nprefetch++;
+        }
+
+      blkcache_touch(cache, entry);
+    }
+
+  entry->valid = true;
+  return entry;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_initialize
+ *
+ * Description:
+ *   Allocate the cache buffers and make the cache visible in
+ *   /proc/fs/blkcache.  The configuration fields of the cache structure
+ *   must have been set up by the caller.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int blkcache_initialize(FAR struct blkcache_s *cache)
+{
+  int i;
+
+  DEBUGASSERT(cache != NULL && cache->inode != NULL &&
+              cache->sectsize > 0 && cache->nentries > 0);
+
+  /* Read-ahead must leave room for the requested sector */
+
+  if (cache->nreadahead >= cache->nentries)
+    {
+      cache->nreadahead = cache->nentries - 1;
+    }
+
+  cache->entries = (FAR struct blkcache_entry_s *)
+    kmm_zalloc(cache->nentries * sizeof(struct blkcache_entry_s));
+  cache->buffer  = (FAR uint8_t *)
+    kmm_malloc(cache->nentries * cache->sectsize);
+
+  if (cache->nreadahead > 0)
+    {
+      cache->rabuffer = (FAR uint8_t *)
+        kmm_malloc((cache->nreadahead + 1) * cache->sectsize);
+    }
+
+  if (cache->entries == NULL || cache->buffer == NULL ||
+      (cache->nreadahead > 0 && cache->rabuffer == NULL))
+    {
+      ferr("ERROR: Failed to allocate the block cache\n");
+      (void)blkcache_uninitialize(cache);
+      return -ENOMEM;
+    }
+
+  dq_init(&cache->lru);
+  for (i = 0; i < cache->nentries; i++)
+    {
+      cache->entries[i].data = &cache->buffer[i * cache->sectsize];
+      dq_addlast(&cache->entries[i].node, &cache->lru);
+    }
+
+  cache->nextsector = (size_t)-1;
+  cache->nhits      = 0;
+  cache->nmisses    = 0;
+  cache->nprefetch  = 0;
+  cache->nwriteback = 0;
+
+  sched_lock();
+  cache->flink = g_blkcaches;
+  g_blkcaches  = cache;
+  sched_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_uninitialize
+ *
+ * Description:
+ *   Write back all dirty sectors and release the cache.  The cache is
+ *   released even if the write back fails.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the write back failed.
+ *
+ ****************************************************************************/
+
+int blkcache_uninitialize(FAR struct blkcache_s *cache)
+{
+  FAR struct blkcache_s **prev;
+  int ret = OK;
+
+  if (cache->entries != NULL && cache->buffer != NULL)
+    {
+      ret = blkcache_flush(cache);
+    }
+
+  sched_lock();
+  for (prev = &g_blkcaches; *prev != NULL; prev = &(*prev)->flink)
+    {
+      if (*prev == cache)
+        {
+          *prev = cache->flink;
+          break;
+        }
+    }
+
+  sched_unlock();
+
+  if (cache->entries != NULL)
+    {
+      kmm_free(cache->entries);
+      cache->entries = NULL;
+    }
+
+  if (cache->buffer != NULL)
+    {
+      kmm_free(cache->buffer);
+      cache->buffer = NULL;
+    }
+
+  if (cache->rabuffer != NULL)
+    {
+      kmm_free(cache->rabuffer);
+      cache->rabuffer = NULL;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:
+ *   Read 'nsectors' sectors beginning at 'start' into 'buffer'.
+ *
+ * Returned Value:
+ *   The number of sectors read or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_read(FAR struct blkcache_s *cache, FAR uint8_t *buffer,
+                      size_t start, unsigned int nsectors)
+{
+  FAR struct inode *inode = cache->inode;
+  FAR struct blkcache_entry_s *entry;
+  ssize_t ret;
+  int result;
+  int i;
+
+  if (nsectors == 1)
+    {
+      entry = blkcache_find(cache, start);
+      if (entry != NULL)
+        {
+          cache->nhits++;
+          blkcache_touch(cache, entry);
+        }
+      else
+        {
+          cache->nmisses++;
+          entry = blkcache_fill(cache, start, &result);
+          if (entry == NULL)
+            {
+              return result;
+            }
+        }
+
+      cache->nextsector = start + 1;
+      memcpy(buffer, entry->data, cache->sectsize);
+      return 1;
+    }
+
+  /* Larger transfers go directly to the media.  Any dirty cached copies
+   * are newer than the media and replace what was read.
+   */
+
+  ret = inode->u.i_bops->read(inode, buffer, start, nsectors);
+  if (ret <= 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < cache->nentries; i++)
+    {
+      entry = &cache->entries[i];
+      if (entry->valid && entry->dirty &&
+          entry->sector >= start && entry->sector < start + ret)
+        {
+          memcpy(&buffer[(entry->sector - start) * cache->sectsize],
+                 entry->data, cache->sectsize);
+        }
+    }
+
+  cache->nextsector = start + ret;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description:
+ *   Write 'nsectors' sectors beginning at 'start' from 'buffer'.  A single
+ *   sector is only written to the cache; larger transfers are written to
+ *   the media immediately.
+ *
+ * Returned Value:
+ *   The number of sectors written or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_write(FAR struct blkcache_s *cache,
+                       FAR const uint8_t *buffer, size_t start,
+                       unsigned int nsectors)
+{
+  FAR struct inode *inode = cache->inode;
+  FAR struct blkcache_entry_s *entry;
+  ssize_t ret;
+  int result;
+  int i;
+
+  if (nsectors == 1)
+    {
+      /* The whole sector is replaced, so a miss does not read the media */
+
+      entry = blkcache_find(cache, start);
+      if (entry != NULL)
+        {
+          cache->nhits++;
+          blkcache_touch(cache, entry);
+        }
+      else
+        {
+          cache->nmisses++;
+          entry = blkcache_evict(cache, start, &result);
+          if (entry == NULL)
+            {
+              return result;
+            }
+        }
+
+      memcpy(entry->data, buffer, cache->sectsize);
+      entry->valid = true;
+      entry->dirty = true;
+      return 1;
+    }
+
+  /* Larger transfers go directly to the media.  Cached copies are updated
+   * and are then clean.
+   */
+
+  ret = inode->u.i_bops->write(inode, buffer, start, nsectors);
+  if (ret <= 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < cache->nentries; i++)
+    {
+      entry = &cache->entries[i];
+      if (entry->valid &&
+          entry->sector >= start && entry->sector < start + ret)
+        {
+          memcpy(entry->data,
+                 &buffer[(entry->sector - start) * cache->sectsize],
+                 cache->sectsize);
+          entry->dirty = false;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   Write all dirty sectors back to the media.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int blkcache_flush(FAR struct blkcache_s *cache)
+{
+  int ret = OK;
+  int err;
+  int i;
+
+  /* Try every dirty sector, but report the first failure */
+
+  for (i = 0; i < cache->nentries; i++)
+    {
+      err = blkcache_writeback(cache, &cache->entries[i]);
+      if (err < 0 && ret == OK)
+        {
+          ret = err;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_discard
+ *
+ * Description:
+ *   Invalidate all cached sectors without writing back the dirty ones.
+ *   This is used when the media has been removed or changed and the cached
+ *   sectors no longer belong to it.
+ *
+ ****************************************************************************/
+
+void blkcache_discard(FAR struct blkcache_s *cache)
+{
+  int i;
+
+  for (i = 0; i < cache->nentries; i++)
+    {
+      cache->entries[i].valid = false;
+      cache->entries[i].dirty = false;
+    }
+
+  cache->nextsector = (size_t)-1;
+}
+
+/****************************************************************************
+ * Name: blkcache_info
+ *
+ * Description:
+ *   Return a snapshot of the 'ndx'th cache.  This is used by procfs to
+ *   enumerate all caches.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such cache.
+ *
+ ****************************************************************************/
+
+int blkcache_info(int ndx, FAR struct blkcacheinfo_s *info)
+{
+  FAR struct blkcache_s *cache;
+  int ret = -ENOENT;
+  int i;
+
+  sched_lock();
+  for (cache = g_blkcaches; cache != NULL && ndx > 0; cache = cache->flink)
+    {
+      ndx--;
+    }
+
+  if (cache != NULL)
+    {
+      strncpy(info->name, cache->inode->i_name, NAME_MAX);
+      info->name[NAME_MAX] = '\0';
+
+      info->sectsize   = cache->sectsize;
+      info->nentries   = cache->nentries;
+      info->ndirty     = 0;
+      info->nhits      = cache->nhits;
+      info->nmisses    = cache->nmisses;
+      info->nprefetch  = cache->nprefetch;
+      info->nwriteback = cache->nwriteback;
+
+      for (i = 0; i < cache->nentries; i++)
+        {
+          if (cache->entries[i].valid && cache->entries[i].dirty)
+            {
+              info->ndirty++;
+            }
+        }
+
+      ret = OK;
+    }
+
+  sched_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_DRVR_BLKCACHE */
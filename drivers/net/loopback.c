@@ -78,6 +78,15 @@
 
 #define LO_WDDELAY   (1*CLK_TCK)
 
+/* With CONFIG_NETDEV_IOB, frames are carried in I/O buffers.  Each frame
+ * sent during a poll is detached and queued, and the queued batch is then
+ * looped back once the poll completes.
+ */
+
+#if defined(CONFIG_NETDEV_IOB) && CONFIG_IOB_NCHAINS > 0
+#  define LO_IOB 1
+#endif
+
 /* This is a helper pointer for accessing the contents of the Ethernet header */
 
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)priv->lo_dev.d_buf)
@@ -97,6 +106,9 @@ struct lo_driver_s
   bool lo_txdone;              /* One RX packet was looped back */
   WDOG_ID lo_polldog;          /* TX poll timer */
   struct work_s lo_work;       /* For deferring poll work to the work queue */
+#ifdef LO_IOB
+  struct iob_queue_s lo_loopq; /* Frames waiting to be looped back */
+#endif
 
   /* This holds the information visible to the NuttX network */
 
@@ -108,7 +120,9 @@ struct lo_driver_s
  ****************************************************************************/
 
 static struct lo_driver_s g_loopback;
+#ifndef LO_IOB
 static uint8_t g_iobuffer[MAX_NET_DEV_MTU + CONFIG_NET_GUARDSIZE];
+#endif
 
 /****************************************************************************
  * Private Function Prototypes
@@ -116,7 +130,12 @@ static uint8_t g_iobuffer[MAX_NET_DEV_MTU + CONFIG_NET_GUARDSIZE];
 
 /* Polling logic */
 
+static void lo_input(FAR struct lo_driver_s *priv);
+#ifdef LO_IOB
+static void lo_loopback(FAR struct lo_driver_s *priv);
+#endif
 static int  lo_txpoll(FAR struct net_driver_s *dev);
+static void lo_poll(FAR struct lo_driver_s *priv, bool timer);
 static void lo_poll_work(FAR void *arg);
 static void lo_poll_expiry(int argc, wdparm_t arg, ...);
 
@@ -135,6 +154,120 @@ static int lo_rmmac(FAR struct net_driver_s *dev, FAR const uint8_t *mac);
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: lo_input
+ *
+ * Description:
+ *   Pass the d_len byte frame in d_buf back into the network.  Upon return,
+ *   d_len is non-zero if the network generated a reply in d_buf.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void lo_input(FAR struct lo_driver_s *priv)
+{
+  NETDEV_RXPACKETS(&priv->lo_dev);
+
+#ifdef CONFIG_NET_PKT
+  /* When packet sockets are enabled, feed the frame into the packet tap */
+
+  pkt_input(&priv->lo_dev);
+#endif
+
+  /* We only accept IP packets of the configured type and ARP packets */
+
+#ifdef CONFIG_NET_IPv4
+  if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      ninfo("IPv4 frame\n");
+      NETDEV_RXIPV4(&priv->lo_dev);
+      ipv4_input(&priv->lo_dev);
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      ninfo("Iv6 frame\n");
+      NETDEV_RXIPV6(&priv->lo_dev);
+      ipv6_input(&priv->lo_dev);
+    }
+  else
+#endif
+    {
+      nwarn("WARNING: Unrecognized IP version\n");
+      NETDEV_RXDROPPED(&priv->lo_dev);
+      priv->lo_dev.d_len = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: lo_loopback
+ *
+ * Description:
+ *   Loop back the batch of frames queued by lo_txpoll().  Replies that the
+ *   network generates while processing the batch are queued behind it and
+ *   looped back in the same pass.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef LO_IOB
+static void lo_loopback(FAR struct lo_driver_s *priv)
+{
+  FAR struct net_driver_s *dev = &priv->lo_dev;
+  FAR struct iob_s *iob;
+
+  while ((iob = iob_remove_queue(&priv->lo_loopq)) != NULL)
+    {
+      /* Attach the frame to the device.  This frees the I/O buffer that
+       * was used during the poll or by the previous frame.
+       */
+
+      if (netdev_iob_replace(dev, iob) < 0)
+        {
+          NETDEV_RXERRORS(dev);
+          iob_free_chain(iob);
+          continue;
+        }
+
+      lo_input(priv);
+      priv->lo_txdone = true;
+      NETDEV_TXDONE(dev);
+
+      /* Queue any reply behind the rest of the batch */
+
+      if (dev->d_len > 0)
+        {
+          NETDEV_TXPACKETS(dev);
+
+          iob = netdev_iob_release(dev);
+          if (iob_tryadd_queue(iob, &priv->lo_loopq) < 0)
+            {
+              NETDEV_TXERRORS(dev);
+              iob_free_chain(iob);
+            }
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: lo_txpoll
  *
@@ -158,7 +291,36 @@ static int lo_rmmac(FAR struct net_driver_s *dev, FAR const uint8_t *mac);
 static int lo_txpoll(FAR struct net_driver_s *dev)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
+#ifdef LO_IOB
+  FAR struct iob_s *iob;
+
+  /* Detach the "sent" frame and queue it.  It will be looped back with
+   * the rest of the batch when the poll completes.
+   */
+
+  if (priv->lo_dev.d_len > 0)
+    {
+      NETDEV_TXPACKETS(&priv->lo_dev);
+
+      iob = netdev_iob_release(&priv->lo_dev);
+      if (iob_tryadd_queue(iob, &priv->lo_loopq) < 0)
+        {
+          NETDEV_TXERRORS(&priv->lo_dev);
+          iob_free_chain(iob);
+        }
+
+      /* Get a fresh buffer for the remainder of the poll.  If there is
+       * none, stop polling; lo_poll() will poll again once the queued
+       * frames have been looped back.
+       */
+
+      if (netdev_iob_prepare(&priv->lo_dev, false) < 0)
+        {
+          return 1;
+        }
+    }
 
+#else
   /* Loop while there is data "sent", i.e., while d_len > 0.  That should be
    * the case upon entry here and while the processing of the IPv4/6 packet
    * generates a new packet to be sent.  Sending, of course, just means
@@ -167,46 +329,59 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
 
   while (priv->lo_dev.d_len > 0)
     {
-       NETDEV_TXPACKETS(&priv->lo_dev);
-       NETDEV_RXPACKETS(&priv->lo_dev);
-
-#ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the packet tap */
+      NETDEV_TXPACKETS(&priv->lo_dev);
+      lo_input(priv);
 
-       pkt_input(&priv->lo_dev);
+      priv->lo_txdone = true;
+      NETDEV_TXDONE(&priv->lo_dev);
+    }
 #endif
 
-      /* We only accept IP packets of the configured type and ARP packets */
+  return 0;
+}
 
-#ifdef CONFIG_NET_IPv4
-      if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
-        {
-          ninfo("IPv4 frame\n");
-          NETDEV_RXIPV4(&priv->lo_dev);
-          ipv4_input(&priv->lo_dev);
-        }
-      else
-#endif
-#ifdef CONFIG_NET_IPv6
-      if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
-        {
-          ninfo("Iv6 frame\n");
-          NETDEV_RXIPV6(&priv->lo_dev);
-          ipv6_input(&priv->lo_dev);
-        }
-      else
+/****************************************************************************
+ * Name: lo_poll
+ *
+ * Description:
+ *   Poll the network for frames to loop back.  lo_txdone is set on return
+ *   if any frame was looped back and the network should be polled again.
+ *
+ * Input Parameters:
+ *   priv  - Reference to the driver state structure
+ *   timer - True: perform the periodic timer poll
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void lo_poll(FAR struct lo_driver_s *priv, bool timer)
+{
+  priv->lo_txdone = false;
+
+#ifdef LO_IOB
+  if (netdev_iob_prepare(&priv->lo_dev, false) < 0)
+    {
+      return;
+    }
 #endif
-        {
-          nwarn("WARNING: Unrecognized IP version\n");
-          NETDEV_RXDROPPED(&priv->lo_dev);
-          priv->lo_dev.d_len = 0;
-        }
 
-      priv->lo_txdone = true;
-      NETDEV_TXDONE(&priv->lo_dev);
+  if (timer)
+    {
+      (void)devif_timer(&priv->lo_dev, lo_txpoll);
+    }
+  else
+    {
+      (void)devif_poll(&priv->lo_dev, lo_txpoll);
     }
 
-  return 0;
+#ifdef LO_IOB
+  lo_loopback(priv);
+#endif
 }
 
 /****************************************************************************
@@ -233,8 +408,7 @@ static void lo_poll_work(FAR void *arg)
   /* Perform the poll */
 
   net_lock();
-  priv->lo_txdone = false;
-  (void)devif_timer(&priv->lo_dev, lo_txpoll);
+  lo_poll(priv, true);
 
   /* Was something received and looped back? */
 
@@ -242,8 +416,7 @@ static void lo_poll_work(FAR void *arg)
     {
       /* Yes, poll again for more TX data */
 
-      priv->lo_txdone = false;
-      (void)devif_poll(&priv->lo_dev, lo_txpoll);
+      lo_poll(priv, false);
     }
 
   /* Setup the watchdog poll timer again */
@@ -381,8 +554,7 @@ static void lo_txavail_work(FAR void *arg)
         {
           /* If so, then poll the network for new XMIT data */
 
-          priv->lo_txdone = false;
-          (void)devif_poll(&priv->lo_dev, lo_txpoll);
+          lo_poll(priv, false);
         }
       while (priv->lo_txdone);
     }
@@ -518,7 +690,9 @@ int localhost_initialize(void)
   priv->lo_dev.d_addmac  = lo_addmac;    /* Add multicast MAC address */
   priv->lo_dev.d_rmmac   = lo_rmmac;     /* Remove multicast MAC address */
 #endif
+#ifndef LO_IOB
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
+#endif
   priv->lo_dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
 
   /* Create a watchdog for timing polling for and timing of transmissions */
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <time.h>
 #include <string.h>
@@ -113,6 +114,9 @@ struct skel_driver_s
   WDOG_ID sk_txtimeout;        /* TX timeout timer */
   struct work_s sk_irqwork;    /* For deferring interrupt work to the work queue */
   struct work_s sk_pollwork;   /* For deferring poll work to the work queue */
+#ifdef CONFIG_NETDEV_NAPI
+  struct netdev_napi_s sk_napi; /* Batched receive state */
+#endif
 
   /* This holds the information visible to the NuttX network */
 
@@ -157,7 +161,11 @@ static int  skel_txpoll(FAR struct net_driver_s *dev);
 /* Interrupt handling */
 
 static void skel_reply(struct skel_driver_s *priv)
-static void skel_receive(FAR struct skel_driver_s *priv);
+static int  skel_receive(FAR struct skel_driver_s *priv, int budget);
+#ifdef CONFIG_NETDEV_NAPI
+static int  skel_rxpoll(FAR struct net_driver_s *dev, int budget);
+static void skel_rxint(FAR struct net_driver_s *dev, bool enable);
+#endif
 static void skel_txdone(FAR struct skel_driver_s *priv);
 
 static void skel_interrupt_work(FAR void *arg);
@@ -374,20 +382,33 @@ static void skel_reply(struct skel_driver_s *priv)
  *   An interrupt was received indicating the availability of a new RX packet
  *
  * Input Parameters:
- *   priv - Reference to the driver state structure
+ *   priv   - Reference to the driver state structure
+ *   budget - The maximum number of packets to receive
  *
  * Returned Value:
- *   None
+ *   The number of packets received
  *
  * Assumptions:
  *   The network is locked.
  *
  ****************************************************************************/
 
-static void skel_receive(FAR struct skel_driver_s *priv)
+static int skel_receive(FAR struct skel_driver_s *priv, int budget)
 {
-  do
+  int nrecvd;
+
+  /* While there are more packets to be processed and the budget allows */
+
+  for (nrecvd = 0; nrecvd < budget; nrecvd++)
     {
+      /* TODO: Determine if there are no more RX packets to be processed */
+
+        {
+          /* If so, stop before the budget is used up */
+
+          break;
+        }
+
       /* Check for errors and update statistics */
 
       /* Check if the packet is a valid size for the network buffer
@@ -464,8 +485,65 @@ static void skel_receive(FAR struct skel_driver_s *priv)
           NETDEV_RXDROPPED(&priv->sk_dev);
         }
     }
-  while (); /* While there are more packets to be processed */
+
+  return nrecvd;
+}
+
+/****************************************************************************
+ * Name: skel_rxpoll
+ *
+ * Description:
+ *   Receive a batch of packets.  This is the batched receive poll method
+ *   called by the network on the work queue.
+ *
+ * Input Parameters:
+ *   dev    - Reference to the NuttX driver state structure
+ *   budget - The maximum number of packets to receive
+ *
+ * Returned Value:
+ *   The number of packets received
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static int skel_rxpoll(FAR struct net_driver_s *dev, int budget)
+{
+  FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)dev->d_private;
+
+  return skel_receive(priv, budget);
 }
+#endif
+
+/****************************************************************************
+ * Name: skel_rxint
+ *
+ * Description:
+ *   Mask or unmask the RX interrupt.  While masked, received packets are
+ *   collected by skel_rxpoll().
+ *
+ * Input Parameters:
+ *   dev    - Reference to the NuttX driver state structure
+ *   enable - True: unmask the RX interrupt
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from the interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static void skel_rxint(FAR struct net_driver_s *dev, bool enable)
+{
+  /* Set or clear the RX interrupt enable bit.  If packets are already
+   * pending when the interrupt is enabled, the interrupt must fire.
+   */
+}
+#endif
 
 /****************************************************************************
  * Name: skel_txdone
@@ -542,9 +620,11 @@ static void skel_interrupt_work(FAR void *arg)
 
   /* Handle interrupts according to status bit settings */
 
+#ifndef CONFIG_NETDEV_NAPI
   /* Check if we received an incoming packet, if so, call skel_receive() */
 
-  skel_receive(priv);
+  skel_receive(priv, INT_MAX);
+#endif
 
   /* Check if a packet transmission just completed.  If so, call skel_txdone.
    * This may disable further Tx interrupts if there are no pending
@@ -591,6 +671,18 @@ static int skel_interrupt(int irq, FAR void *context, FAR void *arg)
 
   up_disable_irq(CONFIG_skeleton_IRQ);
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* TODO: Determine if a RX packet is available */
+
+    {
+      /* If so, mask the RX interrupt and receive in batches on the worker
+       * thread until the hardware is drained.
+       */
+
+      netdev_napi_schedule(&priv->sk_napi);
+    }
+#endif
+
   /* TODO: Determine if a TX transfer just completed */
 
     {
@@ -847,6 +939,12 @@ static int skel_ifdown(FAR struct net_driver_s *dev)
   wd_cancel(priv->sk_txpoll);
   wd_cancel(priv->sk_txtimeout);
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Cancel any pending batched receive */
+
+  netdev_napi_cancel(&priv->sk_napi);
+#endif
+
   /* Put the EMAC in its reset, non-operational state.  This should be
    * a known configuration that will guarantee the skel_ifup() always
    * successfully brings the interface back up.
@@ -1172,6 +1270,13 @@ int skel_initialize(int intf)
 
   DEBUGASSERT(priv->sk_txpoll != NULL && priv->sk_txtimeout != NULL);
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Initialize batched receive */
+
+  netdev_napi_initialize(&priv->sk_napi, &priv->sk_dev, ETHWORK,
+                         skel_rxpoll, skel_rxint);
+#endif
+
   /* Put the interface in the down state.  This usually amounts to resetting
    * the device and/or calling skel_ifdown().
    */
@@ -43,6 +43,14 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values of cn_flags */
+
+#define CROMFS_NODE_BLKTAB 0x0001 /* Regular file with a block offset table */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -115,12 +123,19 @@ struct cromfs_volume_s
  *                Return 0
  *   st_ctime   - Time of last status change
  *                Return 0
+ *
+ * If CROMFS_NODE_BLKTAB is set in cn_flags of a regular file, the node name
+ * is followed by a table with one uint32_t image offset per data block
+ * (in target byte order, not aligned) and cn_blocks refers to the first
+ * block just after that table.  Every block but the last holds cv_bsize
+ * bytes of uncompressed data, so the block holding any file offset can be
+ * found without walking the preceding blocks.
  */
 
 struct cromfs_node_s
 {
   uint16_t cn_mode;      /* File type, attributes, and access mode bits */
-  uint16_t cn_pad;       /* Not used */
+  uint16_t cn_flags;     /* See CROMFS_NODE_* definitions */
   uint32_t cn_name;      /* Offset from the beginning of the volume header to the
                           * node name string.  NUL-terminated. */
   uint32_t cn_size;      /* Size of the uncompressed data (in bytes) */
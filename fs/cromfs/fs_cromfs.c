@@ -53,6 +53,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/fs/ioctl.h>
@@ -62,6 +63,14 @@
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_CROMFS)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_CROMFS_NCACHE
+#  define CONFIG_FS_CROMFS_NCACHE 2
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -71,9 +80,30 @@
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
-  uint32_t ff_offset;                       /* Cached block offset (zero means none) */
-  uint16_t ff_ulen;                         /* Length of decompressed data in cache */
-  FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+};
+
+/* One entry in the cache of decompressed blocks */
+
+struct cromfs_centry_s
+{
+  uint32_t ce_offset;                       /* Image offset of the compressed
+                                             * data (zero means none) */
+  uint32_t ce_stamp;                        /* Time of last use (for LRU) */
+  uint16_t ce_ulen;                         /* Length of decompressed data */
+};
+
+/* The cache of decompressed blocks is shared by all open files.  There is
+ * only one CROMFS image so there is only one cache.
+ */
+
+struct cromfs_cache_s
+{
+  sem_t cc_sem;                             /* Protects the cache */
+  uint16_t cc_nmounts;                      /* Number of mounts of the image */
+  uint16_t cc_nopen;                        /* Number of open files */
+  uint32_t cc_stamp;                        /* Current LRU time */
+  FAR uint8_t *cc_buffer;                   /* NCACHE blocks of cv_bsize bytes */
+  struct cromfs_centry_s cc_entry[CONFIG_FS_CROMFS_NCACHE];
 };
 
 /* This is the form of the callback from cromfs_foreach_node(): */
@@ -115,6 +145,19 @@ static int      cromfs_comparenode(FAR const struct cromfs_volume_s *fs,
 static int      cromfs_findnode(FAR const struct cromfs_volume_s *fs,
                                 FAR const struct cromfs_node_s **node,
                                 FAR const char *relpath);
+static void     cromfs_semtake(void);
+static FAR const struct lzf_header_s *
+                cromfs_findblock(FAR const struct cromfs_volume_s *fs,
+                                 FAR const struct cromfs_node_s *node,
+                                 uint32_t fpos, FAR uint32_t *blkoffs);
+static uint32_t cromfs_blkinfo(FAR const struct lzf_header_s *hdr,
+                               FAR uint16_t *ulen, FAR uint16_t *clen);
+static FAR struct cromfs_centry_s *
+                cromfs_cachefind(uint32_t voloffs);
+static int      cromfs_cacheread(FAR const struct cromfs_volume_s *fs,
+                                 FAR const uint8_t *src, uint16_t clen,
+                                 FAR uint8_t *dest, unsigned int copyoffs,
+                                 unsigned int copysize, bool direct);
 
 /* Common file system methods */
 
@@ -194,6 +237,15 @@ const struct mountpt_operations cromfs_operations =
 
 extern const struct cromfs_volume_s g_cromfs_image;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct cromfs_cache_s g_cromfs_cache =
+{
+  SEM_INITIALIZER(1)
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -478,6 +530,232 @@ static int cromfs_findnode(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_semtake
+ ****************************************************************************/
+
+static void cromfs_semtake(void)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(&g_cromfs_cache.cc_sem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+#define cromfs_semgive() nxsem_post(&g_cromfs_cache.cc_sem)
+
+/****************************************************************************
+ * Name: cromfs_blkinfo
+ *
+ * Description:
+ *   Return the uncompressed and compressed data lengths of the block at
+ *   'hdr' and the total size of the block, including its header.
+ *
+ ****************************************************************************/
+
+static uint32_t cromfs_blkinfo(FAR const struct lzf_header_s *hdr,
+                               FAR uint16_t *ulen, FAR uint16_t *clen)
+{
+  if (hdr->lzf_type == LZF_TYPE0_HDR)
+    {
+      FAR const struct lzf_type0_header_s *hdr0 =
+        (FAR const struct lzf_type0_header_s *)hdr;
+
+      *ulen = (uint16_t)hdr0->lzf_len[0] << 8 |
+              (uint16_t)hdr0->lzf_len[1];
+      *clen = *ulen;
+      return (uint32_t)*ulen + LZF_TYPE0_HDR_SIZE;
+    }
+  else
+    {
+      FAR const struct lzf_type1_header_s *hdr1 =
+        (FAR const struct lzf_type1_header_s *)hdr;
+
+      *ulen = (uint16_t)hdr1->lzf_ulen[0] << 8 |
+              (uint16_t)hdr1->lzf_ulen[1];
+      *clen = (uint16_t)hdr1->lzf_clen[0] << 8 |
+              (uint16_t)hdr1->lzf_clen[1];
+      return (uint32_t)*clen + LZF_TYPE1_HDR_SIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: cromfs_findblock
+ *
+ * Description:
+ *   Find the block of 'node' that holds the file offset 'fpos'.  The file
+ *   offset of the first byte in the block is returned in 'blkoffs'.  Images
+ *   with a block offset table are indexed directly; older images require a
+ *   walk over the preceding blocks.
+ *
+ ****************************************************************************/
+
+static FAR const struct lzf_header_s *
+cromfs_findblock(FAR const struct cromfs_volume_s *fs,
+                 FAR const struct cromfs_node_s *node, uint32_t fpos,
+                 FAR uint32_t *blkoffs)
+{
+  FAR const struct lzf_header_s *hdr;
+  uint32_t offset;
+  uint16_t ulen;
+  uint16_t clen;
+
+  hdr = (FAR const struct lzf_header_s *)
+        cromfs_offset2addr(fs, node->u.cn_blocks);
+
+  if ((node->cn_flags & CROMFS_NODE_BLKTAB) != 0)
+    {
+      FAR const uint8_t *blktab;
+      uint32_t nblocks;
+      uint32_t blkndx;
+
+      nblocks = (node->cn_size + fs->cv_bsize - 1) / fs->cv_bsize;
+      blkndx  = fpos / fs->cv_bsize;
+      DEBUGASSERT(blkndx < nblocks);
+
+      /* The table is not aligned */
+
+      blktab  = (FAR const uint8_t *)hdr - nblocks * sizeof(uint32_t);
+      memcpy(&offset, &blktab[blkndx * sizeof(uint32_t)], sizeof(uint32_t));
+
+      *blkoffs = blkndx * fs->cv_bsize;
+      return (FAR const struct lzf_header_s *)cromfs_offset2addr(fs, offset);
+    }
+
+  for (offset = 0; ; offset += ulen)
+    {
+      uint32_t blksize = cromfs_blkinfo(hdr, &ulen, &clen);
+
+      if (fpos < offset + ulen)
+        {
+          break;
+        }
+
+      hdr = (FAR const struct lzf_header_s *)
+            ((FAR const uint8_t *)hdr + blksize);
+    }
+
+  *blkoffs = offset;
+  return hdr;
+}
+
+/****************************************************************************
+ * Name: cromfs_cachefind
+ *
+ * Description:
+ *   Return the cache entry holding the decompressed data at image offset
+ *   'voloffs', or NULL if the block is not cached.
+ *
+ * Assumptions:
+ *   The caller holds the cache semaphore.
+ *
+ ****************************************************************************/
+
+static FAR struct cromfs_centry_s *cromfs_cachefind(uint32_t voloffs)
+{
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_FS_CROMFS_NCACHE; ndx++)
+    {
+      if (g_cromfs_cache.cc_entry[ndx].ce_offset == voloffs)
+        {
+          return &g_cromfs_cache.cc_entry[ndx];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: cromfs_cacheread
+ *
+ * Description:
+ *   Copy 'copysize' bytes at 'copyoffs' in the decompressed block whose
+ *   compressed data is at 'src' to 'dest'.  The block is taken from the
+ *   cache if it is there.  Otherwise it is decompressed into the least
+ *   recently used cache entry; or, if 'direct' is true (the copy covers the
+ *   whole block), straight into 'dest' without touching the cache.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EIO if the block could not be decompressed.
+ *
+ ****************************************************************************/
+
+static int cromfs_cacheread(FAR const struct cromfs_volume_s *fs,
+                            FAR const uint8_t *src, uint16_t clen,
+                            FAR uint8_t *dest, unsigned int copyoffs,
+                            unsigned int copysize, bool direct)
+{
+  FAR struct cromfs_centry_s *entry;
+  FAR uint8_t *buffer;
+  unsigned int decomplen;
+  uint32_t voloffs;
+  int ndx;
+
+  voloffs = cromfs_addr2offset(fs, src);
+
+  cromfs_semtake();
+  entry = cromfs_cachefind(voloffs);
+  if (entry == NULL)
+    {
+      if (direct)
+        {
+          /* Decompress into the user buffer without holding the cache */
+
+          cromfs_semgive();
+
+          decomplen = lzf_decompress(src, clen, dest, copysize);
+          return decomplen == copysize ? OK : -EIO;
+        }
+
+      /* Replace the least recently used entry */
+
+      entry = &g_cromfs_cache.cc_entry[0];
+      for (ndx = 1; ndx < CONFIG_FS_CROMFS_NCACHE; ndx++)
+        {
+          if (g_cromfs_cache.cc_entry[ndx].ce_stamp < entry->ce_stamp)
+            {
+              entry = &g_cromfs_cache.cc_entry[ndx];
+            }
+        }
+
+      buffer    = g_cromfs_cache.cc_buffer +
+                  (entry - g_cromfs_cache.cc_entry) * fs->cv_bsize;
+      decomplen = lzf_decompress(src, clen, buffer, fs->cv_bsize);
+      if (decomplen < copyoffs + copysize)
+        {
+          entry->ce_offset = 0;
+          entry->ce_stamp  = 0;
+          cromfs_semgive();
+          return -EIO;
+        }
+
+      entry->ce_offset = voloffs;
+      entry->ce_ulen   = decomplen;
+    }
+
+  DEBUGASSERT(entry->ce_ulen >= copyoffs + copysize);
+
+  entry->ce_stamp = ++g_cromfs_cache.cc_stamp;
+  buffer          = g_cromfs_cache.cc_buffer +
+                    (entry - g_cromfs_cache.cc_entry) * fs->cv_bsize;
+  memcpy(dest, &buffer[copyoffs], copysize);
+
+  cromfs_semgive();
+  return OK;
+}
+
 /****************************************************************************
  * Name: cromfs_open
  ****************************************************************************/
@@ -546,19 +824,14 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
-
-  ff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
-  if (!ff->ff_buffer)
-    {
-      kmm_free(ff);
-      return -ENOMEM;
-    }
-
   /* Save the node in the open file instance */
 
   ff->ff_node = node;
 
+  cromfs_semtake();
+  g_cromfs_cache.cc_nopen++;
+  cromfs_semgive();
+
   /* Save the index as the open-specific state in filep->f_priv */
 
   filep->f_priv = (FAR void *)ff;
@@ -579,13 +852,17 @@ static int cromfs_close(FAR struct file *filep)
   /* Get the open file instance from the file structure */
 
   ff = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Free all resources consumed by the opened file */
 
-  kmm_free(ff->ff_buffer);
   kmm_free(ff);
 
+  cromfs_semtake();
+  DEBUGASSERT(g_cromfs_cache.cc_nopen > 0);
+  g_cromfs_cache.cc_nopen--;
+  cromfs_semgive();
+
   return OK;
 }
 
@@ -599,17 +876,18 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   FAR struct inode *inode;
   FAR const struct cromfs_volume_s *fs;
   FAR struct cromfs_file_s *ff;
-  FAR struct lzf_header_s *currhdr;
-  FAR struct lzf_header_s *nexthdr;
+  FAR const struct lzf_header_s *currhdr;
   FAR uint8_t *dest;
   FAR const uint8_t *src;
   off_t fpos;
   size_t remaining;
   uint32_t blkoffs;
+  uint32_t blksize;
   uint16_t ulen;
   uint16_t clen;
   unsigned int copysize;
   unsigned int copyoffs;
+  int ret;
 
   finfo("Read %d bytes from offset %d\n", buflen, filep->f_pos);
   DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
@@ -625,14 +903,14 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   /* Get the open file instance from the file structure */
 
   ff = (FAR struct cromfs_file_s *)filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Check for a read past the end of the file */
 
-  if (filep->f_pos > ff->ff_node->cn_size)
+  if (filep->f_pos >= ff->ff_node->cn_size)
     {
-      /* Start read position is past the end of file.  Return the end-of-
-       * file indication.
+      /* Start read position is at or past the end of file.  Return the
+       * end-of-file indication.
        */
 
       return 0;
@@ -646,177 +924,81 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = ff->ff_node->cn_size - filep->f_pos;
     }
 
-  /* Find the compressed block containing the current offset, f_pos */
+  /* Find the compressed block containing the current offset, f_pos.  The
+   * remaining blocks are contiguous.
+   */
 
   dest      = (FAR uint8_t *)buffer;
   remaining = buflen;
   fpos      = filep->f_pos;
-  blkoffs   = 0;
-  ulen      = 0;
-  nexthdr   = (FAR struct lzf_header_s *)
-               cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
-
-  /* Look until we find the compressed block containing the start of the
-   * requested data.
-   */
+  currhdr   = cromfs_findblock(fs, ff->ff_node, fpos, &blkoffs);
 
   while (remaining > 0)
     {
-      /* Search for the next block containing the fpos file offset.  This is
-       * real search on the first time through but the remaining blocks should
-       * be contiguous so that the logic should not loop.
-       *
-       */
-
-      do
-        {
-          uint32_t blksize;
-
-          /* Go to the next block */
-
-          currhdr  = nexthdr;
-          blkoffs += ulen;
-
-          if (currhdr->lzf_type == LZF_TYPE0_HDR)
-            {
-              FAR struct lzf_type0_header_s *hdr0 =
-                (FAR struct lzf_type0_header_s *)currhdr;
+      blksize  = cromfs_blkinfo(currhdr, &ulen, &clen);
 
-              ulen    = (uint16_t)hdr0->lzf_len[0] << 8 |
-                        (uint16_t)hdr0->lzf_len[1];
-              blksize = (uint32_t)ulen + LZF_TYPE0_HDR_SIZE;
-            }
-          else
-            {
-              FAR struct lzf_type1_header_s * hdr1 =
-                (FAR struct lzf_type1_header_s *)currhdr;
-
-              ulen    = (uint16_t)hdr1->lzf_ulen[0] << 8 |
-                        (uint16_t)hdr1->lzf_ulen[1];
-              clen    = (uint16_t)hdr1->lzf_clen[0] << 8 |
-                        (uint16_t)hdr1->lzf_clen[1];
-              blksize = (uint32_t)clen + LZF_TYPE1_HDR_SIZE;
-            }
+      copyoffs = fpos - blkoffs;
+      DEBUGASSERT(ulen > copyoffs);
+      copysize = ulen - copyoffs;
 
-          nexthdr  = (FAR struct lzf_header_s *)
-                     ((FAR uint8_t *)currhdr + blksize);
+      if (copysize > remaining)  /* Clip to the size really needed */
+        {
+          copysize = remaining;
         }
-      while (fpos >= (blkoffs + ulen));
-
-      /* Check if we need to decompress the next block into the user buffer. */
 
       if (currhdr->lzf_type == LZF_TYPE0_HDR)
         {
-          /* Just copy the uncompressed data copy data from image to the
-           * user buffer.
+          /* Just copy the uncompressed data from the image to the user
+           * buffer.
            */
 
-          copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
-          DEBUGASSERT(ulen > copyoffs);
-          copysize = ulen - copyoffs;
-
-          if (copysize > remaining)  /* Clip to the size really needed */
-            {
-              copysize = remaining;
-            }
-
           src = (FAR const uint8_t *)currhdr + LZF_TYPE0_HDR_SIZE;
           memcpy(dest, &src[copyoffs], copysize);
-
-          finfo("blkoffs=%lu ulen=%u copysize=%u\n",
-                (unsigned long)blkoffs, ulen, copysize);
         }
       else
         {
-          /* If the source of the data is at the beginning of the compressed
-           * data buffer and if the uncompressed data would not overrun the
-           * buffer, then we can decompress directly into the user buffer.
+          /* Copy from the block cache.  If the read covers the whole block
+           * and the block is not cached, decompress directly into the user
+           * buffer.
            */
 
-          if (filep->f_pos <= blkoffs && ulen <= remaining)
-            {
-              uint32_t voloffs;
-
-              copyoffs = 0;
-              copysize = ulen;
-
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
-               */
-
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
-                }
-
-              finfo("voloffs=%lu blkoffs=%lu ulen=%u ff_offset=%u copysize=%u\n",
-                    (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
-                    ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
-            }
-          else
+          src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+          ret = cromfs_cacheread(fs, src, clen, dest, copyoffs, copysize,
+                                 copysize == ulen);
+          if (ret < 0)
             {
-              uint32_t voloffs;
-
-              /* No, we will need to decompress into the our intermediate
-               * decompression buffer.
-               */
-
-              copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
-              DEBUGASSERT(ulen > copyoffs);
-              copysize = ulen - copyoffs;
-
-              if (copysize > remaining)  /* Clip to the size really needed */
-                {
-                  copysize = remaining;
-                }
+              ferr("ERROR: Failed to decompress block at %lu\n",
+                   (unsigned long)cromfs_addr2offset(fs, src));
 
-              DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
-
-              src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
+              if (remaining == buflen)
                 {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, ff->ff_buffer,
-                                             fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  return ret;
                 }
 
-              finfo("voloffs=%lu blkoffs=%lu ulen=%u clen=%u ff_offset=%u "
-                    "copyoffs=%u copysize=%u\n",
-                    (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
-                    clen, ff->ff_offset, copyoffs, copysize);
-              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
-
-              /* Then copy to user buffer */
-
-              memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
+              break;
             }
         }
 
+      finfo("blkoffs=%lu ulen=%u clen=%u copyoffs=%u copysize=%u\n",
+            (unsigned long)blkoffs, ulen, clen, copyoffs, copysize);
+
       /* Adjust pointers counts and offset */
 
       dest      += copysize;
       remaining -= copysize;
       fpos      += copysize;
+
+      /* Go to the next block */
+
+      blkoffs  += ulen;
+      currhdr   = (FAR const struct lzf_header_s *)
+                  ((FAR const uint8_t *)currhdr + blksize);
     }
 
   /* Update the file pointer */
 
   filep->f_pos = fpos;
-  return buflen;
+  return buflen - remaining;
 }
 
 /****************************************************************************
@@ -842,7 +1024,6 @@ static int cromfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
 {
-  FAR struct cromfs_volume_s *fs;
   FAR struct cromfs_file_s *oldff;
   FAR struct cromfs_file_s *newff;
 
@@ -850,15 +1031,10 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   DEBUGASSERT(oldp->f_priv != NULL && oldp->f_inode != NULL &&
               newp->f_priv == NULL && newp->f_inode != NULL);
 
-  /* Recover our private data from the struct file instance */
-
-  fs = (FAR struct cromfs_volume_s *)oldp->f_inode->i_private;
-  DEBUGASSERT(fs != NULL);
-
   /* Get the open file instance from the file structure */
 
   oldff = oldp->f_priv;
-  DEBUGASSERT(oldff->ff_node != NULL && oldff->ff_buffer != NULL);
+  DEBUGASSERT(oldff->ff_node != NULL);
 
   /* Allocate and initialize an new open file instance referring to the
    * same node.
@@ -870,19 +1046,14 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
-
-  newff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
-  if (newff->ff_buffer == NULL)
-    {
-      kmm_free(newff);
-      return -ENOMEM;
-    }
-
   /* Save the node in the open file instance */
 
   newff->ff_node = oldff->ff_node;
 
+  cromfs_semtake();
+  g_cromfs_cache.cc_nopen++;
+  cromfs_semgive();
+
   /* Copy the index from the old to the new file structure */
 
   newp->f_priv = newff;
@@ -908,14 +1079,14 @@ static int cromfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 
   /* Sanity checks */
 
-  DEBUGASSERT(filep->f_priv == NULL && filep->f_inode != NULL);
+  DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
 
   /* Get the mountpoint inode reference from the file structure and the
    * volume private data from the inode structure
    */
 
   ff              = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   inode           = filep->f_inode;
   fs              = inode->i_private;
@@ -1102,6 +1273,26 @@ static int cromfs_bind(FAR struct inode *blkdriver, const void *data,
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
   DEBUGASSERT(g_cromfs_image.cv_magic == CROMFS_MAGIC);
 
+  /* Allocate the shared cache of decompressed blocks on the first mount */
+
+  cromfs_semtake();
+  if (g_cromfs_cache.cc_nmounts == 0)
+    {
+      g_cromfs_cache.cc_buffer = (FAR uint8_t *)
+        kmm_malloc(CONFIG_FS_CROMFS_NCACHE * g_cromfs_image.cv_bsize);
+      if (g_cromfs_cache.cc_buffer == NULL)
+        {
+          cromfs_semgive();
+          return -ENOMEM;
+        }
+
+      memset(g_cromfs_cache.cc_entry, 0, sizeof(g_cromfs_cache.cc_entry));
+      g_cromfs_cache.cc_stamp = 0;
+    }
+
+  g_cromfs_cache.cc_nmounts++;
+  cromfs_semgive();
+
   /* Return the new file system handle */
 
   *handle = (FAR void *)&g_cromfs_image;
@@ -1121,6 +1312,26 @@ static int cromfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 {
   finfo("handle: %p blkdriver: %p flags: %02x\n",
         handle, blkdriver, flags);
+
+  /* The open files of all mounts share the block cache.  Keep it until the
+   * image is no longer mounted anywhere.
+   */
+
+  cromfs_semtake();
+  if (g_cromfs_cache.cc_nopen > 0 && g_cromfs_cache.cc_nmounts == 1)
+    {
+      cromfs_semgive();
+      return -EBUSY;
+    }
+
+  DEBUGASSERT(g_cromfs_cache.cc_nmounts > 0);
+  if (--g_cromfs_cache.cc_nmounts == 0)
+    {
+      kmm_free(g_cromfs_cache.cc_buffer);
+      g_cromfs_cache.cc_buffer = NULL;
+    }
+
+  cromfs_semgive();
   return OK;
 }
 
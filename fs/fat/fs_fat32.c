@@ -2162,6 +2162,20 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+#ifdef CONFIG_FAT_BLKCACHE
+  /* Write back and release the sector cache.  If the media has been lost
+   * or changed, the dirty sectors belong to the old media and must not be
+   * written to the new one.
+   */
+
+  if (!fs->fs_mounted)
+    {
+      blkcache_discard(&fs->fs_cache);
+    }
+
+  (void)blkcache_uninitialize(&fs->fs_cache);
+#endif
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -51,6 +51,10 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/dirent.h>
 
+#ifdef CONFIG_FAT_BLKCACHE
+#  include <nuttx/drivers/blkcache.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -758,6 +762,9 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one sector
                                     * from the device */
+#ifdef CONFIG_FAT_BLKCACHE
+  struct blkcache_s fs_cache;      /* Cache of recently used sectors */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -547,6 +547,26 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+#ifdef CONFIG_FAT_BLKCACHE
+  /* Set up the cache of recently used sectors.  All sector I/O goes through
+   * it from here on.
+   */
+
+  fs->fs_cache.inode      = inode;
+  fs->fs_cache.sectsize   = fs->fs_hwsectorsize;
+  fs->fs_cache.nsectors   = fs->fs_hwnsectors;
+  fs->fs_cache.nentries   = CONFIG_FAT_BLKCACHE_NSECTORS;
+  fs->fs_cache.nreadahead = CONFIG_FAT_BLKCACHE_READAHEAD;
+
+  ret = blkcache_initialize(&fs->fs_cache);
+  if (ret < 0)
+    {
+      fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
+      fs->fs_buffer = 0;
+      goto errout;
+    }
+#endif
+
   /* Search FAT boot record on the drive.  First check at sector zero.  This
    * could be either the boot record or a partition that refers to the boot
    * record.
@@ -670,6 +690,9 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#ifdef CONFIG_FAT_BLKCACHE
+  (void)blkcache_uninitialize(&fs->fs_cache);
+#endif
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = 0;
 
@@ -739,8 +762,13 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
       struct inode *inode = fs->fs_blkdriver;
       if (inode && inode->u.i_bops && inode->u.i_bops->read)
         {
+#ifdef CONFIG_FAT_BLKCACHE
+          ssize_t nSectorsRead = blkcache_read(&fs->fs_cache, buffer,
+                                               sector, nsectors);
+#else
           ssize_t nSectorsRead = inode->u.i_bops->read(inode, buffer,
                                                        sector, nsectors);
+#endif
           if (nSectorsRead == nsectors)
             {
               ret = OK;
@@ -772,8 +800,13 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
       struct inode *inode = fs->fs_blkdriver;
       if (inode && inode->u.i_bops && inode->u.i_bops->write)
         {
+#ifdef CONFIG_FAT_BLKCACHE
+          ssize_t nSectorsWritten =
+              blkcache_write(&fs->fs_cache, buffer, sector, nsectors);
+#else
           ssize_t nSectorsWritten =
               inode->u.i_bops->write(inode, buffer, sector, nsectors);
+#endif
 
           if (nSectorsWritten == nsectors)
             {
@@ -2014,6 +2047,15 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
         }
     }
 
+#ifdef CONFIG_FAT_BLKCACHE
+  /* Write back every modified sector held in the sector cache */
+
+  if (ret == OK)
+    {
+      ret = blkcache_flush(&fs->fs_cache);
+    }
+#endif
+
   return ret;
 }
 
@@ -41,6 +41,7 @@
 
 #include "inode/inode.h"
 #include "aio/aio.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Public Functions
@@ -67,4 +68,10 @@ void fs_initialize(void)
   aio_initialize();
 
 #endif
+
+#ifdef CONFIG_FS_PAGECACHE
+  /* Initialize the page cache */
+
+  pgcache_initialize();
+#endif
 }
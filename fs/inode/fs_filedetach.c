@@ -47,6 +47,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Private Functions
@@ -151,6 +152,10 @@ int file_detach(int fd, FAR struct file *filep)
   filep->f_pos     = parent->f_pos;
   filep->f_inode   = parent->f_inode;
   filep->f_priv    = parent->f_priv;
+#ifdef CONFIG_FS_PAGECACHE
+  filep->f_pgfile  = parent->f_pgfile;
+  filep->f_drvpos  = parent->f_drvpos;
+#endif
 
   /* Release the file descriptore *without* calling the drive close method
    * and without decrementing the inode reference count.  That will be done
@@ -161,6 +166,9 @@ int file_detach(int fd, FAR struct file *filep)
   parent->f_pos    = 0;
   parent->f_inode  = NULL;
   parent->f_priv   = NULL;
+#ifdef CONFIG_FS_PAGECACHE
+  parent->f_pgfile = NULL;
+#endif
 
   _files_semgive(list);
   return OK;
@@ -197,6 +205,12 @@ int file_close_detached(FAR struct file *filep)
 
   if (inode)
     {
+#ifdef CONFIG_FS_PAGECACHE
+      /* Release the page cache identity of the file */
+
+      pgcache_close(filep);
+#endif
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
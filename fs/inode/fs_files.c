@@ -51,6 +51,7 @@
 #include <nuttx/kmalloc.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Private Functions
@@ -105,6 +106,12 @@ static int _files_close(FAR struct file *filep)
 
   if (inode)
     {
+#ifdef CONFIG_FS_PAGECACHE
+      /* Release the page cache identity of the file */
+
+      pgcache_close(filep);
+#endif
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
@@ -243,6 +250,19 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
       goto errout_with_sem;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* The driver state that is duplicated must match the file position */
+
+  if (filep1->f_pgfile != NULL)
+    {
+      ret = pgcache_sync(filep1);
+      if (ret < 0)
+        {
+          goto errout_with_sem;
+        }
+    }
+#endif
+
   /* Increment the reference count on the contained inode */
 
   inode = filep1->f_inode;
@@ -283,6 +303,12 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
         }
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Share the page cache identity with the duplicate */
+
+  pgcache_dup(filep1, filep2);
+#endif
+
   if (list != NULL)
     {
       _files_semgive(list);
@@ -335,6 +361,10 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
            list->fl_files[i].f_pos    = pos;
            list->fl_files[i].f_inode  = inode;
            list->fl_files[i].f_priv   = NULL;
+#ifdef CONFIG_FS_PAGECACHE
+           list->fl_files[i].f_pgfile = NULL;
+           list->fl_files[i].f_drvpos = pos;
+#endif
            _files_semgive(list);
            return i;
         }
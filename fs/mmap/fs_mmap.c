@@ -74,7 +74,9 @@
  *
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
- *      into RAM.
+ *      into RAM.  If the mapping is MAP_SHARED with PROT_WRITE and the
+ *      file is open for writing, then msync() and munmap() write changes
+ *      back to the file.
  *
  * Input Parameters:
  *   start   A hint at where to map the memory -- ignored.  The address
@@ -161,7 +163,7 @@ FAR void *mmap(FAR void *start, size_t length, int prot, int flags,
   if (ret < 0)
     {
 #ifdef CONFIG_FS_RAMMAP
-      return rammap(fd, length, offset);
+      return rammap(fd, length, offset, prot, flags);
 #else
       ferr("ERROR: ioctl(FIOC_MMAP) failed: %d\n", get_errno());
       return MAP_FAILED;
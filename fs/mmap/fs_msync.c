@@ -0,0 +1,161 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+
+#include "fs_rammap.h"
+
+#ifdef CONFIG_FS_RAMMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   Write changes in a memory mapped region back to the file.
+ *
+ *   Only mappings that are simulated by copying the file into RAM (see
+ *   CONFIG_FS_RAMMAP) need this.  Only MAP_SHARED mappings created with
+ *   PROT_WRITE on a file that is open for writing are written back.  There
+ *   is no MMU to track dirty pages, so the whole range is written.  Other
+ *   mappings are silently ignored.
+ *
+ *   The write is always synchronous; MS_ASYNC is treated like MS_SYNC.
+ *   MS_INVALIDATE has no effect since there is only one copy of each
+ *   mapped region.
+ *
+ * Input Parameters:
+ *   addr    The start of the range to synchronize.  This must lie within a
+ *           mapped region.
+ *   len     The length of the range.  The range is clipped to the end of
+ *           the mapped region.
+ *   flags   See the MS_* definitions in sys/mman.h
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set:
+ *
+ *     EINVAL
+ *       Both MS_SYNC and MS_ASYNC were specified.
+ *     ENOMEM
+ *       'addr' is not within a mapped region.
+ *     EIO
+ *       (or other errors) Writing to the file failed.
+ *
+ ****************************************************************************/
+
+int msync(FAR void *addr, size_t len, int flags)
+{
+  FAR struct fs_rammap_s *curr;
+  size_t offset;
+  int errcode;
+  int ret;
+
+  /* msync() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  if ((flags & (MS_SYNC | MS_ASYNC)) == (MS_SYNC | MS_ASYNC))
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  rammap_initialize();
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout;
+    }
+
+  /* Find the region containing the start address */
+
+  for (curr = g_rammaps.head; curr; curr = curr->flink)
+    {
+      if ((uintptr_t)addr >= (uintptr_t)curr->addr &&
+          (uintptr_t)addr < (uintptr_t)curr->addr + curr->length)
+        {
+          break;
+        }
+    }
+
+  if (!curr)
+    {
+      ferr("ERROR: Region not found\n");
+      errcode = ENOMEM;
+      goto errout_with_semaphore;
+    }
+
+  offset = (uintptr_t)addr - (uintptr_t)curr->addr;
+  ret    = rammap_writeback(curr, offset, len);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_semaphore;
+    }
+
+  nxsem_post(&g_rammaps.exclsem);
+  leave_cancellation_point();
+  return OK;
+
+errout_with_semaphore:
+  nxsem_post(&g_rammaps.exclsem);
+
+errout:
+  leave_cancellation_point();
+  set_errno(errcode);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_RAMMAP */
@@ -93,7 +93,8 @@
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
  *      into RAM.  munmap() is required in this case to free the allocated
- *      memory holding the shared copy of the file.
+ *      memory holding the shared copy of the file.  The unmapped range of
+ *      a shared, writable mapping is first written back to the file.
  *
  * Input Parameters:
  *   start   The start address of the mapping to delete.  For this
@@ -123,7 +124,7 @@ int munmap(FAR void *start, size_t length)
   ret = nxsem_wait(&g_rammaps.exclsem);
   if (ret < 0)
     {
-      errcode = ret;
+      errcode = -ret;
       goto errout;
     }
 
@@ -170,6 +171,15 @@ int munmap(FAR void *start, size_t length)
 
   length = curr->length - offset;
 
+  /* Write any changes in the unmapped range back to the file */
+
+  ret = rammap_writeback(curr, offset, length);
+  if (ret < 0)
+    {
+      errcode = -ret;
+      goto errout_with_semaphore;
+    }
+
   /* Are we unmapping the entire region (offset == 0)? */
 
   if (length >= curr->length)
@@ -185,7 +195,12 @@ int munmap(FAR void *start, size_t length)
           g_rammaps.head = curr->flink;
         }
 
-      /* Then free the region */
+      /* Then release the file and free the region */
+
+      if (curr->file.f_inode != NULL)
+        {
+          file_close_detached(&curr->file);
+        }
 
       kumm_free(curr);
     }
@@ -196,9 +211,17 @@ int munmap(FAR void *start, size_t length)
 
   else
     {
-      newaddr = kumm_realloc(curr->addr, sizeof(struct fs_rammap_s) + length);
-      DEBUGASSERT(newaddr == (FAR void *)(curr->addr));
-      curr->length = length;
+      /* The region is allocated together with its container */
+
+      newaddr = kumm_realloc(curr, sizeof(struct fs_rammap_s) + offset);
+      DEBUGASSERT(newaddr == (FAR void *)curr);
+      UNUSED(newaddr);
+
+      curr->length = offset;
+      if (curr->filelen > offset)
+        {
+          curr->filelen = offset;
+        }
     }
 
   nxsem_post(&g_rammaps.exclsem);
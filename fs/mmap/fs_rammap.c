@@ -43,7 +43,7 @@
 #include <sys/mman.h>
 
 #include <string.h>
-#include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -101,6 +101,8 @@ void rammap_initialize(void)
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h
+ *   flags   See the MAP_* definitions in sys/mman.h
  *
  * Returned Value:
  *   On success, rammmap() returns a pointer to the mapped area. On error, the
@@ -115,9 +117,10 @@ void rammap_initialize(void)
  *
  ****************************************************************************/
 
-FAR void *rammap(int fd, size_t length, off_t offset)
+FAR void *rammap(int fd, size_t length, off_t offset, int prot, int flags)
 {
   FAR struct fs_rammap_s *map;
+  FAR struct file *filep;
   FAR uint8_t *alloc;
   FAR uint8_t *rdbuffer;
   ssize_t nread;
@@ -138,6 +141,14 @@ FAR void *rammap(int fd, size_t length, off_t offset)
    * Not very useful!
    */
 
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      ferr("ERROR: Invalid file descriptor: %d\n", fd);
+      errcode = -ret;
+      goto errout;
+    }
+
   /* Allocate a region of memory of the specified size */
 
   alloc = (FAR uint8_t *)kumm_malloc(sizeof(struct fs_rammap_s) + length);
@@ -156,26 +167,16 @@ FAR void *rammap(int fd, size_t length, off_t offset)
   map->length = length;
   map->offset = offset;
 
-  /* Seek to the specified file offset */
-
-  fpos = lseek(fd, offset,  SEEK_SET);
-  if (fpos == (off_t)-1)
-    {
-      /* Seek failed... errno has already been set, but EINVAL is probably
-       * the correct response.
-       */
-
-      ferr("ERROR: Seek to position %d failed\n", (int)offset);
-      errcode = EINVAL;
-      goto errout_with_region;
-    }
-
-  /* Read the file data into the memory region */
+  /* Read the file data into the memory region.  file_pread() is used so
+   * that the file position of the caller's descriptor is not disturbed.
+   */
 
   rdbuffer = map->addr;
+  fpos     = offset;
+
   while (length > 0)
     {
-      nread = nx_read(fd, rdbuffer, length);
+      nread = file_pread(filep, rdbuffer, length, fpos);
       if (nread < 0)
         {
           /* Handle the special case where the read was interrupted by a
@@ -187,11 +188,13 @@ FAR void *rammap(int fd, size_t length, off_t offset)
               /* All other read errors are bad. */
 
               ferr("ERROR: Read failed: offset=%d errno=%d\n",
-                   (int)offset, (int)nread);
+                   (int)fpos, (int)nread);
 
               errcode = (int)-nread;
               goto errout_with_region;
             }
+
+          continue;
         }
 
       /* Check for end of file. */
@@ -204,12 +207,31 @@ FAR void *rammap(int fd, size_t length, off_t offset)
       /* Increment number of bytes read */
 
       rdbuffer += nread;
+      fpos     += nread;
       length   -= nread;
     }
 
   /* Zero any memory beyond the amount read from the file */
 
   memset(rdbuffer, 0, length);
+  map->filelen = rdbuffer - (FAR uint8_t *)map->addr;
+
+  /* Changes to a shared, writable mapping are written back to the file by
+   * msync() and munmap().  Keep a private reference to the open file for
+   * that purpose; the region persists after the caller closes the file.
+   */
+
+  if ((flags & MAP_SHARED) != 0 && (prot & PROT_WRITE) != 0 &&
+      (filep->f_oflags & O_WROK) != 0)
+    {
+      ret = file_dup2(filep, &map->file);
+      if (ret < 0)
+        {
+          ferr("ERROR: file_dup2 failed: %d\n", ret);
+          errcode = -ret;
+          goto errout_with_region;
+        }
+    }
 
   /* Add the buffer to the list of regions */
 
@@ -218,7 +240,7 @@ FAR void *rammap(int fd, size_t length, off_t offset)
   if (ret < 0)
     {
       errcode = -ret;
-      goto errout_with_region;
+      goto errout_with_file;
     }
 
   map->flink  = g_rammaps.head;
@@ -227,6 +249,12 @@ FAR void *rammap(int fd, size_t length, off_t offset)
   nxsem_post(&g_rammaps.exclsem);
   return map->addr;
 
+errout_with_file:
+  if (map->file.f_inode != NULL)
+    {
+      file_close_detached(&map->file);
+    }
+
 errout_with_region:
   kumm_free(alloc);
 
@@ -235,4 +263,75 @@ errout:
   return MAP_FAILED;
 }
 
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write part of a mapped region back to the file.  Nothing is written if
+ *   the mapping is not a writable, shared mapping.  Bytes of the region
+ *   that lie beyond the end of the file when it was mapped are not
+ *   written.
+ *
+ * Input Parameters:
+ *   map     The mapped region
+ *   start   Offset into the region of the first byte to write
+ *   length  Number of bytes to write
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+int rammap_writeback(FAR struct fs_rammap_s *map, size_t start,
+                     size_t length)
+{
+  FAR const uint8_t *wrbuffer;
+  ssize_t nwritten;
+
+  if (map->file.f_inode == NULL || start >= map->filelen)
+    {
+      return OK;
+    }
+
+  if (length > map->filelen - start)
+    {
+      length = map->filelen - start;
+    }
+
+  wrbuffer = (FAR const uint8_t *)map->addr + start;
+  while (length > 0)
+    {
+      nwritten = file_pwrite(&map->file, wrbuffer, length,
+                             map->offset + (off_t)start);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write-back failed: offset=%d errno=%d\n",
+               (int)(map->offset + start), (int)nwritten);
+          return (int)nwritten;
+        }
+      else if (nwritten == 0)
+        {
+          /* No progress (e.g., the media is full).  Don't spin forever */
+
+          ferr("ERROR: Write-back wrote nothing: offset=%d\n",
+               (int)(map->offset + start));
+          return -EIO;
+        }
+
+      wrbuffer += nwritten;
+      start    += nwritten;
+      length   -= nwritten;
+    }
+
+  return OK;
+}
+
 #endif /* CONFIG_FS_RAMMAP */
@@ -45,8 +45,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <semaphore.h>
 
+#include <nuttx/fs/fs.h>
+
 #ifdef CONFIG_FS_RAMMAP
 
 /****************************************************************************
@@ -65,8 +68,10 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Changes to the in-memory image reach the file only for MAP_SHARED
+ *   mappings created with PROT_WRITE on a file opened for writing.  They
+ *   are written back by msync() and munmap(); there is no dirty tracking,
+ *   so the whole range is written.
  * - There are not access privileges.
  */
 
@@ -75,7 +80,10 @@ struct fs_rammap_s
   struct fs_rammap_s *flink;       /* Implements a singly linked list */
   FAR void           *addr;        /* Start of allocated memory */
   size_t              length;      /* Length of region */
+  size_t              filelen;     /* Length of region backed by the file */
   off_t               offset;      /* File offset */
+  struct file         file;        /* File for write-back (f_inode == NULL
+                                    * if the mapping is not written back) */
 };
 
 /* This structure defines all "mapped" files */
@@ -126,6 +134,8 @@ void rammap_initialize(void);
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h
+ *   flags   See the MAP_* definitions in sys/mman.h
  *
  * Returned Value:
  *   On success, rammmap() returns a pointer to the mapped area. On error, the
@@ -140,7 +150,32 @@ void rammap_initialize(void);
  *
  ****************************************************************************/
 
-FAR void *rammap(int fd, size_t length, off_t offset);
+FAR void *rammap(int fd, size_t length, off_t offset, int prot, int flags);
+
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write part of a mapped region back to the file.  Nothing is written if
+ *   the mapping is not a writable, shared mapping.  Bytes of the region
+ *   that lie beyond the end of the file when it was mapped are not
+ *   written.
+ *
+ * Input Parameters:
+ *   map     The mapped region
+ *   start   Offset into the region of the first byte to write
+ *   length  Number of bytes to write
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+int rammap_writeback(FAR struct fs_rammap_s *map, size_t start,
+                     size_t length);
 
 #endif /* CONFIG_FS_RAMMAP */
 #endif /* __FS_MMAP_RAMMAP_H */
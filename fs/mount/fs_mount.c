@@ -50,6 +50,7 @@
 
 #include "inode/inode.h"
 #include "driver/driver.h"
+#include "pgcache/pgcache.h"
 
 /* At least one filesystem must be defined, or this file will not compile.
  * It may be desire-able to make filesystems dynamically registered at
@@ -409,6 +410,16 @@ int mount(FAR const char *source, FAR const char *target,
   mountpt_inode->i_mode    = mode;
 #endif
   mountpt_inode->i_private = fshandle;
+
+#ifdef CONFIG_FS_PAGECACHE
+  /* Mark the mountpoint if files of this type may be page cached */
+
+  if (pgcache_mountable(filesystemtype))
+    {
+      mountpt_inode->i_flags |= FSNODEFLAG_PGCACHE;
+    }
+#endif
+
   inode_semgive();
 
   /* We can release our reference to the blkdrver_inode, if the filesystem
@@ -47,6 +47,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Public Functions
@@ -143,12 +144,21 @@ int umount2(FAR const char *target, unsigned int flags)
       goto errout_with_semaphore;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Drop cached file data before the mountpoint inode can be reused */
+
+  if ((mountpt_inode->i_flags & FSNODEFLAG_PGCACHE) != 0)
+    {
+      pgcache_purge(mountpt_inode);
+    }
+#endif
+
   /* Successfully unbound.  Convert the mountpoint inode to regular
    * pseudo-file inode.
    */
 
 
-  mountpt_inode->i_flags  &= ~FSNODEFLAG_TYPE_MASK;
+  mountpt_inode->i_flags  &= ~(FSNODEFLAG_TYPE_MASK | FSNODEFLAG_PGCACHE);
   mountpt_inode->i_private = NULL;
   mountpt_inode->u.i_mops  = NULL;
 
@@ -53,6 +53,10 @@
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/fs/nxffs.h>
 
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+#  include <nuttx/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -284,6 +288,18 @@ struct nxffs_wrfile_s
   uint32_t                  crc;        /* Accumulated data block CRC */
 };
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+/* One entry in the in-memory inode index.  The index is sorted by FLASH
+ * offset and maps the hash of each valid inode name to its header offset.
+ */
+
+struct nxffs_index_s
+{
+  off_t                     hoffset;   /* FLASH offset to the inode header */
+  uint32_t                  hash;      /* Hash of the inode name */
+};
+#endif
+
 /* This structure represents the overall state of on NXFFS instance. */
 
 struct nxffs_volume_s
@@ -302,6 +318,17 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  bool                      ixvalid;   /* True: The inode index is usable */
+  unsigned int              nindex;    /* Number of entries in the inode index */
+  unsigned int              maxindex;  /* Allocated size of the inode index */
+  FAR struct nxffs_index_s *index;     /* In-memory inode index */
+#endif
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+  bool                      gcdirty;   /* True: Inodes deleted since the last pack */
+  bool                      packstop;  /* True: Background packing stopped */
+  struct work_s             packwork;  /* Supports background packing */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -1082,6 +1109,111 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name);
 
 int nxffs_pack(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_packpass
+ *
+ * Description:
+ *   Perform one bounded packing pass.  The pass re-writes about 'maxblocks'
+ *   erase blocks and then stops at the next point where the FLASH is
+ *   consistent.
+ *
+ * Input Parameters:
+ *   volume    - The volume to be packed.
+ *   maxblocks - The number of erase blocks to re-write in this pass.
+ *   complete  - Returns true if the whole volume has been packed.
+ *
+ * Returned Value:
+ *   Zero on success; Otherwise, a negated errno value is returned to
+ *   indicate the nature of the failure.
+ *
+ * Defined in nxffs_pack.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+int nxffs_packpass(FAR struct nxffs_volume_s *volume, unsigned int maxblocks,
+                   FAR bool *complete);
+#endif
+
+/****************************************************************************
+ * Name: nxffs_packschedule
+ *
+ * Description:
+ *   Schedule background packing on the low priority work queue if inodes
+ *   have been deleted and the free FLASH has dropped below the low
+ *   watermark.  Background packing then continues in bounded passes until
+ *   the free FLASH reaches the high watermark or there is nothing more to
+ *   reclaim.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_packwork.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+void nxffs_packschedule(FAR struct nxffs_volume_s *volume);
+#endif
+
+/****************************************************************************
+ * Name: nxffs_packstop
+ *
+ * Description:
+ *   Stop background packing before the volume is unbound.  A pass that is
+ *   in progress is allowed to finish and no further pass is scheduled.
+ *
+ * Input Parameters:
+ *   volume - The volume being unbound.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller does not hold the NXFFS semaphore.
+ *
+ * Defined in nxffs_packwork.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+void nxffs_packstop(FAR struct nxffs_volume_s *volume);
+#endif
+
+/****************************************************************************
+ * Name: nxffs_index_*
+ *
+ * Description:
+ *   Maintain the in-memory inode index.  The index is built while the
+ *   volume is scanned by nxffs_limits() and then kept up to date as inodes
+ *   are created, removed, and moved by the packing logic.  If the index
+ *   cannot be allocated, it is disabled and nxffs_index_find() and
+ *   nxffs_index_next() return -ENOSYS; callers then fall back to scanning
+ *   the FLASH.
+ *
+ * Assumptions:
+ *   The caller holds the NXFFS semaphore.
+ *
+ * Defined in nxffs_index.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_INODE_INDEX
+void nxffs_index_reset(FAR struct nxffs_volume_s *volume);
+void nxffs_index_release(FAR struct nxffs_volume_s *volume);
+void nxffs_index_add(FAR struct nxffs_volume_s *volume,
+                     FAR const struct nxffs_entry_s *entry);
+void nxffs_index_remove(FAR struct nxffs_volume_s *volume, off_t hoffset);
+void nxffs_index_build(FAR struct nxffs_volume_s *volume);
+int nxffs_index_find(FAR struct nxffs_volume_s *volume, FAR const char *name,
+                     FAR struct nxffs_entry_s *entry);
+int nxffs_index_next(FAR struct nxffs_volume_s *volume, off_t offset,
+                     FAR off_t *hoffset);
+#endif
+
 /****************************************************************************
  * Standard mountpoint operation methods
  *
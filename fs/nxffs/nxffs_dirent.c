@@ -137,6 +137,17 @@ int nxffs_readdir(FAR struct inode *mountpt, FAR struct fs_dirent_s *dir)
   /* Read the next inode header from the offset */
 
   offset = dir->u.nxffs.nx_offset;
+
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  /* Use the inode index to skip directly to the next inode header */
+
+  ret = nxffs_index_next(volume, offset, &offset);
+  if (ret == -ENOENT)
+    {
+      goto errout_with_semaphore;
+    }
+#endif
+
   ret = nxffs_nextentry(volume, offset, &entry);
 
   /* If the read was successful, then handle the reported inode.  Note
@@ -159,6 +170,9 @@ int nxffs_readdir(FAR struct inode *mountpt, FAR struct fs_dirent_s *dir)
       ret = OK;
     }
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+errout_with_semaphore:
+#endif
   nxsem_post(&volume->exclsem);
 
 errout:
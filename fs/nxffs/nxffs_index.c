@@ -0,0 +1,355 @@
+/****************************************************************************
+ * fs/nxffs/nxffs_index.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <crc32.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "nxffs.h"
+
+#ifdef CONFIG_NXFFS_INODE_INDEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The index array is grown by this number of entries at a time */
+
+#define NXFFS_INDEX_INCR 16
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_index_hash
+ *
+ * Description:
+ *   Return the hash of an inode name.
+ *
+ ****************************************************************************/
+
+static inline uint32_t nxffs_index_hash(FAR const char *name)
+{
+  return crc32((FAR const uint8_t *)name, strlen(name));
+}
+
+/****************************************************************************
+ * Name: nxffs_index_search
+ *
+ * Description:
+ *   Return the position of the first index entry whose inode header offset
+ *   is greater than or equal to 'hoffset'.  The index is kept sorted by
+ *   FLASH offset, so this is a simple binary search.
+ *
+ ****************************************************************************/
+
+static unsigned int nxffs_index_search(FAR struct nxffs_volume_s *volume,
+                                       off_t hoffset)
+{
+  unsigned int low  = 0;
+  unsigned int high = volume->nindex;
+  unsigned int mid;
+
+  while (low < high)
+    {
+      mid = (low + high) >> 1;
+      if (volume->index[mid].hoffset < hoffset)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+
+  return low;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_index_reset
+ *
+ * Description:
+ *   Discard all index entries and mark the (now empty) index as valid.
+ *   This is called before the volume is scanned.
+ *
+ ****************************************************************************/
+
+void nxffs_index_reset(FAR struct nxffs_volume_s *volume)
+{
+  volume->nindex  = 0;
+  volume->ixvalid = true;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_release
+ *
+ * Description:
+ *   Free the index memory.  Lookups will fall back to scanning FLASH until
+ *   the index is rebuilt.
+ *
+ ****************************************************************************/
+
+void nxffs_index_release(FAR struct nxffs_volume_s *volume)
+{
+  if (volume->index != NULL)
+    {
+      kmm_free(volume->index);
+    }
+
+  volume->index    = NULL;
+  volume->nindex   = 0;
+  volume->maxindex = 0;
+  volume->ixvalid  = false;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_add
+ *
+ * Description:
+ *   Add a valid inode to the index (or update the hash of an existing index
+ *   entry at the same FLASH offset).
+ *
+ ****************************************************************************/
+
+void nxffs_index_add(FAR struct nxffs_volume_s *volume,
+                     FAR const struct nxffs_entry_s *entry)
+{
+  FAR struct nxffs_index_s *index;
+  unsigned int pos;
+
+  if (!volume->ixvalid)
+    {
+      return;
+    }
+
+  pos = nxffs_index_search(volume, entry->hoffset);
+  if (pos < volume->nindex && volume->index[pos].hoffset == entry->hoffset)
+    {
+      volume->index[pos].hash = nxffs_index_hash(entry->name);
+      return;
+    }
+
+  /* Grow the index if it is full */
+
+  if (volume->nindex >= volume->maxindex)
+    {
+      index = (FAR struct nxffs_index_s *)
+        kmm_realloc(volume->index, (volume->maxindex + NXFFS_INDEX_INCR) *
+                                   sizeof(struct nxffs_index_s));
+      if (index == NULL)
+        {
+          /* Give up on the index rather than fail the file system
+           * operation.  Lookups will scan FLASH as before.
+           */
+
+          fwarn("WARNING: Failed to grow the inode index\n");
+          nxffs_index_release(volume);
+          return;
+        }
+
+      volume->index     = index;
+      volume->maxindex += NXFFS_INDEX_INCR;
+    }
+
+  /* New inodes are normally appended at the end of FLASH, so this memmove
+   * is usually a no-op.
+   */
+
+  memmove(&volume->index[pos + 1], &volume->index[pos],
+          (volume->nindex - pos) * sizeof(struct nxffs_index_s));
+
+  volume->index[pos].hoffset = entry->hoffset;
+  volume->index[pos].hash    = nxffs_index_hash(entry->name);
+  volume->nindex++;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_remove
+ *
+ * Description:
+ *   Remove the inode at FLASH offset 'hoffset' from the index.
+ *
+ ****************************************************************************/
+
+void nxffs_index_remove(FAR struct nxffs_volume_s *volume, off_t hoffset)
+{
+  unsigned int pos;
+
+  if (!volume->ixvalid)
+    {
+      return;
+    }
+
+  pos = nxffs_index_search(volume, hoffset);
+  if (pos < volume->nindex && volume->index[pos].hoffset == hoffset)
+    {
+      volume->nindex--;
+      memmove(&volume->index[pos], &volume->index[pos + 1],
+              (volume->nindex - pos) * sizeof(struct nxffs_index_s));
+    }
+}
+
+/****************************************************************************
+ * Name: nxffs_index_build
+ *
+ * Description:
+ *   Rebuild the index by scanning all valid inodes on the FLASH.  This is
+ *   only needed to recover after an operation that left the index in an
+ *   unknown state (such as a failed packing operation).
+ *
+ ****************************************************************************/
+
+void nxffs_index_build(FAR struct nxffs_volume_s *volume)
+{
+  struct nxffs_entry_s entry;
+  off_t offset;
+  off_t block;
+
+  nxffs_index_reset(volume);
+
+  block = 0;
+  if (nxffs_validblock(volume, &block) < 0)
+    {
+      return;
+    }
+
+  offset = block * volume->geo.blocksize;
+  while (nxffs_nextentry(volume, offset, &entry) == OK)
+    {
+      nxffs_index_add(volume, &entry);
+      offset = nxffs_inodeend(volume, &entry);
+      nxffs_freeentry(&entry);
+    }
+}
+
+/****************************************************************************
+ * Name: nxffs_index_find
+ *
+ * Description:
+ *   Use the index to find the inode with the provided name.  Only inode
+ *   headers with a matching name hash are read from FLASH.
+ *
+ * Returned Value:
+ *   Zero is returned on success.  -ENOENT is returned if there is no inode
+ *   with this name.  -ENOSYS is returned if the index is not available; the
+ *   caller must then scan the FLASH.
+ *
+ ****************************************************************************/
+
+int nxffs_index_find(FAR struct nxffs_volume_s *volume, FAR const char *name,
+                     FAR struct nxffs_entry_s *entry)
+{
+  uint32_t hash;
+  unsigned int i;
+
+  if (!volume->ixvalid)
+    {
+      return -ENOSYS;
+    }
+
+  hash = nxffs_index_hash(name);
+  for (i = 0; i < volume->nindex; i++)
+    {
+      if (volume->index[i].hash != hash)
+        {
+          continue;
+        }
+
+      if (nxffs_nextentry(volume, volume->index[i].hoffset, entry) == OK)
+        {
+          if (entry->hoffset == volume->index[i].hoffset &&
+              strcmp(name, entry->name) == 0)
+            {
+              return OK;
+            }
+
+          nxffs_freeentry(entry);
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_next
+ *
+ * Description:
+ *   Return the FLASH offset of the first valid inode header at or after
+ *   'offset'.
+ *
+ * Returned Value:
+ *   Zero is returned on success.  -ENOENT is returned if there are no
+ *   further inodes.  -ENOSYS is returned if the index is not available.
+ *
+ ****************************************************************************/
+
+int nxffs_index_next(FAR struct nxffs_volume_s *volume, off_t offset,
+                     FAR off_t *hoffset)
+{
+  unsigned int pos;
+
+  if (!volume->ixvalid)
+    {
+      return -ENOSYS;
+    }
+
+  pos = nxffs_index_search(volume, offset);
+  if (pos >= volume->nindex)
+    {
+      return -ENOENT;
+    }
+
+  *hoffset = volume->index[pos].hoffset;
+  return OK;
+}
+
+#endif /* CONFIG_NXFFS_INODE_INDEX */
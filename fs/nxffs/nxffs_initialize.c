@@ -313,6 +313,9 @@ int nxffs_initialize(FAR struct mtd_dev_s *mtd)
   ferr("ERROR: Failed to calculate file system limits: %d\n", -ret);
 
 errout_with_buffer:
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  nxffs_index_release(volume);
+#endif
   kmm_free(volume->pack);
 errout_with_cache:
   kmm_free(volume->cache);
@@ -357,6 +360,12 @@ int nxffs_limits(FAR struct nxffs_volume_s *volume)
   int nerased;
   int ret;
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  /* The inode index is rebuilt as the volume is scanned */
+
+  nxffs_index_reset(volume);
+#endif
+
   /* Get the offset to the first valid block on the FLASH */
 
   block = 0;
@@ -400,6 +409,10 @@ int nxffs_limits(FAR struct nxffs_volume_s *volume)
       volume->inoffset = entry.hoffset;
       finfo("First inode at offset %d\n", volume->inoffset);
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+      nxffs_index_add(volume, &entry);
+#endif
+
       /* Discard this entry and set the next offset. */
 
       offset = nxffs_inodeend(volume, &entry);
@@ -412,6 +425,10 @@ int nxffs_limits(FAR struct nxffs_volume_s *volume)
     {
       while (nxffs_nextentry(volume, offset, &entry) == OK)
         {
+#ifdef CONFIG_NXFFS_INODE_INDEX
+          nxffs_index_add(volume, &entry);
+#endif
+
           /* Discard the entry and guess the next offset. */
 
           offset = nxffs_inodeend(volume, &entry);
@@ -537,6 +554,13 @@ int nxffs_bind(FAR struct inode *blkdriver, FAR const void *data,
    */
 
   DEBUGASSERT(g_volume.cache);
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+  /* Background packing may have been stopped by a previous unbind */
+
+  g_volume.packstop = false;
+#endif
+
   *handle = &g_volume;
 #endif
   return OK;
@@ -565,6 +589,17 @@ int nxffs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return -ENOSYS;
     }
 
-  return g_volume.ofiles ? -EBUSY : OK;
+  if (g_volume.ofiles)
+    {
+      return -EBUSY;
+    }
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+  /* Do not let a background pass touch the volume after it is unbound */
+
+  nxffs_packstop(&g_volume);
+#endif
+
+  return OK;
 #endif
 }
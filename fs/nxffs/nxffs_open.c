@@ -903,6 +903,24 @@ static inline int nxffs_wrclose(FAR struct nxffs_volume_s *volume,
 
   ret = nxffs_wrinode(volume, &wrfile->ofile.entry);
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  /* Add the new inode to the inode index */
+
+  if (ret >= 0)
+    {
+      nxffs_index_add(volume, &wrfile->ofile.entry);
+    }
+#endif
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+  /* Start background packing if the FLASH is getting full */
+
+  if (ret >= 0)
+    {
+      nxffs_packschedule(volume);
+    }
+#endif
+
   /* The volume is now available for other writers */
 
 errout:
@@ -1269,10 +1287,7 @@ int nxffs_wrinode(FAR struct nxffs_volume_s *volume,
            volume->ioblock, -ret);
     }
 
-  /* The volume is now available for other writers */
-
 errout:
-  nxsem_post(&volume->wrsem);
   return ret;
 }
 
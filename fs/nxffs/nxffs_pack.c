@@ -85,6 +85,7 @@ struct nxffs_pack_s
   FAR uint8_t         *iobuffer;   /* I/O block start position */
   off_t                ioblock;    /* I/O block number */
   off_t                block0;     /* First I/O block number in the erase block */
+  off_t                moved;      /* Offset of the last src inode header moved */
   uint16_t             iooffset;   /* I/O block offset */
 };
 
@@ -710,6 +711,15 @@ static int nxffs_wrinodehdr(FAR struct nxffs_volume_s *volume,
         }
     }
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  /* Add the relocated inode back into the inode index */
+
+  if (ret >= 0)
+    {
+      nxffs_index_add(volume, &pack->dest.entry);
+    }
+#endif
+
   /* Reset the dest inode information */
 
   nxffs_freeentry(&pack->dest.entry);
@@ -949,6 +959,16 @@ static inline int nxffs_packblock(FAR struct nxffs_volume_s *volume,
            */
 
           nxffs_wrdathdr(volume, pack);
+
+#ifdef CONFIG_NXFFS_INODE_INDEX
+          /* The old inode header is no longer valid; nxffs_wrinodehdr()
+           * will index the inode at its new location.
+           */
+
+          nxffs_index_remove(volume, pack->src.entry.hoffset);
+#endif
+
+          pack->moved = pack->src.entry.hoffset;
           nxffs_wrinodehdr(volume, pack);
 
           /* Find the next valid source inode */
@@ -1244,18 +1264,26 @@ static inline int nxffs_packwriter(FAR struct nxffs_volume_s *volume,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: nxffs_pack
+ * Name: nxffs_packvolume
  *
  * Description:
  *   Pack and re-write the filesystem in order to free up memory at the end
  *   of FLASH.
  *
+ *   If maxblocks is non-zero, then packing may stop early, after about
+ *   that many erase blocks have been re-written.  Packing can only stop
+ *   on an inode boundary and only if no moved inode still has a valid
+ *   header in the part of FLASH that has not been re-written.  The FLASH
+ *   that is not packed is left as it was.  The gap between the packed
+ *   and the unpacked FLASH is wasted space, and a later pass will reclaim
+ *   it.
+ *
  * Input Parameters:
- *   volume - The volume to be packed.
+ *   volume    - The volume to be packed.
+ *   maxblocks - The maximum number of erase blocks to re-write (zero
+ *               means no limit).
+ *   complete  - Returns false if packing stopped before the whole volume
+ *               was packed.
  *
  * Returned Value:
  *   Zero on success; Otherwise, a negated errno value is returned to
@@ -1263,21 +1291,30 @@ static inline int nxffs_packwriter(FAR struct nxffs_volume_s *volume,
  *
  ****************************************************************************/
 
-int nxffs_pack(FAR struct nxffs_volume_s *volume)
+static int nxffs_packvolume(FAR struct nxffs_volume_s *volume,
+                            unsigned int maxblocks, FAR bool *complete)
 {
   struct nxffs_pack_s pack;
   FAR struct nxffs_wrfile_s *wrfile;
+  unsigned int nwritten;
+  uint16_t tailpos;
   off_t iooffset;
+  off_t froffset;
   off_t eblock;
+  off_t eend;
   off_t block;
   bool packed;
+  bool stop;
   int i;
   int ret = OK;
 
   /* Get the offset to the first valid inode entry */
 
-  wrfile = NULL;
-  packed = false;
+  wrfile    = NULL;
+  packed    = false;
+  stop      = false;
+  nwritten  = 0;
+  *complete = true;
 
   iooffset = nxffs_mediacheck(volume, &pack);
   if (iooffset == 0)
@@ -1395,6 +1432,7 @@ start_pack:
 
   pack.ioblock     = nxffs_getblock(volume, iooffset);
   pack.iooffset    = nxffs_getoffset(volume, iooffset, pack.ioblock);
+  froffset         = volume->froffset;
   volume->froffset = iooffset;
 
   /* Then pack all erase blocks starting with the erase block that contains
@@ -1405,9 +1443,22 @@ start_pack:
        eblock < volume->geo.neraseblocks;
        eblock++)
     {
+      /* If this is a bounded pass and all of the inodes have been packed,
+       * then there is no need to touch the erase blocks beyond the old end
+       * of the valid data; they are already free.
+       */
+
+      eend = (eblock + 1) * volume->geo.erasesize;
+      if (maxblocks > 0 && packed && wrfile == NULL &&
+          eend - volume->geo.erasesize >= froffset)
+        {
+          break;
+        }
+
       /* Get the starting block number of the erase block */
 
       pack.block0 = eblock * volume->blkper;
+      tailpos     = volume->geo.blocksize;
 
 #ifndef CONFIG_NXFFS_NAND
       /* Read the erase block into the pack buffer.  We need to do this even
@@ -1565,6 +1616,8 @@ start_pack:
                          volume->geo.blocksize - pack.iooffset);
                 }
 
+              tailpos = pack.iooffset;
+
               /* Next time through the loop, pack.iooffset will point to the
                * first byte after the block header.
                */
@@ -1573,6 +1626,27 @@ start_pack:
             }
         }
 
+      /* If this is a bounded pass and the budget has been used up, check if
+       * we can stop after this erase block:  The next source inode must not
+       * have been started and no moved inode may still have a valid header
+       * beyond this erase block.
+       */
+
+      if (maxblocks > 0 && ++nwritten >= maxblocks && !packed &&
+          wrfile == NULL && pack.dest.entry.hoffset == 0 &&
+          pack.moved < eend && pack.src.entry.hoffset >= eend)
+        {
+          /* Fill the unused end of the erase block so that it will not be
+           * mistaken for the end of the valid data.
+           */
+
+          memset(&volume->pack[(volume->blkper - 1) * volume->geo.blocksize +
+                               tailpos],
+                 (uint8_t)~CONFIG_NXFFS_ERASEDSTATE,
+                 volume->geo.blocksize - tailpos);
+          stop = true;
+        }
+
       /* We now have an in-memory image of how we want this erase block to
        * appear. Now it is safe to erase the block.
        */
@@ -1594,10 +1668,100 @@ start_pack:
                eblock, pack.block0, -ret);
           goto errout_with_pack;
         }
+
+      if (stop)
+        {
+          /* The rest of the FLASH is unchanged, as is the free FLASH
+           * offset.
+           */
+
+          volume->froffset = froffset;
+          *complete        = false;
+          break;
+        }
     }
 
 errout_with_pack:
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  /* If packing failed, then we don't know which inodes were moved */
+
+  if (ret < 0)
+    {
+      nxffs_index_build(volume);
+    }
+#endif
+
   nxffs_freeentry(&pack.src.entry);
   nxffs_freeentry(&pack.dest.entry);
   return ret;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_pack
+ *
+ * Description:
+ *   Pack and re-write the filesystem in order to free up memory at the end
+ *   of FLASH.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   Zero on success; Otherwise, a negated errno value is returned to
+ *   indicate the nature of the failure.
+ *
+ ****************************************************************************/
+
+int nxffs_pack(FAR struct nxffs_volume_s *volume)
+{
+  bool complete;
+  int ret;
+
+  ret = nxffs_packvolume(volume, 0, &complete);
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+  if (ret >= 0)
+    {
+      volume->gcdirty = false;
+    }
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxffs_packpass
+ *
+ * Description:
+ *   Perform one bounded packing pass.  See nxffs_packvolume() for a
+ *   description of when the pass may stop early.
+ *
+ * Input Parameters:
+ *   volume    - The volume to be packed.
+ *   maxblocks - The number of erase blocks to re-write in this pass.
+ *   complete  - Returns true if the whole volume has been packed.
+ *
+ * Returned Value:
+ *   Zero on success; Otherwise, a negated errno value is returned to
+ *   indicate the nature of the failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+int nxffs_packpass(FAR struct nxffs_volume_s *volume, unsigned int maxblocks,
+                   FAR bool *complete)
+{
+  int ret;
+
+  ret = nxffs_packvolume(volume, maxblocks, complete);
+  if (ret >= 0 && *complete)
+    {
+      volume->gcdirty = false;
+    }
+
+  return ret;
+}
+#endif
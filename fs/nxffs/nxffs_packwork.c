@@ -0,0 +1,274 @@
+/****************************************************************************
+ * fs/nxffs/nxffs_packwork.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+
+#include "nxffs.h"
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SCHED_LPWORK
+#  error Background packing requires CONFIG_SCHED_LPWORK
+#endif
+
+#if CONFIG_NXFFS_PACK_HIGHWATER < CONFIG_NXFFS_PACK_LOWWATER
+#  error CONFIG_NXFFS_PACK_HIGHWATER must not be below CONFIG_NXFFS_PACK_LOWWATER
+#endif
+
+/* Delay between packing passes and before retrying a busy volume */
+
+#define NXFFS_PACK_DELAY MSEC2TICK(CONFIG_NXFFS_PACK_DELAY)
+
+/* The watermarks in bytes of free FLASH */
+
+#define NXFFS_VOLSIZE(v)   ((v)->nblocks * (v)->geo.blocksize)
+#define NXFFS_LOWWATER(v)  (NXFFS_VOLSIZE(v) / 100 * CONFIG_NXFFS_PACK_LOWWATER)
+#define NXFFS_HIGHWATER(v) (NXFFS_VOLSIZE(v) / 100 * CONFIG_NXFFS_PACK_HIGHWATER)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void nxffs_packworker(FAR void *arg);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_freespace
+ *
+ * Description:
+ *   Return the number of bytes of free FLASH at the end of the volume.
+ *
+ ****************************************************************************/
+
+static inline off_t nxffs_freespace(FAR struct nxffs_volume_s *volume)
+{
+  return NXFFS_VOLSIZE(volume) - volume->froffset;
+}
+
+/****************************************************************************
+ * Name: nxffs_packrequeue
+ *
+ * Description:
+ *   Queue the next packing pass unless packing has been stopped.  The
+ *   check and the queuing are atomic with respect to nxffs_packstop().
+ *
+ ****************************************************************************/
+
+static void nxffs_packrequeue(FAR struct nxffs_volume_s *volume)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!volume->packstop)
+    {
+      work_queue(LPWORK, &volume->packwork, nxffs_packworker, volume,
+                 NXFFS_PACK_DELAY);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxffs_packworker
+ *
+ * Description:
+ *   Perform one bounded packing pass on the low priority work queue and
+ *   re-schedule until the high watermark is reached.
+ *
+ *   The worker never waits for the volume:  If the volume is in use or if
+ *   any file is open, it simply tries again later.  Open readers cache the
+ *   FLASH offsets of their inode and data blocks, and packing would move
+ *   those blocks underneath them.  A writer that fills the volume still
+ *   packs synchronously, just as before.
+ *
+ ****************************************************************************/
+
+static void nxffs_packworker(FAR void *arg)
+{
+  FAR struct nxffs_volume_s *volume = (FAR struct nxffs_volume_s *)arg;
+  bool complete = true;
+  bool more;
+  int ret;
+
+  ret = nxsem_trywait(&volume->exclsem);
+  if (ret < 0)
+    {
+      goto retry;
+    }
+
+  /* Packing moves inodes and data blocks.  Do not pack while any file is
+   * open and might hold offsets into the blocks that would be moved.
+   */
+
+  if (volume->ofiles != NULL)
+    {
+      nxsem_post(&volume->exclsem);
+      goto retry;
+    }
+
+  /* Holding wrsem keeps writers out for the duration of the pass */
+
+  ret = nxsem_trywait(&volume->wrsem);
+  if (ret < 0)
+    {
+      nxsem_post(&volume->exclsem);
+      goto retry;
+    }
+
+  ret = nxffs_packpass(volume, CONFIG_NXFFS_PACK_NBLOCKS, &complete);
+  if (ret < 0)
+    {
+      ferr("ERROR: Background packing failed: %d\n", -ret);
+    }
+
+  finfo("Packing pass %s, free FLASH: %ld\n",
+        complete ? "complete" : "partial", (long)nxffs_freespace(volume));
+
+  /* Decide on another pass while the volume is still held */
+
+  more = ret >= 0 && !complete &&
+         nxffs_freespace(volume) < NXFFS_HIGHWATER(volume);
+
+  nxsem_post(&volume->wrsem);
+  nxsem_post(&volume->exclsem);
+
+  if (!more)
+    {
+      return;
+    }
+
+retry:
+  nxffs_packrequeue(volume);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_packschedule
+ *
+ * Description:
+ *   Schedule background packing on the low priority work queue if inodes
+ *   have been deleted and the free FLASH has dropped below the low
+ *   watermark.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the NXFFS semaphore.
+ *
+ ****************************************************************************/
+
+void nxffs_packschedule(FAR struct nxffs_volume_s *volume)
+{
+  if (volume->gcdirty && !volume->packstop &&
+      work_available(&volume->packwork) &&
+      nxffs_freespace(volume) < NXFFS_LOWWATER(volume))
+    {
+      work_queue(LPWORK, &volume->packwork, nxffs_packworker, volume,
+                 NXFFS_PACK_DELAY);
+    }
+}
+
+/****************************************************************************
+ * Name: nxffs_packstop
+ *
+ * Description:
+ *   Stop background packing before the volume is unbound.  A pass that is
+ *   in progress holds the volume semaphore throughout, so taking it waits
+ *   for the pass to finish.  After that, the worker may still be about to
+ *   re-queue itself; it does not, because it finds packstop set.
+ *
+ * Input Parameters:
+ *   volume - The volume being unbound.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxffs_packstop(FAR struct nxffs_volume_s *volume)
+{
+  irqstate_t flags;
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(&volume->exclsem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+
+  flags = enter_critical_section();
+  volume->packstop = true;
+  (void)work_cancel(LPWORK, &volume->packwork);
+  leave_critical_section(flags);
+
+  nxsem_post(&volume->exclsem);
+}
+
+#endif /* CONFIG_NXFFS_BACKGROUND_PACK */
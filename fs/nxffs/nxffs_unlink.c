@@ -129,8 +129,20 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name)
     {
       ferr("ERROR: Failed to write block %d: %d\n",
            volume->ioblock, ret);
+      goto errout_with_entry;
     }
 
+#ifdef CONFIG_NXFFS_INODE_INDEX
+  nxffs_index_remove(volume, entry.hoffset);
+#endif
+
+#ifdef CONFIG_NXFFS_BACKGROUND_PACK
+  /* The deleted inode can now be reclaimed */
+
+  volume->gcdirty = true;
+  nxffs_packschedule(volume);
+#endif
+
 errout_with_entry:
   nxffs_freeentry(&entry);
 errout:
@@ -0,0 +1,1003 @@
+/****************************************************************************
+ * fs/pgcache/fs_pgcache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/ioctl.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+
+#include "pgcache/pgcache.h"
+
+#ifdef CONFIG_FS_PAGECACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PGCACHE_PAGESIZE  CONFIG_FS_PAGECACHE_PAGESIZE
+#define PGCACHE_PAGEMASK  (PGCACHE_PAGESIZE - 1)
+
+#if (PGCACHE_PAGESIZE & PGCACHE_PAGEMASK) != 0
+#  error CONFIG_FS_PAGECACHE_PAGESIZE must be a power of two
+#endif
+
+/* Number of page hash chains (must be a power of two) */
+
+#define PGCACHE_NHASH     32
+#define PGCACHE_HASH(f,o) \
+  ((((uintptr_t)(f) >> 4) ^ (uintptr_t)((o) / PGCACHE_PAGESIZE)) & \
+   (PGCACHE_NHASH - 1))
+
+#define SIZEOF_PGCACHE_FILE_S(n) (sizeof(struct pgcache_file_s) + (n))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The cache identity of one file.  Open files of a page cached mountpoint
+ * are identified by the mountpoint inode and the path relative to it,
+ * because the mountpoint inode is all that the VFS knows about them.
+ * The identity lives as long as it is referenced by an open file or by a
+ * cached page.
+ */
+
+struct pgcache_file_s
+{
+  FAR struct pgcache_file_s *flink; /* Next identity in g_pgcache.files */
+  FAR struct inode *mountpt;        /* Mountpoint inode of the file */
+  uint16_t crefs;                   /* Number of open files */
+  uint16_t npages;                  /* Number of cached pages */
+  uint32_t wrgen;                   /* Bumped whenever pages are invalidated */
+  bool forgotten;                   /* Unlinked or renamed, no longer cached */
+  char relpath[1];                  /* Path relative to the mountpoint */
+};
+
+/* One cached page of file data */
+
+struct pgcache_page_s
+{
+  dq_entry_t lru;                   /* Position in the LRU list (must be first) */
+  FAR struct pgcache_page_s *hlink; /* Next page in the same hash chain */
+  FAR struct pgcache_file_s *file;  /* File that the data belongs to */
+  off_t offset;                     /* File offset of the page */
+  size_t len;                       /* Valid bytes (< PAGESIZE only at EOF) */
+  uint8_t data[PGCACHE_PAGESIZE];   /* The file data */
+};
+
+/* The state of the page cache */
+
+struct pgcache_s
+{
+  sem_t exclsem;                    /* Protects everything below */
+  FAR struct pgcache_file_s *files; /* Identities that can be opened */
+  FAR struct pgcache_page_s *hash[PGCACHE_NHASH];
+  dq_queue_t lru;                   /* Most recently used page first */
+  unsigned int npages;              /* Number of cached pages */
+  unsigned long hits;               /* Statistics */
+  unsigned long misses;
+  unsigned long evictions;
+  unsigned long reclaims;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static size_t pgcache_reclaim(size_t size);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct pgcache_s g_pgcache;
+
+/* File systems whose files may be cached.  File systems whose data may
+ * change underneath the VFS (NFS, HOSTFS), that already live in RAM
+ * (TMPFS), that are generated on the fly (PROCFS, BINFS) or that keep
+ * their own cache of decoded data (CROMFS) are not included.  Neither are
+ * file systems whose names ignore case (VFAT):  A cached file is known
+ * only by its path, and "A.TXT" and "a.txt" may be the same file there.
+ */
+
+static FAR const char * const g_pgcache_fstypes[] =
+{
+  "romfs",
+  "smartfs",
+  "nxffs",
+  NULL
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pgcache_takesem and pgcache_givesem
+ ****************************************************************************/
+
+static void pgcache_takesem(void)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(&g_pgcache.exclsem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+#define pgcache_givesem() nxsem_post(&g_pgcache.exclsem)
+
+/****************************************************************************
+ * Name: pgcache_release
+ *
+ * Description:
+ *   Free a cache identity that is no longer referenced.
+ *
+ * Assumptions:
+ *   The caller holds the page cache semaphore.
+ *
+ ****************************************************************************/
+
+static void pgcache_release(FAR struct pgcache_file_s *file)
+{
+  FAR struct pgcache_file_s *prev;
+  FAR struct pgcache_file_s *curr;
+
+  if (file->crefs > 0 || file->npages > 0)
+    {
+      return;
+    }
+
+  if (!file->forgotten)
+    {
+      for (prev = NULL, curr = g_pgcache.files;
+           curr != NULL && curr != file;
+           prev = curr, curr = curr->flink);
+
+      DEBUGASSERT(curr != NULL);
+      if (prev != NULL)
+        {
+          prev->flink = file->flink;
+        }
+      else
+        {
+          g_pgcache.files = file->flink;
+        }
+    }
+
+  kmm_free(file);
+}
+
+/****************************************************************************
+ * Name: pgcache_find
+ *
+ * Description:
+ *   Find the cached page of 'file' at 'offset'.
+ *
+ * Assumptions:
+ *   The caller holds the page cache semaphore.
+ *
+ ****************************************************************************/
+
+static FAR struct pgcache_page_s *
+pgcache_find(FAR struct pgcache_file_s *file, off_t offset)
+{
+  FAR struct pgcache_page_s *page;
+
+  for (page = g_pgcache.hash[PGCACHE_HASH(file, offset)];
+       page != NULL;
+       page = page->hlink)
+    {
+      if (page->file == file && page->offset == offset)
+        {
+          break;
+        }
+    }
+
+  return page;
+}
+
+/****************************************************************************
+ * Name: pgcache_remove
+ *
+ * Description:
+ *   Remove a page from the cache.  The page memory is not freed.  The
+ *   identity of the page's file is freed if this was its last reference.
+ *
+ * Assumptions:
+ *   The caller holds the page cache semaphore.
+ *
+ ****************************************************************************/
+
+static void pgcache_remove(FAR struct pgcache_page_s *page)
+{
+  FAR struct pgcache_page_s **pprev;
+  FAR struct pgcache_file_s *file = page->file;
+
+  for (pprev = &g_pgcache.hash[PGCACHE_HASH(file, page->offset)];
+       *pprev != page;
+       pprev = &(*pprev)->hlink)
+    {
+      DEBUGASSERT(*pprev != NULL);
+    }
+
+  *pprev = page->hlink;
+  dq_rem(&page->lru, &g_pgcache.lru);
+
+  g_pgcache.npages--;
+  file->npages--;
+  pgcache_release(file);
+}
+
+/****************************************************************************
+ * Name: pgcache_invalidate
+ *
+ * Description:
+ *   Drop the cached pages of 'file' that overlap the range [start, end).
+ *   A negative 'end' means the end of the file.  The page holding the end
+ *   of file is always dropped because any write may have changed the size
+ *   of the file.
+ *
+ *   The write generation of the file is advanced so that a page that is
+ *   being read from the driver concurrently is not cached afterwards; it
+ *   may hold the data from before the change.
+ *
+ * Assumptions:
+ *   The caller holds the page cache semaphore.
+ *
+ ****************************************************************************/
+
+static void pgcache_invalidate(FAR struct pgcache_file_s *file,
+                               off_t start, off_t end)
+{
+  FAR struct pgcache_page_s *page;
+  FAR dq_entry_t *next;
+  FAR dq_entry_t *curr;
+
+  file->wrgen++;
+
+  for (curr = dq_peek(&g_pgcache.lru); curr != NULL; curr = next)
+    {
+      next = dq_next(curr);
+      page = (FAR struct pgcache_page_s *)curr;
+
+      if (page->file == file &&
+          (page->len < PGCACHE_PAGESIZE ||
+           ((end < 0 || page->offset < end) &&
+            page->offset + PGCACHE_PAGESIZE > start)))
+        {
+          pgcache_remove(page);
+          kmm_free(page);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: pgcache_alloc
+ *
+ * Description:
+ *   Get a page buffer, recycling the least recently used page if the cache
+ *   is full.
+ *
+ ****************************************************************************/
+
+static FAR struct pgcache_page_s *pgcache_alloc(void)
+{
+  FAR struct pgcache_page_s *page = NULL;
+
+  pgcache_takesem();
+  if (g_pgcache.npages >= CONFIG_FS_PAGECACHE_MAXPAGES &&
+      g_pgcache.lru.tail != NULL)
+    {
+      page = (FAR struct pgcache_page_s *)g_pgcache.lru.tail;
+      pgcache_remove(page);
+      g_pgcache.evictions++;
+    }
+
+  pgcache_givesem();
+
+  if (page == NULL)
+    {
+      page = (FAR struct pgcache_page_s *)
+        kmm_malloc(sizeof(struct pgcache_page_s));
+    }
+
+  return page;
+}
+
+/****************************************************************************
+ * Name: pgcache_insert
+ *
+ * Description:
+ *   Add a newly filled page to the cache.  The page is discarded if another
+ *   thread cached the same page in the meantime, if the file was forgotten
+ *   while the page was being read, or if the file was written or truncated
+ *   since 'wrgen' was sampled before the read.
+ *
+ ****************************************************************************/
+
+static void pgcache_insert(FAR struct pgcache_file_s *file,
+                           FAR struct pgcache_page_s *page, uint32_t wrgen)
+{
+  FAR struct pgcache_page_s *victim;
+  int ndx;
+
+  pgcache_takesem();
+  if (file->forgotten || file->wrgen != wrgen ||
+      pgcache_find(file, page->offset) != NULL)
+    {
+      pgcache_givesem();
+      kmm_free(page);
+      return;
+    }
+
+  while (g_pgcache.npages >= CONFIG_FS_PAGECACHE_MAXPAGES &&
+         g_pgcache.lru.tail != NULL)
+    {
+      victim = (FAR struct pgcache_page_s *)g_pgcache.lru.tail;
+      pgcache_remove(victim);
+      kmm_free(victim);
+      g_pgcache.evictions++;
+    }
+
+  ndx               = PGCACHE_HASH(file, page->offset);
+  page->file        = file;
+  page->hlink       = g_pgcache.hash[ndx];
+  g_pgcache.hash[ndx] = page;
+  dq_addfirst(&page->lru, &g_pgcache.lru);
+
+  g_pgcache.npages++;
+  file->npages++;
+  pgcache_givesem();
+}
+
+/****************************************************************************
+ * Name: pgcache_drvseek
+ *
+ * Description:
+ *   Position the driver at 'pos'.  On return, filep->f_pos and
+ *   filep->f_drvpos hold the resulting driver position; the caller must
+ *   restore the file position if it differs.
+ *
+ ****************************************************************************/
+
+static int pgcache_drvseek(FAR struct file *filep, off_t pos)
+{
+  FAR struct inode *inode = filep->f_inode;
+  off_t ret;
+
+  filep->f_pos = filep->f_drvpos;
+  if (pos == filep->f_drvpos)
+    {
+      return OK;
+    }
+
+  ret = inode->u.i_ops->seek(filep, pos, SEEK_SET);
+  filep->f_drvpos = filep->f_pos;
+  return ret < 0 ? (int)ret : OK;
+}
+
+/****************************************************************************
+ * Name: pgcache_fill
+ *
+ * Description:
+ *   Read the page at 'offset' from the driver.  The file position is not
+ *   changed.
+ *
+ ****************************************************************************/
+
+static int pgcache_fill(FAR struct file *filep,
+                        FAR struct pgcache_page_s *page, off_t offset)
+{
+  FAR struct inode *inode = filep->f_inode;
+  off_t pos = filep->f_pos;
+  ssize_t nread;
+  int ret;
+
+  page->offset = offset;
+  page->len    = 0;
+
+  ret = pgcache_drvseek(filep, offset);
+  if (ret >= 0)
+    {
+      while (page->len < PGCACHE_PAGESIZE)
+        {
+          nread = inode->u.i_ops->read(filep,
+                                       (FAR char *)&page->data[page->len],
+                                       PGCACHE_PAGESIZE - page->len);
+          if (nread <= 0)
+            {
+              ret = (int)nread;
+              break;
+            }
+
+          page->len += nread;
+        }
+
+      filep->f_drvpos = filep->f_pos;
+    }
+
+  filep->f_pos = pos;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pgcache_rawread
+ *
+ * Description:
+ *   Read directly through the driver, bypassing the cache.
+ *
+ ****************************************************************************/
+
+static ssize_t pgcache_rawread(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct inode *inode = filep->f_inode;
+  ssize_t ret;
+
+  ret = pgcache_sync(filep);
+  if (ret >= 0)
+    {
+      ret = inode->u.i_ops->read(filep, buffer, buflen);
+      filep->f_drvpos = filep->f_pos;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pgcache_below
+ *
+ * Description:
+ *   Return true if 'file' is the file or directory at 'relpath', which is
+ *   'len' bytes long without any trailing '/', or is below it.
+ *
+ ****************************************************************************/
+
+static bool pgcache_below(FAR struct pgcache_file_s *file,
+                          FAR const char *relpath, size_t len)
+{
+  return strncmp(file->relpath, relpath, len) == 0 &&
+         (file->relpath[len] == '\0' || file->relpath[len] == '/');
+}
+
+/****************************************************************************
+ * Name: pgcache_reclaim
+ *
+ * Description:
+ *   The heap reclaim handler:  Release least recently used pages until
+ *   'size' bytes have been freed.  Nothing is released if the page cache is
+ *   busy; the allocation that failed may have been made by the page cache
+ *   itself.
+ *
+ ****************************************************************************/
+
+static size_t pgcache_reclaim(size_t size)
+{
+  FAR struct pgcache_page_s *page;
+  size_t released = 0;
+
+  if (nxsem_trywait(&g_pgcache.exclsem) < 0)
+    {
+      return 0;
+    }
+
+  while (released < size && g_pgcache.lru.tail != NULL)
+    {
+      page = (FAR struct pgcache_page_s *)g_pgcache.lru.tail;
+      pgcache_remove(page);
+      kmm_free(page);
+
+      released += sizeof(struct pgcache_page_s);
+      g_pgcache.reclaims++;
+    }
+
+  pgcache_givesem();
+  return released;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pgcache_initialize
+ ****************************************************************************/
+
+void pgcache_initialize(void)
+{
+  (void)nxsem_init(&g_pgcache.exclsem, 0, 1);
+
+  /* The pages are allocated with kmm_malloc().  Without a separate kernel
+   * heap, that is the user heap, which cannot be named here in every build
+   * mode; the handler is then called for any heap.
+   */
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  (void)mm_addreclaim(&g_kmmheap, pgcache_reclaim);
+#else
+  (void)mm_addreclaim(NULL, pgcache_reclaim);
+#endif
+}
+
+/****************************************************************************
+ * Name: pgcache_mountable
+ ****************************************************************************/
+
+bool pgcache_mountable(FAR const char *filesystemtype)
+{
+  FAR const char * const *fstype;
+
+  for (fstype = g_pgcache_fstypes; *fstype != NULL; fstype++)
+    {
+      if (strcmp(filesystemtype, *fstype) == 0)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: pgcache_open
+ ****************************************************************************/
+
+void pgcache_open(FAR struct file *filep, FAR const char *relpath)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct pgcache_file_s *file;
+  FAR void *addr;
+
+  filep->f_pgfile = NULL;
+  filep->f_drvpos = filep->f_pos;
+
+  if (inode->u.i_ops->read == NULL || inode->u.i_ops->seek == NULL)
+    {
+      return;
+    }
+
+  /* Files that can be accessed in place (XIP) gain nothing from a copy */
+
+  if (inode->u.i_ops->ioctl != NULL &&
+      inode->u.i_ops->ioctl(filep, FIOC_MMAP,
+                            (unsigned long)((uintptr_t)&addr)) >= 0)
+    {
+      return;
+    }
+
+  pgcache_takesem();
+  for (file = g_pgcache.files; file != NULL; file = file->flink)
+    {
+      if (file->mountpt == inode && strcmp(file->relpath, relpath) == 0)
+        {
+          break;
+        }
+    }
+
+  if (file == NULL)
+    {
+      file = (FAR struct pgcache_file_s *)
+        kmm_zalloc(SIZEOF_PGCACHE_FILE_S(strlen(relpath)));
+      if (file == NULL)
+        {
+          pgcache_givesem();
+          return;
+        }
+
+      file->mountpt   = inode;
+      strcpy(file->relpath, relpath);
+      file->flink     = g_pgcache.files;
+      g_pgcache.files = file;
+    }
+  else if ((filep->f_oflags & O_TRUNC) != 0)
+    {
+      pgcache_invalidate(file, 0, -1);
+    }
+
+  file->crefs++;
+  filep->f_pgfile = file;
+  pgcache_givesem();
+}
+
+/****************************************************************************
+ * Name: pgcache_dup
+ ****************************************************************************/
+
+void pgcache_dup(FAR struct file *filep1, FAR struct file *filep2)
+{
+  FAR struct pgcache_file_s *file = filep1->f_pgfile;
+
+  filep2->f_pgfile = file;
+  filep2->f_drvpos = filep2->f_pos;
+
+  if (file != NULL)
+    {
+      pgcache_takesem();
+      file->crefs++;
+      pgcache_givesem();
+    }
+}
+
+/****************************************************************************
+ * Name: pgcache_close
+ ****************************************************************************/
+
+void pgcache_close(FAR struct file *filep)
+{
+  FAR struct pgcache_file_s *file = filep->f_pgfile;
+
+  if (file != NULL)
+    {
+      filep->f_pgfile = NULL;
+
+      pgcache_takesem();
+      DEBUGASSERT(file->crefs > 0);
+      file->crefs--;
+      pgcache_release(file);
+      pgcache_givesem();
+    }
+}
+
+/****************************************************************************
+ * Name: pgcache_read
+ ****************************************************************************/
+
+ssize_t pgcache_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+  FAR struct pgcache_file_s *file = filep->f_pgfile;
+  FAR struct pgcache_page_s *page;
+  ssize_t nread = 0;
+  off_t offset;
+  size_t pgpos;
+  size_t ncopy;
+  uint32_t wrgen;
+  bool eof;
+  int ret;
+
+  DEBUGASSERT(file != NULL);
+  if (file->forgotten)
+    {
+      return pgcache_rawread(filep, buffer, buflen);
+    }
+
+  while (buflen > 0)
+    {
+      offset = filep->f_pos & ~(off_t)PGCACHE_PAGEMASK;
+      pgpos  = filep->f_pos - offset;
+      ncopy  = 0;
+
+      pgcache_takesem();
+      page = pgcache_find(file, offset);
+      if (page != NULL)
+        {
+          /* Hit.  Copy out while the page cannot be recycled. */
+
+          g_pgcache.hits++;
+          dq_rem(&page->lru, &g_pgcache.lru);
+          dq_addfirst(&page->lru, &g_pgcache.lru);
+
+          if (pgpos < page->len)
+            {
+              ncopy = page->len - pgpos;
+              if (ncopy > buflen)
+                {
+                  ncopy = buflen;
+                }
+
+              memcpy(buffer, &page->data[pgpos], ncopy);
+            }
+
+          eof = page->len < PGCACHE_PAGESIZE;
+          pgcache_givesem();
+        }
+      else
+        {
+          /* Miss.  Read the page without holding the semaphore.  A write
+           * that completes meanwhile advances the write generation.
+           */
+
+          g_pgcache.misses++;
+          wrgen = file->wrgen;
+          pgcache_givesem();
+
+          page = pgcache_alloc();
+          if (page == NULL)
+            {
+              /* No memory at all; just let the driver do the read */
+
+              if (nread > 0)
+                {
+                  break;
+                }
+
+              return pgcache_rawread(filep, buffer, buflen);
+            }
+
+          ret = pgcache_fill(filep, page, offset);
+          if (ret < 0)
+            {
+              kmm_free(page);
+              return nread > 0 ? nread : ret;
+            }
+
+          if (pgpos < page->len)
+            {
+              ncopy = page->len - pgpos;
+              if (ncopy > buflen)
+                {
+                  ncopy = buflen;
+                }
+
+              memcpy(buffer, &page->data[pgpos], ncopy);
+            }
+
+          eof = page->len < PGCACHE_PAGESIZE;
+          pgcache_insert(file, page, wrgen);
+        }
+
+      filep->f_pos += ncopy;
+      buffer       += ncopy;
+      buflen       -= ncopy;
+      nread        += ncopy;
+
+      /* Stop at the end of the file */
+
+      if (eof || ncopy == 0)
+        {
+          break;
+        }
+    }
+
+  return nread;
+}
+
+/****************************************************************************
+ * Name: pgcache_seek
+ ****************************************************************************/
+
+off_t pgcache_seek(FAR struct file *filep, off_t offset, int whence)
+{
+  FAR struct inode *inode = filep->f_inode;
+  off_t ret;
+
+  switch (whence)
+    {
+      case SEEK_CUR:
+        offset += filep->f_pos;
+
+        /* FALLTHROUGH */
+
+      case SEEK_SET:
+        if (offset < 0)
+          {
+            return -EINVAL;
+          }
+
+        filep->f_pos = offset;
+        return offset;
+
+      default:
+
+        /* SEEK_END depends on the file size that only the driver knows */
+
+        ret = pgcache_sync(filep);
+        if (ret >= 0)
+          {
+            ret = inode->u.i_ops->seek(filep, offset, whence);
+            filep->f_drvpos = filep->f_pos;
+          }
+
+        return ret;
+    }
+}
+
+/****************************************************************************
+ * Name: pgcache_sync
+ ****************************************************************************/
+
+int pgcache_sync(FAR struct file *filep)
+{
+  off_t pos = filep->f_pos;
+  int ret;
+
+  ret = pgcache_drvseek(filep, pos);
+  if (ret < 0)
+    {
+      filep->f_pos = pos;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pgcache_written
+ ****************************************************************************/
+
+void pgcache_written(FAR struct file *filep, ssize_t nwritten)
+{
+  FAR struct pgcache_file_s *file = filep->f_pgfile;
+
+  filep->f_drvpos = filep->f_pos;
+
+  /* The driver has updated the file position; with O_APPEND it may not be
+   * where the write was expected to start.
+   */
+
+  if (nwritten > 0 && !file->forgotten)
+    {
+      pgcache_takesem();
+      pgcache_invalidate(file, filep->f_pos - nwritten, filep->f_pos);
+      pgcache_givesem();
+    }
+}
+
+/****************************************************************************
+ * Name: pgcache_truncated
+ ****************************************************************************/
+
+void pgcache_truncated(FAR struct file *filep, off_t length)
+{
+  FAR struct pgcache_file_s *file = filep->f_pgfile;
+
+  filep->f_drvpos = filep->f_pos;
+
+  /* Pages past the new end of file are gone.  The old end of file page is
+   * dropped too, since the file may have been extended beyond it.
+   */
+
+  if (!file->forgotten)
+    {
+      pgcache_takesem();
+      pgcache_invalidate(file, length, -1);
+      pgcache_givesem();
+    }
+}
+
+/****************************************************************************
+ * Name: pgcache_forget
+ ****************************************************************************/
+
+void pgcache_forget(FAR struct inode *mountpt, FAR const char *relpath)
+{
+  FAR struct pgcache_file_s *prev;
+  FAR struct pgcache_file_s *file;
+  FAR struct pgcache_file_s *next;
+  size_t len;
+
+  /* A directory may be named with trailing '/' characters */
+
+  for (len = strlen(relpath); len > 0 && relpath[len - 1] == '/'; len--);
+
+  pgcache_takesem();
+  for (prev = NULL, file = g_pgcache.files; file != NULL; file = next)
+    {
+      next = file->flink;
+
+      if (file->mountpt != mountpt || !pgcache_below(file, relpath, len))
+        {
+          prev = file;
+          continue;
+        }
+
+      if (prev != NULL)
+        {
+          prev->flink = next;
+        }
+      else
+        {
+          g_pgcache.files = next;
+        }
+
+      /* Open files keep their reference but now read through the driver.
+       * The identity itself is freed here if it is not open.
+       */
+
+      file->forgotten = true;
+      pgcache_invalidate(file, 0, -1);
+    }
+
+  pgcache_givesem();
+}
+
+/****************************************************************************
+ * Name: pgcache_purge
+ ****************************************************************************/
+
+void pgcache_purge(FAR struct inode *mountpt)
+{
+  FAR struct pgcache_page_s *page;
+  FAR dq_entry_t *next;
+  FAR dq_entry_t *curr;
+
+  pgcache_takesem();
+  for (curr = dq_peek(&g_pgcache.lru); curr != NULL; curr = next)
+    {
+      next = dq_next(curr);
+      page = (FAR struct pgcache_page_s *)curr;
+
+      if (page->file->mountpt == mountpt)
+        {
+          pgcache_remove(page);
+          kmm_free(page);
+        }
+    }
+
+  pgcache_givesem();
+}
+
+/****************************************************************************
+ * Name: pgcache_info
+ ****************************************************************************/
+
+void pgcache_info(FAR struct pgcacheinfo_s *info)
+{
+  pgcache_takesem();
+  info->npages    = g_pgcache.npages;
+  info->maxpages  = CONFIG_FS_PAGECACHE_MAXPAGES;
+  info->pagesize  = PGCACHE_PAGESIZE;
+  info->hits      = g_pgcache.hits;
+  info->misses    = g_pgcache.misses;
+  info->evictions = g_pgcache.evictions;
+  info->reclaims  = g_pgcache.reclaims;
+  pgcache_givesem();
+}
+
+#endif /* CONFIG_FS_PAGECACHE */
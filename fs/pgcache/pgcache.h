@@ -0,0 +1,248 @@
+/****************************************************************************
+ * fs/pgcache/pgcache.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#ifndef __FS_PGCACHE_PGCACHE_H
+#define __FS_PGCACHE_PGCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+
+#include <nuttx/fs/fs.h>
+
+#ifdef CONFIG_FS_PAGECACHE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Page cache statistics as reported by pgcache_info() */
+
+struct pgcacheinfo_s
+{
+  unsigned int npages;     /* Number of pages currently cached */
+  unsigned int maxpages;   /* Maximum number of cached pages */
+  size_t pagesize;         /* Size of one page in bytes */
+  unsigned long hits;      /* Page lookups that found the page cached */
+  unsigned long misses;    /* Page lookups that required a driver read */
+  unsigned long evictions; /* Pages recycled to hold other data */
+  unsigned long reclaims;  /* Pages released because the heap was empty */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: pgcache_initialize
+ *
+ * Description:
+ *   Initialize the page cache and register its heap reclaim handler.
+ *   Called once from fs_initialize().
+ *
+ ****************************************************************************/
+
+void pgcache_initialize(void);
+
+/****************************************************************************
+ * Name: pgcache_mountable
+ *
+ * Description:
+ *   Return true if files of the named file system type may be held in the
+ *   page cache.  Called by mount() to mark the mountpoint inode with
+ *   FSNODEFLAG_PGCACHE.
+ *
+ ****************************************************************************/
+
+bool pgcache_mountable(FAR const char *filesystemtype);
+
+/****************************************************************************
+ * Name: pgcache_open
+ *
+ * Description:
+ *   Attach a newly opened file on a page cached mountpoint to the cache
+ *   identity of 'relpath', creating the identity if necessary.  Files for
+ *   which no identity can be allocated are simply not cached.
+ *
+ * Input Parameters:
+ *   filep   - The open file; the driver open method has already succeeded
+ *   relpath - The path of the file relative to the mountpoint
+ *
+ ****************************************************************************/
+
+void pgcache_open(FAR struct file *filep, FAR const char *relpath);
+
+/****************************************************************************
+ * Name: pgcache_dup
+ *
+ * Description:
+ *   Share the cache identity of filep1 with its duplicate filep2.  The
+ *   caller must have called pgcache_sync(filep1) before duplicating the
+ *   driver state.
+ *
+ ****************************************************************************/
+
+void pgcache_dup(FAR struct file *filep1, FAR struct file *filep2);
+
+/****************************************************************************
+ * Name: pgcache_close
+ *
+ * Description:
+ *   Release the reference of 'filep' on its cache identity.  The cached
+ *   pages are kept so that the file can be reopened without re-reading it.
+ *
+ ****************************************************************************/
+
+void pgcache_close(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: pgcache_read
+ *
+ * Description:
+ *   Read from a page cached file at its current position.  This replaces
+ *   the driver read method in file_read().
+ *
+ * Returned Value:
+ *   The number of bytes read, 0 at the end of file, or a negated errno
+ *   value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pgcache_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+/****************************************************************************
+ * Name: pgcache_seek
+ *
+ * Description:
+ *   Reposition a page cached file.  SEEK_SET and SEEK_CUR only update the
+ *   file position; the driver is repositioned lazily by pgcache_sync().
+ *
+ ****************************************************************************/
+
+off_t pgcache_seek(FAR struct file *filep, off_t offset, int whence);
+
+/****************************************************************************
+ * Name: pgcache_sync
+ *
+ * Description:
+ *   Move the driver position of a page cached file to the file position
+ *   before a driver method that depends on it is called.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pgcache_sync(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: pgcache_written
+ *
+ * Description:
+ *   Called after the driver write method of a page cached file returned
+ *   'nwritten'.  Cached pages that overlap the written data are dropped.
+ *
+ ****************************************************************************/
+
+void pgcache_written(FAR struct file *filep, ssize_t nwritten);
+
+/****************************************************************************
+ * Name: pgcache_truncated
+ *
+ * Description:
+ *   Called after the driver truncate method of a page cached file was
+ *   called with 'length'.  Cached pages past the old or the new end of file
+ *   are dropped.
+ *
+ ****************************************************************************/
+
+void pgcache_truncated(FAR struct file *filep, off_t length);
+
+/****************************************************************************
+ * Name: pgcache_forget
+ *
+ * Description:
+ *   Drop the cached pages of the file at 'relpath' on 'mountpt', or of all
+ *   files below 'relpath' if it is a directory, and detach their identities
+ *   so that a file subsequently created with the same name is not confused
+ *   with them.  Called on unlink(), rename() and rmdir().
+ *
+ ****************************************************************************/
+
+void pgcache_forget(FAR struct inode *mountpt, FAR const char *relpath);
+
+/****************************************************************************
+ * Name: pgcache_purge
+ *
+ * Description:
+ *   Drop all cached pages of files on 'mountpt'.  Called when the file
+ *   system is unmounted.
+ *
+ ****************************************************************************/
+
+void pgcache_purge(FAR struct inode *mountpt);
+
+/****************************************************************************
+ * Name: pgcache_info
+ *
+ * Description:
+ *   Return the page cache statistics.
+ *
+ ****************************************************************************/
+
+void pgcache_info(FAR struct pgcacheinfo_s *info);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_FS_PAGECACHE */
+#endif /* __FS_PGCACHE_PGCACHE_H */
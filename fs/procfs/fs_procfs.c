@@ -80,8 +80,10 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations meminfo_operations;
+extern const struct procfs_operations mempool_operations;
 extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
+extern const struct procfs_operations wqueue_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
  * deal with them here is not a good coupling. What is really needed is a
@@ -94,6 +96,7 @@ extern const struct procfs_operations net_procfs_routeoperations;
 extern const struct procfs_operations mtd_procfsoperations;
 extern const struct procfs_operations part_procfsoperations;
 extern const struct procfs_operations mount_procfsoperations;
+extern const struct procfs_operations blkcache_procfsoperations;
 extern const struct procfs_operations smartfs_procfsoperations;
 
 /* And even worse, this one is specific to the STM32.  The solution to
@@ -133,10 +136,18 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL
+  { "mempool",       &mempool_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MODULE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_DRVR_BLKCACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BLKCACHE)
+  { "fs/blkcache",   &blkcache_procfsoperations,  PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_BLOCKS
   { "fs/blocks",     &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
@@ -173,6 +184,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
+
+#if defined(CONFIG_SCHED_WORKQUEUE_EVENT) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+  { "wqueue",        &wqueue_operations,          PROCFS_FILE_TYPE   },
+#endif
 };
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
@@ -58,6 +58,8 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
 
+#include "pgcache/pgcache.h"
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
 
 /****************************************************************************
@@ -67,7 +69,7 @@
  * to handle the longest line generated by this logic.
  */
 
-#define MEMINFO_LINELEN 54
+#define MEMINFO_LINELEN 64
 
 /****************************************************************************
  * Private Types
@@ -354,6 +356,43 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_MM_UMM_CACHE
+  if (totalsize < buflen)
+    {
+      struct mcacheinfo_s cinfo;
+      int ndx;
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show the per-class user heap cache statistics */
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Ucache:  size cached      hits    misses"
+                            "     frees    drains\n");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      for (ndx = 0;
+           totalsize < buflen && umm_mcacheinfo(ndx, &cinfo) >= 0;
+           ndx++)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                                "       %6lu%7u%10lu%10lu%10lu%10lu\n",
+                                (unsigned long)cinfo.chunksize,
+                                cinfo.ncached, cinfo.hits, cinfo.misses,
+                                cinfo.frees, cinfo.drains);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
 #ifdef CONFIG_MM_PGALLOC
   if (totalsize < buflen)
     {
@@ -385,6 +424,42 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_FS_PAGECACHE
+  if (totalsize < buflen)
+    {
+      struct pgcacheinfo_s pcinfo;
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      /* Show the file system page cache statistics */
+
+      pgcache_info(&pcinfo);
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "Pcache:  size pages      hits    misses"
+                            "   evicted reclaimed\n");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                                "       %6lu%6u%10lu%10lu%10lu%10lu\n",
+                                (unsigned long)pcinfo.pagesize,
+                                pcinfo.npages, pcinfo.hits, pcinfo.misses,
+                                pcinfo.evictions, pcinfo.reclaims);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
 #if defined(CONFIG_ARCH_HAVE_PROGMEM) && defined(CONFIG_FS_PROCFS_INCLUDE_PROGMEM)
   if (totalsize < buflen)
     {
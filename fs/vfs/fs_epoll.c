@@ -42,15 +42,192 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
 #include <errno.h>
 #include <string.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
 
 #ifndef CONFIG_DISABLE_POLL
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These are the events that epoll always reports */
+
+#define EPOLL_ALWAYS   (POLLERR | POLLHUP)
+
+/* These are the flags that are interpreted by epoll itself */
+
+#define EPOLL_FLAGS    (EPOLLET | EPOLLONESHOT)
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+#  define HAVE_EPOLL_SOCKETS 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The reference that an epoll instance holds on the open file or socket of
+ * one entry in its interest list.  The poll is set up and torn down on
+ * this private clone, never through the descriptor number:  The caller may
+ * close the descriptor or reuse its number at any time.
+ */
+
+struct epoll_file_s
+{
+#ifdef HAVE_EPOLL_SOCKETS
+  bool issock;                 /* True: u.sock is in use, not u.file */
+#endif
+  union
+  {
+    struct file file;          /* Clone of the open file */
+#ifdef HAVE_EPOLL_SOCKETS
+    struct socket sock;        /* Clone of the socket */
+#endif
+  } u;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the entry for a descriptor in the interest list.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_event *epoll_find(FAR struct epoll_head *eph, int fd)
+{
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->evs[i].sem != NULL && eph->evs[i].data.fd == fd)
+        {
+          return &eph->evs[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_addref
+ *
+ * Description:
+ *   Take a reference on the open file or socket of a descriptor by cloning
+ *   it, as dup() would, into the private reference of an entry.
+ *
+ ****************************************************************************/
+
+static int epoll_addref(FAR struct epoll_file_s *ref, int fd)
+{
+  FAR struct file *filep;
+  int ret;
+
+  memset(ref, 0, sizeof(struct epoll_file_s));
+
+#ifdef HAVE_EPOLL_SOCKETS
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      FAR struct socket *psock = sockfd_socket(fd);
+
+      if (psock == NULL || psock->s_crefs <= 0)
+        {
+          return -EBADF;
+        }
+
+      ret = net_clone(psock, &ref->u.sock);
+      if (ret >= 0)
+        {
+          ref->issock = true;
+        }
+
+      return ret;
+    }
+#endif
+
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_dup2(filep, &ref->u.file);
+}
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Release the reference taken by epoll_addref().
+ *
+ ****************************************************************************/
+
+static void epoll_release(FAR struct epoll_file_s *ref)
+{
+#ifdef HAVE_EPOLL_SOCKETS
+  if (ref->issock)
+    {
+      (void)psock_close(&ref->u.sock);
+      ref->issock = false;
+      return;
+    }
+#endif
+
+  (void)file_close_detached(&ref->u.file);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Set up (or tear down) the poll on one entry of the interest list.  An
+ *   entry is set up only while its events are non-zero;  a one-shot entry
+ *   that has been reported has no events until it is modified.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_head *eph,
+                       FAR struct epoll_event *ev, bool setup)
+{
+  FAR struct epoll_file_s *ref = &eph->files[ev - eph->evs];
+
+  if (ev->events == 0)
+    {
+      return OK;
+    }
+
+  if (setup)
+    {
+      ev->sem     = &eph->sem;
+      ev->revents = 0;
+      ev->priv    = NULL;
+    }
+
+#ifdef HAVE_EPOLL_SOCKETS
+  if (ref->issock)
+    {
+      return psock_poll(&ref->u.sock, (FAR struct pollfd *)ev, setup);
+    }
+#endif
+
+  return file_poll(&ref->u.file, (FAR struct pollfd *)ev, setup);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,21 +236,61 @@
  * Name: epoll_create
  *
  * Description:
+ *   Create an epoll instance.
  *
  * Input Parameters:
+ *   size - The maximum number of descriptors in the interest list
  *
  * Returned Value:
+ *   The epoll descriptor on success; -1 (ERROR) on failure.
  *
  ****************************************************************************/
 
 int epoll_create(int size)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  FAR struct epoll_head *eph;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  eph = (FAR struct epoll_head *)kmm_zalloc(sizeof(struct epoll_head));
+  if (eph == NULL)
+    {
+      set_errno(ENOMEM);
+      return ERROR;
+    }
 
   eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  eph->evs  = (FAR struct epoll_event *)
+    kmm_zalloc(sizeof(struct epoll_event) * eph->size);
+
+  if (eph->evs == NULL)
+    {
+      kmm_free(eph);
+      set_errno(ENOMEM);
+      return ERROR;
+    }
+
+  eph->files = (FAR struct epoll_file_s *)
+    kmm_zalloc(sizeof(struct epoll_file_s) * eph->size);
+
+  if (eph->files == NULL)
+    {
+      kmm_free(eph->evs);
+      kmm_free(eph);
+      set_errno(ENOMEM);
+      return ERROR;
+    }
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&eph->sem, 0, 0);
+  nxsem_setprotocol(&eph->sem, SEM_PRIO_NONE);
 
   /* REVISIT: This will not work on machines where:
    * sizeof(struct epoll_head *) > sizeof(int)
@@ -86,10 +303,14 @@ int epoll_create(int size)
  * Name: epoll_close
  *
  * Description:
+ *   Tear down all of the descriptors in the interest list and release the
+ *   epoll instance.
  *
  * Input Parameters:
+ *   epfd - The epoll descriptor
  *
  * Returned Value:
+ *   None
  *
  ****************************************************************************/
 
@@ -100,7 +321,19 @@ void epoll_close(int epfd)
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->evs[i].sem != NULL)
+        {
+          (void)epoll_setup(eph, &eph->evs[i], false);
+          epoll_release(&eph->files[i]);
+        }
+    }
 
+  nxsem_destroy(&eph->sem);
+  kmm_free(eph->files);
   kmm_free(eph->evs);
   kmm_free(eph);
 }
@@ -109,10 +342,22 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a descriptor in the interest list.  The poll on a
+ *   descriptor is set up here, once, rather than on every epoll_wait().
+ *
+ *   The epoll instance holds its own reference on the open file or socket
+ *   from EPOLL_CTL_ADD until EPOLL_CTL_DEL or epoll_close().  As on Linux,
+ *   closing the descriptor does not remove it from the interest list.
  *
  * Input Parameters:
+ *   epfd - The epoll descriptor
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_DEL or EPOLL_CTL_MOD
+ *   fd   - The descriptor of interest
+ *   ev   - The events of interest, optionally with EPOLLET and/or
+ *          EPOLLONESHOT
  *
  * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
  *
  ****************************************************************************/
 
@@ -123,6 +368,11 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  FAR struct epoll_event *entry;
+  int ret;
+  int i;
+
+  entry = epoll_find(eph, fd);
 
   switch (op)
     {
@@ -130,50 +380,71 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
         finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
               epfd, eph->occupied, fd, ev->events);
 
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+        if (entry != NULL)
+          {
+            return -EEXIST;
+          }
+
+        for (i = 0; i < eph->size && eph->evs[i].sem != NULL; i++);
+        if (i >= eph->size)
+          {
+            return -ENOMEM;
+          }
+
+        ret = epoll_addref(&eph->files[i], fd);
+        if (ret < 0)
+          {
+            return ret;
+          }
+
+        entry          = &eph->evs[i];
+        entry->data.fd = fd;
+        entry->events  = ev->events | EPOLL_ALWAYS;
+
+        ret = epoll_setup(eph, entry, true);
+        if (ret < 0)
+          {
+            epoll_release(&eph->files[i]);
+            entry->sem = NULL;
+            return ret;
+          }
+
+        eph->occupied++;
+        return OK;
 
       case EPOLL_CTL_DEL:
-        {
-          int i;
-
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  if (i != eph->occupied-1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
+        if (entry == NULL)
+          {
+            return -ENOENT;
+          }
 
-          return -ENOENT;
-        }
+        (void)epoll_setup(eph, entry, false);
+        epoll_release(&eph->files[entry - eph->evs]);
+        entry->sem = NULL;
+        eph->occupied--;
+        return OK;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
+              epfd, eph->occupied, fd, ev->events);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+        if (entry == NULL)
+          {
+            return -ENOENT;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
-            }
+        (void)epoll_setup(eph, entry, false);
+        entry->events = ev->events | EPOLL_ALWAYS;
 
-          return -ENOENT;
-        }
+        ret = epoll_setup(eph, entry, true);
+        if (ret < 0)
+          {
+            epoll_release(&eph->files[entry - eph->evs]);
+            entry->sem = NULL;
+            eph->occupied--;
+          }
+
+        return ret;
     }
 
   return -EINVAL;
@@ -183,10 +454,30 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on the descriptors in the interest list.  The drivers
+ *   set revents and post the semaphore of the epoll instance when an event
+ *   occurs, so no driver is called here unless one of its events is
+ *   reported:
+ *
+ *   - A level-triggered descriptor is set up again after it is reported, so
+ *     that it is reported again by the next epoll_wait() if it is still
+ *     ready.
+ *   - An edge-triggered (EPOLLET) descriptor is reported only once for each
+ *     event posted by the driver.
+ *   - A one-shot (EPOLLONESHOT) descriptor is torn down after it is
+ *     reported and is not reported again until it is modified with
+ *     EPOLL_CTL_MOD.
  *
  * Input Parameters:
+ *   epfd      - The epoll descriptor
+ *   evs       - The location to return the events
+ *   maxevents - The maximum number of events to return
+ *   timeout   - The time to wait in milliseconds.  Zero means do not wait;
+ *               a negative value means wait forever.
  *
  * Returned Value:
+ *   The number of events returned, zero on a timeout, or -1 (ERROR) with
+ *   errno set on a failure.
  *
  ****************************************************************************/
 
@@ -198,41 +489,122 @@ int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
    */
 
   FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  FAR struct epoll_event *entry;
+  systime_t start;
+  systime_t ticks = 0;
+  irqstate_t flags;
+  pollevent_t revents;
   int counter;
-  int rc;
+  int ndx;
+  int ret;
   int i;
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  if (maxevents <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
 
-  if (rc <= 0)
+  if (timeout > 0)
     {
-      if (rc < 0)
+      ticks = MSEC2TICK(timeout);
+      if (ticks == 0)
         {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+          ticks = 1;
+        }
+    }
+
+  start = clock_systimer();
 
-          for (i = 0; i < eph->occupied; i++)
+  for (; ; )
+    {
+      /* Discard the count of the semaphore.  The drivers set revents before
+       * they post, so every event posted up to here is seen by the scan
+       * below.  Only the events posted from now on, including those posted
+       * when the level-triggered entries are set up again, are counted.
+       */
+
+      while (nxsem_trywait(&eph->sem) == OK);
+
+      /* Collect the entries with events.  The scan starts where the
+       * previous one stopped so that, when more entries are ready than
+       * maxevents, the entries later in the list are not starved.
+       */
+
+      for (i = 0, counter = 0; i < maxevents && counter < eph->size;
+           counter++)
+        {
+          ndx   = (eph->next + counter) % eph->size;
+          entry = &eph->evs[ndx];
+          if (entry->sem == NULL || entry->revents == 0)
             {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
+              continue;
+            }
+
+          flags          = enter_critical_section();
+          revents        = entry->revents;
+          entry->revents = 0;
+          leave_critical_section(flags);
+
+          evs[i].data.fd = entry->data.fd;
+          evs[i].events  = revents;
+          i++;
+
+          if ((entry->events & EPOLLONESHOT) != 0)
+            {
+              /* Disarm until the descriptor is modified */
+
+              (void)epoll_setup(eph, entry, false);
+              entry->events = 0;
+            }
+          else if ((entry->events & EPOLLET) == 0)
+            {
+              /* Level-triggered:  Set up the poll again.  The driver
+               * reports the event again now if it is still pending.
+               */
+
+              (void)epoll_setup(eph, entry, false);
+              if (epoll_setup(eph, entry, true) < 0)
+                {
+                  entry->events = 0;
+                }
             }
         }
 
-      return rc;
-    }
+      eph->next = (eph->next + counter) % eph->size;
 
-  /* Iterate over non NULL event fds */
+      if (i > 0 || timeout == 0)
+        {
+          return i;
+        }
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
-    {
-      if (eph->evs[counter].revents != 0)
+      /* Wait for a driver to post an event.  The count of the semaphore may
+       * include an event that was already collected above, in which case we
+       * just go around again.
+       */
+
+      if (timeout > 0)
         {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
+          ret = nxsem_tickwait(&eph->sem, start, ticks);
+          if (ret == -ETIMEDOUT)
+            {
+              return 0;
+            }
         }
-    }
+      else
+        {
+          ret = nxsem_wait(&eph->sem);
+        }
+
+      if (ret < 0)
+        {
+          ferr("ERROR: %08x wait fail: %d for %d, %d msecs\n",
+               epfd, ret, eph->occupied, timeout);
 
-  return i;
+          set_errno(-ret);
+          return ERROR;
+        }
+    }
 }
 
 #endif /* CONFIG_DISABLE_POLL */
@@ -46,6 +46,7 @@
 #include <assert.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
 
@@ -79,6 +80,15 @@ off_t file_seek(FAR struct file *filep, off_t offset, int whence)
   DEBUGASSERT(filep);
   inode =  filep->f_inode;
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* The page cache defers repositioning of the driver */
+
+  if (filep->f_pgfile != NULL)
+    {
+      return pgcache_seek(filep, offset, whence);
+    }
+#endif
+
   /* Invoke the file seek method if available */
 
   if (inode && inode->u.i_ops && inode->u.i_ops->seek)
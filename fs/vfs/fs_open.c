@@ -55,6 +55,7 @@
 
 #include "inode/inode.h"
 #include "driver/driver.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Public Functions
@@ -250,6 +251,15 @@ int open(const char *path, int oflags, ...)
       goto errout_with_fd;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Attach files of page cached file systems to the page cache */
+
+  if (INODE_IS_MOUNTPT(inode) && (inode->i_flags & FSNODEFLAG_PGCACHE) != 0)
+    {
+      pgcache_open(filep, desc.relpath);
+    }
+#endif
+
 #ifdef CONFIG_PSEUDOTERM_SUSV1
   /* If the return value from the open method is > 0, then it may actually
    * be an encoded file descriptor.  This kind of logic is currently only
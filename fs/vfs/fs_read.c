@@ -51,6 +51,7 @@
 #include <nuttx/net/net.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Public Functions
@@ -96,6 +97,15 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
       ret = -EACCES;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* Is the file held in the page cache? */
+
+  else if (filep->f_pgfile != NULL)
+    {
+      ret = (int)pgcache_read(filep, (FAR char *)buf, nbytes);
+    }
+#endif
+
   /* Is a driver or mountpoint registered? If so, does it support the read
    * method?
    */
@@ -49,6 +49,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -467,6 +468,18 @@ next_subdir:
        */
 
       ret = oldinode->u.i_mops->rename(oldinode, oldrelpath, newrelpath);
+
+#ifdef CONFIG_FS_PAGECACHE
+      /* Neither path refers to the previously cached data any longer.  If
+       * a directory was renamed, neither do the paths of the files below it.
+       */
+
+      if ((oldinode->i_flags & FSNODEFLAG_PGCACHE) != 0)
+        {
+          pgcache_forget(oldinode, oldrelpath);
+          pgcache_forget(oldinode, newrelpath);
+        }
+#endif
     }
 
 errout_with_newinode:
@@ -47,6 +47,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -126,6 +127,15 @@ int rmdir(FAR const char *pathname)
               errcode = -ret;
               goto errout_with_inode;
             }
+
+#ifdef CONFIG_FS_PAGECACHE
+          /* No file below the directory is cached any longer */
+
+          if ((inode->i_flags & FSNODEFLAG_PGCACHE) != 0)
+            {
+              pgcache_forget(inode, desc.relpath);
+            }
+#endif
         }
       else
         {
@@ -48,6 +48,7 @@
 #include <assert.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 
 #if CONFIG_NFILE_DESCRIPTORS > 0 && CONFIG_NET_SENDFILE
@@ -125,21 +126,25 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
           return ERROR;
         }
 
-      DEBUGASSERT(filep != NULL);
+      DEBUGASSERT(filep != NULL && filep->f_inode != NULL);
 
-      /* Then let net_sendfile do the work. */
+      /* Then let net_sendfile do the work.  Data from a pipe or other
+       * character driver cannot be re-read at an offset for retransmission,
+       * so that is streamed to the socket by lib_sendfile() instead.
+       */
 
-      return net_sendfile(outfd, filep, offset, count);
+      if (!INODE_IS_DRIVER(filep->f_inode))
+        {
+          return net_sendfile(outfd, filep, offset, count);
+        }
     }
-  else
 #endif
-    {
-      /* No... then this is probably a file-to-file transfer.  The generic
-       * lib_sendfile() can handle that case.
-       */
 
-      return lib_sendfile(outfd, infd, offset, count);
-    }
+  /* No... then this is probably a file-to-file transfer or a transfer from
+   * a driver.  The generic lib_sendfile() can handle those cases.
+   */
+
+  return lib_sendfile(outfd, infd, offset, count);
 }
 
 #endif /* CONFIG_NFILE_DESCRIPTORS > 0 && CONFIG_NET_SENDFILE */
@@ -47,6 +47,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 
@@ -108,6 +109,28 @@ int file_truncate(FAR struct file *filep, off_t length)
       return -ENOSYS;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* If the file is page cached, bring the driver to the file position
+   * first and drop the cached pages that the truncation makes stale.  The
+   * pages are dropped even on a failure, which may have left the file
+   * partly truncated.
+   */
+
+  if (filep->f_pgfile != NULL)
+    {
+      int ret;
+
+      ret = pgcache_sync(filep);
+      if (ret >= 0)
+        {
+          ret = inode->u.i_mops->truncate(filep, length);
+          pgcache_truncated(filep, length);
+        }
+
+      return ret;
+    }
+#endif
+
   /* Yes, then tell the file system to truncate this file */
 
   return inode->u.i_mops->truncate(filep, length);
@@ -47,6 +47,7 @@
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -125,6 +126,15 @@ int unlink(FAR const char *pathname)
               errcode = -ret;
               goto errout_with_inode;
             }
+
+#ifdef CONFIG_FS_PAGECACHE
+          /* The cached data no longer belongs to this path */
+
+          if ((inode->i_flags & FSNODEFLAG_PGCACHE) != 0)
+            {
+              pgcache_forget(inode, desc.relpath);
+            }
+#endif
         }
       else
         {
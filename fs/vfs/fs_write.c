@@ -55,6 +55,7 @@
 #include <nuttx/net/net.h>
 
 #include "inode/inode.h"
+#include "pgcache/pgcache.h"
 
 /****************************************************************************
  * Public Functions
@@ -105,6 +106,26 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
       return -EBADF;
     }
 
+#ifdef CONFIG_FS_PAGECACHE
+  /* If the file is page cached, bring the driver to the file position
+   * first and drop the cached pages that the write makes stale.
+   */
+
+  if (filep->f_pgfile != NULL)
+    {
+      ssize_t ret;
+
+      ret = pgcache_sync(filep);
+      if (ret >= 0)
+        {
+          ret = inode->u.i_ops->write(filep, buf, nbytes);
+          pgcache_written(filep, ret);
+        }
+
+      return ret;
+    }
+#endif
+
   /* Yes, then let the driver perform the write */
 
   return inode->u.i_ops->write(filep, buf, nbytes);
@@ -75,6 +75,28 @@ uint32_t crc32part(FAR const uint8_t *src, size_t len, uint32_t crc32val);
 
 uint32_t crc32(FAR const uint8_t *src, size_t len);
 
+/****************************************************************************
+ * Name: crc32cpart
+ *
+ * Description:
+ *   Continue CRC-32C (Castagnoli) calculation on a part of the buffer.  No
+ *   inversion is performed on the CRC value.
+ *
+ ****************************************************************************/
+
+uint32_t crc32cpart(FAR const uint8_t *src, size_t len, uint32_t crc32val);
+
+/****************************************************************************
+ * Name: crc32c
+ *
+ * Description:
+ *   Return the standard CRC-32C (initialized to all ones and inverted on
+ *   completion) of the contents of the 'src' buffer, length 'len'.
+ *
+ ****************************************************************************/
+
+uint32_t crc32c(FAR const uint8_t *src, size_t len);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -69,4 +69,15 @@
 #define TCP_KEEPCNT   (__SO_PROTOCOL + 3) /* Number of keepalives before death
                                            * Argument: max retry count */
 
+/* TCP protocol socket option to select the congestion control algorithm */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 4) /* Congestion control algorithm
+                                            * Argument: name string */
+#define TCP_CA_NAME_MAX 16                 /* Max size of the name string */
+
+/* TCP protocol socket option to hold back partial segments */
+
+#define TCP_CORK      (__SO_PROTOCOL + 5) /* Only send full segments
+                                           * Argument: int (boolean) */
+
 #endif /* __INCLUDE_NETINET_TCP_H */
@@ -0,0 +1,254 @@
+/****************************************************************************
+ * include/nuttx/drivers/blkcache.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H
+#define __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <queue.h>
+
+#ifdef CONFIG_DRVR_BLKCACHE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One cached sector */
+
+struct blkcache_entry_s
+{
+  dq_entry_t    node;            /* LRU list linkage.  Must be first */
+  size_t        sector;          /* The sector held in data[] */
+  bool          valid;           /* true: data[] holds the sector */
+  bool          dirty;           /* true: data[] must be written back */
+  FAR uint8_t  *data;            /* The sector data */
+};
+
+/* This structure holds the state of a multi-sector LRU cache layered over
+ * a block driver.  In typical usage, an instance of this structure is
+ * declared within the state structure of the block driver user (a file
+ * system mountpoint or the BCH layer) like:
+ *
+ * struct foo_s
+ * {
+ *   ...
+ *   struct blkcache_s cache;
+ *   ...
+ * };
+ *
+ * The user provides the configuration fields and calls
+ * blkcache_initialize().  All I/O to the block driver is then performed
+ * with blkcache_read() and blkcache_write().  Single sector transfers are
+ * served from the cache; dirty sectors are written back when they are
+ * evicted or when blkcache_flush() is called.  Multi-sector transfers go
+ * directly to the block driver and are kept coherent with the cache.
+ *
+ * The cache does no locking of its own.  The user must provide mutual
+ * exclusion.
+ */
+
+struct blkcache_s
+{
+  /********************************************************************/
+  /* These values must be provided by the user prior to calling
+   * blkcache_initialize()
+   */
+
+  FAR struct inode *inode;       /* The block driver */
+  uint32_t      sectsize;        /* The size of one sector */
+  size_t        nsectors;        /* The number of sectors on the device */
+  uint16_t      nentries;        /* The number of sectors to cache */
+  uint16_t      nreadahead;      /* Sectors read ahead on sequential misses */
+
+  /********************************************************************/
+  /* The user should never modify any of the remaining fields */
+
+  FAR struct blkcache_s *flink;  /* Supports a list of all caches */
+  FAR struct blkcache_entry_s *entries; /* The cache entries */
+  FAR uint8_t  *buffer;          /* Sector data of all entries */
+  FAR uint8_t  *rabuffer;        /* Read-ahead transfer buffer */
+  dq_queue_t    lru;             /* Entries, most recently used first */
+  size_t        nextsector;      /* Sector that continues sequential access */
+
+  /* Statistics */
+
+  uint32_t      nhits;           /* Single sector accesses found in cache */
+  uint32_t      nmisses;         /* Single sector accesses not in cache */
+  uint32_t      nprefetch;       /* Sectors read ahead */
+  uint32_t      nwriteback;      /* Dirty sectors written back */
+};
+
+/* A snapshot of one cache as returned by blkcache_info().  The name is
+ * copied because the driver inode may be released once the snapshot has
+ * been taken.
+ */
+
+struct blkcacheinfo_s
+{
+  char          name[NAME_MAX + 1]; /* Name of the block driver */
+  uint32_t      sectsize;        /* The size of one sector */
+  uint16_t      nentries;        /* The number of sectors cached */
+  uint16_t      ndirty;          /* The number of dirty sectors */
+  uint32_t      nhits;           /* Single sector accesses found in cache */
+  uint32_t      nmisses;         /* Single sector accesses not in cache */
+  uint32_t      nprefetch;       /* Sectors read ahead */
+  uint32_t      nwriteback;      /* Dirty sectors written back */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: blkcache_initialize
+ *
+ * Description:
+ *   Allocate the cache buffers and make the cache visible in
+ *   /proc/fs/blkcache.  The configuration fields of the cache structure
+ *   must have been set up by the caller.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int blkcache_initialize(FAR struct blkcache_s *cache);
+
+/****************************************************************************
+ * Name: blkcache_uninitialize
+ *
+ * Description:
+ *   Write back all dirty sectors and release the cache.  The cache is
+ *   released even if the write back fails.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the write back failed.
+ *
+ ****************************************************************************/
+
+int blkcache_uninitialize(FAR struct blkcache_s *cache);
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:
+ *   Read 'nsectors' sectors beginning at 'start' into 'buffer'.
+ *
+ * Returned Value:
+ *   The number of sectors read or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_read(FAR struct blkcache_s *cache, FAR uint8_t *buffer,
+                      size_t start, unsigned int nsectors);
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description:
+ *   Write 'nsectors' sectors beginning at 'start' from 'buffer'.  A single
+ *   sector is only written to the cache; larger transfers are written to
+ *   the media immediately.
+ *
+ * Returned Value:
+ *   The number of sectors written or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_write(FAR struct blkcache_s *cache,
+                       FAR const uint8_t *buffer, size_t start,
+                       unsigned int nsectors);
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   Write all dirty sectors back to the media.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int blkcache_flush(FAR struct blkcache_s *cache);
+
+/****************************************************************************
+ * Name: blkcache_discard
+ *
+ * Description:
+ *   Invalidate all cached sectors without writing back the dirty ones.
+ *
+ ****************************************************************************/
+
+void blkcache_discard(FAR struct blkcache_s *cache);
+
+/****************************************************************************
+ * Name: blkcache_info
+ *
+ * Description:
+ *   Return a snapshot of the 'ndx'th cache.  This is used by procfs to
+ *   enumerate all caches.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such cache.
+ *
+ ****************************************************************************/
+
+int blkcache_info(int ndx, FAR struct blkcacheinfo_s *info);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_DRVR_BLKCACHE */
+#endif /* __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H */
@@ -107,6 +107,7 @@
  *
  *   Bit 0-3: Inode type (Bit 4 indicates internal OS types)
  *   Bit 4:   Set if inode has been unlinked and is pending removal.
+ *   Bit 5:   Set if file data of a mountpoint may be held in the page cache.
  */
 
 #define FSNODEFLAG_TYPE_MASK       0x00000007 /* Isolates type field        */
@@ -119,6 +120,7 @@
 #define   FSNODEFLAG_TYPE_SHM      0x00000006 /*   Shared memory region     */
 #define   FSNODEFLAG_TYPE_SOFTLINK 0x00000007 /*   Soft link                */
 #define FSNODEFLAG_DELETED         0x00000008 /* Unlinked                   */
+#define FSNODEFLAG_PGCACHE         0x00000010 /* Mountpoint is page cached  */
 
 #define INODE_IS_TYPE(i,t) \
   (((i)->i_flags & FSNODEFLAG_TYPE_MASK) == (t))
@@ -394,12 +396,20 @@ struct inode
  * the file descriptor to the file state and to a set of inode operations.
  */
 
+#ifdef CONFIG_FS_PAGECACHE
+struct pgcache_file_s;          /* Forward reference */
+#endif
+
 struct file
 {
   int               f_oflags;   /* Open mode flags */
   off_t             f_pos;      /* File position */
   FAR struct inode *f_inode;    /* Driver or file system interface */
   void             *f_priv;     /* Per file driver private data */
+#ifdef CONFIG_FS_PAGECACHE
+  FAR struct pgcache_file_s *f_pgfile; /* Page cache identity of the file */
+  off_t             f_drvpos;   /* File position as last seen by the driver */
+#endif
 };
 
 /* This defines a list of files indexed by the file descriptor */
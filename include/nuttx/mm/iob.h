@@ -183,6 +183,30 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers that could be allocated now without
+ *   waiting.
+ *
+ ****************************************************************************/
+
+int iob_navail(bool throttled);
+
+/****************************************************************************
+ * Name: iob_qentry_navail
+ *
+ * Description:
+ *   Return the number of I/O buffer chain containers that could be
+ *   allocated now without waiting.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_NCHAINS > 0
+int iob_qentry_navail(void);
+#endif
+
 /****************************************************************************
  * Name: iob_free
  *
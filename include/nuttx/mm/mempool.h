@@ -0,0 +1,213 @@
+/****************************************************************************
+ * include/nuttx/mm/mempool.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _INCLUDE_NUTTX_MM_MEMPOOL_H
+#define _INCLUDE_NUTTX_MM_MEMPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <semaphore.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Describes one pool of fixed size blocks.  The caller provides the
+ * configuration fields (name through wait) and then calls
+ * mempool_initialize().  The remaining fields are private to the mempool
+ * logic.
+ *
+ * While a block is free, its first pointer-sized word is used to link it
+ * into the pool's free list.  While the block is allocated, the pool does
+ * not touch it.
+ */
+
+struct mempool_s
+{
+  /* Configuration */
+
+  FAR const char *name;          /* Name reported by /proc/mempool */
+  size_t bsize;                  /* Size of one block in bytes */
+  uint16_t nreserve;             /* Blocks withheld from throttled callers */
+  uint16_t nexpand;              /* Blocks added per heap expansion, or 0 */
+  CODE int (*wait)(FAR sem_t *sem); /* Wait function.  NULL: nxsem_wait() */
+
+  /* Internal state (protected by enter_critical_section()) */
+
+  FAR struct mempool_s *flink;   /* Supports a list of all pools */
+  FAR sq_entry_t *freelist;      /* List of free blocks */
+  sem_t waitsem;                 /* Un-throttled callers wait here */
+  sem_t throttlesem;             /* Throttled callers wait here */
+  uint16_t nwaiting;             /* Number of waiters on waitsem */
+  uint16_t nthrottled;           /* Number of waiters on throttlesem */
+  uint16_t ntotal;               /* Total number of blocks in the pool */
+  uint16_t nfree;                /* Number of blocks in the free list */
+  uint16_t peak;                 /* Largest number of blocks ever in use */
+
+  /* Statistics */
+
+  uint32_t nalloc;               /* Number of successful allocations */
+  uint32_t nfail;                /* Number of failed allocations */
+  uint32_t nwait;                /* Number of times a caller had to wait */
+  uint16_t nexpanded;            /* Number of heap expansions */
+};
+
+/* A snapshot of one pool as returned by mempool_info() */
+
+struct mempoolinfo_s
+{
+  FAR const char *name;          /* Name of the pool */
+  size_t bsize;                  /* Size of one block in bytes */
+  uint16_t ntotal;               /* Total number of blocks in the pool */
+  uint16_t nfree;                /* Number of free blocks */
+  uint16_t peak;                 /* Largest number of blocks ever in use */
+  uint16_t nreserve;             /* Blocks withheld from throttled callers */
+  uint16_t nwaiting;             /* Number of callers waiting now */
+  uint16_t nexpanded;            /* Number of heap expansions */
+  uint32_t nalloc;               /* Number of successful allocations */
+  uint32_t nfail;                /* Number of failed allocations */
+  uint32_t nwait;                /* Number of times a caller had to wait */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a pool of fixed size blocks and register it so that it is
+ *   visible in /proc/mempool.  The configuration fields of the pool
+ *   structure must be set before calling this function.
+ *
+ * Input Parameters:
+ *   pool    - The pool to be initialized
+ *   storage - Memory for the initial blocks, at least nblocks * pool->bsize
+ *             bytes.  If NULL, the initial blocks are taken from the kernel
+ *             heap.
+ *   nblocks - The number of initial blocks
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int mempool_initialize(FAR struct mempool_s *pool, FAR void *storage,
+                       unsigned int nblocks);
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate a block, waiting for one to be freed if the pool is exhausted
+ *   and cannot be expanded.  If called from an interrupt handler or from
+ *   the IDLE thread, this behaves like mempool_tryalloc().
+ *
+ *   Throttled allocations may not take the last pool->nreserve blocks.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool, bool throttled);
+
+/****************************************************************************
+ * Name: mempool_tryalloc
+ *
+ * Description:
+ *   Allocate a block without waiting.  This may be called from an
+ *   interrupt handler.  Returns NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_tryalloc(FAR struct mempool_s *pool, bool throttled);
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the pool, waking up one waiter if there is any that
+ *   can use it.  This may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_navail
+ *
+ * Description:
+ *   Return the number of blocks that an allocation could take now without
+ *   waiting or expanding the pool.
+ *
+ ****************************************************************************/
+
+int mempool_navail(FAR struct mempool_s *pool, bool throttled);
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return a snapshot of the ndx'th registered pool.  This is used by
+ *   procfs to enumerate the pools.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no pool with that index.
+ *
+ ****************************************************************************/
+
+int mempool_info(int ndx, FAR struct mempoolinfo_s *info);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INCLUDE_NUTTX_MM_MEMPOOL_H */
@@ -159,7 +159,33 @@
 
 #define MM_MIN_CHUNK     (1 << MM_MIN_SHIFT)
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
-#define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+
+#ifdef CONFIG_MM_TLSF
+/* Two-level segregated fit (TLSF) free lists:
+ *
+ * MM_SL_SHIFT - log2 of the number of second-level lists per first-level
+ *   list.  Each power-of-two size range is split into MM_NSL linear
+ *   sub-ranges.
+ * MM_FL_SHIFT - Chunks smaller than (1 << MM_FL_SHIFT) all live in first-
+ *   level list 0 where each second-level list holds exactly one granule
+ *   size.
+ * MM_NFL - The number of first-level lists.  The final first-level list
+ *   holds only the chunks of size MM_MAX_CHUNK or larger.
+ *
+ * The free list heads are indexed as (fl << MM_SL_SHIFT) + sl.  A bit is
+ * set in mm_flbitmap for each non-empty first-level list and in
+ * mm_slbitmap[fl] for each non-empty second-level list so that a suitable
+ * free chunk can be found in constant time.
+ */
+
+#  define MM_SL_SHIFT    CONFIG_MM_TLSF_SLBITS
+#  define MM_NSL         (1 << MM_SL_SHIFT)
+#  define MM_FL_SHIFT    (MM_MIN_SHIFT + MM_SL_SHIFT)
+#  define MM_NFL         (MM_MAX_SHIFT - MM_FL_SHIFT + 2)
+#  define MM_NNODES      (MM_NFL << MM_SL_SHIFT)
+#else
+#  define MM_NNODES      (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+#endif
 
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
@@ -256,13 +282,46 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* Free nodes are maintained in segregated, doubly linked lists.  The
+   * bitmaps record which of the lists are non-empty.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_NFL];
+  FAR struct mm_freenode_s *mm_freelist[MM_NNODES];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
+};
+
+#ifdef CONFIG_MM_UMM_CACHE
+/* Statistics for one size class of the user heap cache */
+
+struct mcacheinfo_s
+{
+  size_t chunksize;        /* Chunk size of the class (including header) */
+  unsigned int ncached;    /* Number of chunks currently in the magazines */
+  unsigned long hits;      /* Allocations satisfied from a magazine */
+  unsigned long misses;    /* Allocations that required a refill */
+  unsigned long frees;     /* Frees returned to a magazine */
+  unsigned long drains;    /* Frees that required a drain */
 };
+#endif
+
+#ifdef CONFIG_MM_RECLAIM
+/* A reclaim handler releases up to 'size' bytes of cached heap memory and
+ * returns the number of bytes actually released.  It must not wait for any
+ * lock that may be held while the cache allocates from the heap.
+ */
+
+typedef CODE size_t (*mm_reclaim_t)(size_t size);
+#endif
 
 /****************************************************************************
  * Public Data
@@ -368,6 +427,22 @@ void kmm_givesemaphore(void);
 
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
 
+/* Functions contained in mm_reclaim.c *************************************/
+
+#ifdef CONFIG_MM_RECLAIM
+int mm_addreclaim(FAR struct mm_heap_s *heap, mm_reclaim_t handler);
+size_t mm_reclaim(FAR struct mm_heap_s *heap, size_t size);
+#endif
+
+/* Functions contained in umm_mcache.c *************************************/
+
+#ifdef CONFIG_MM_UMM_CACHE
+FAR void *umm_mcache_alloc(size_t size);
+bool umm_mcache_free(FAR void *mem);
+void umm_mcache_initialize(void);
+int umm_mcacheinfo(int ndx, FAR struct mcacheinfo_s *info);
+#endif
+
 /* Functions contained in kmm_malloc.c **************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -505,6 +580,16 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c *********************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c ********************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
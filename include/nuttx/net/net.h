@@ -933,6 +933,111 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends the data gathered from the msg_iov array of
+ *   'msg'.  A stream socket sends each vector in turn; a datagram socket
+ *   sends all vectors as a single datagram.  This is an internal OS
+ *   interface that is functionally equivalent to sendmsg() except that it
+ *   is not a cancellation point and it does not modify the errno variable.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (See comments with sendto() for a list
+ *   of the appropriate errno value).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives data into the msg_iov array of 'msg'.  A
+ *   stream socket fills the vectors in turn while data is available; a
+ *   datagram socket scatters one datagram across the vectors.  This is an
+ *   internal OS interface that is functionally equivalent to recvmsg()
+ *   except that it is not a cancellation point and it does not modify the
+ *   errno variable.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Message to receive into
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, a negated errno value is returned (see comments with
+ *   recvfrom() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Loan the next unit of buffered receive data (TCP read-ahead data or one
+ *   UDP datagram) to the caller as an I/O buffer chain without copying it.
+ *   The caller must release the chain with iob_free_chain().  This never
+ *   waits; use poll() to wait for POLLIN.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iob     - Location to return the loaned I/O buffer chain
+ *   from    - Address of source (may be NULL).  Only used for UDP.
+ *   fromlen - The length of the address structure
+ *
+ * Returned Value:
+ *   The number of bytes in the loaned chain on success; zero at TCP end of
+ *   file; a negated errno value on failure (-EAGAIN if nothing is
+ *   buffered).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_LOAN
+struct iob_s; /* Forward reference */
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      FAR struct sockaddr *from, FAR socklen_t *fromlen);
+#endif
+
+/****************************************************************************
+ * Name: psock_sendiob
+ *
+ * Description:
+ *   Send a caller-provided I/O buffer chain on a TCP or UDP socket without
+ *   copying it.  On success the network owns the chain.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   iob   - The I/O buffer chain to send
+ *   to    - Address of recipient (UDP only, may be NULL if connected)
+ *   tolen - The length of the address structure
+ *
+ * Returned Value:
+ *   The number of bytes queued on success; a negated errno value on
+ *   failure, in which case the caller still owns the chain.  -ENOMEM is
+ *   returned if no write buffer is free; this function does not wait for
+ *   one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_LOAN
+ssize_t psock_sendiob(FAR struct socket *psock, FAR struct iob_s *iob,
+                      FAR const struct sockaddr *to, socklen_t tolen);
+#endif
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
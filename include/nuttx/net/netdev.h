@@ -63,6 +63,15 @@
 #  include <nuttx/net/igmp.h>
 #endif
 
+#ifdef CONFIG_NETDEV_IOB
+#  include <nuttx/mm/iob.h>
+#endif
+
+#ifdef CONFIG_NETDEV_NAPI
+#  include <stdbool.h>
+#  include <nuttx/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -87,6 +96,13 @@
 #  define RADIO_MAX_ADDRLEN CONFIG_PKTRADIO_ADDRLEN
 #endif
 
+/* Number of buckets in the RX batch size histogram.  Bucket 0 counts polls
+ * that found no frame; bucket n counts polls that received 2^(n-1) up to
+ * 2^n - 1 frames, with the last bucket holding all larger batches.
+ */
+
+#define NETDEV_NBATCH 7
+
 /* Helper macros for network device statistics */
 
 #ifdef CONFIG_NETDEV_STATISTICS
@@ -174,6 +190,9 @@ struct netdev_statistics_s
   uint32_t rx_arp;         /* Number of Rx ARP packets received */
 #endif
   uint32_t rx_dropped;     /* Unsupported Rx packets received */
+#ifdef CONFIG_NETDEV_NAPI
+  uint32_t rx_batch[NETDEV_NBATCH]; /* Histogram of Rx batch sizes */
+#endif
 
   /* Tx Status */
 
@@ -243,8 +262,12 @@ struct net_driver_s
   uint8_t d_llhdrlen;           /* Link layer header size */
   uint16_t d_mtu;               /* Maximum packet size */
 #ifdef CONFIG_NET_TCP
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t d_recvwndo;          /* TCP receive window size */
+#else
   uint16_t d_recvwndo;          /* TCP receive window size */
 #endif
+#endif
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_NET_6LOWPAN) || \
     defined(CONFIG_NET_BLUETOOTH) || defined(CONFIG_NET_IEEE802154)
@@ -296,6 +319,17 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NETDEV_IOB
+  /* If CONFIG_NETDEV_IOB is enabled, the driver may back d_buf with an I/O
+   * buffer instead of a static array.  d_iob is the I/O buffer that
+   * currently provides d_buf (or NULL).  Completed frames can then be
+   * detached and queued to hardware without copying; see
+   * netdev_iob_prepare(), netdev_iob_release() and netdev_iob_replace().
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -395,6 +429,37 @@ struct net_driver_s
 
 typedef int (*devif_poll_callback_t)(FAR struct net_driver_s *dev);
 
+#ifdef CONFIG_NETDEV_NAPI
+/* Batched (NAPI-style) receive.  The driver's RX interrupt handler masks
+ * further RX interrupts and calls netdev_napi_schedule().  The network is
+ * then locked once per batch and the driver's poll method receives up to
+ * CONFIG_NETDEV_NAPI_BUDGET frames.  While batches fill the budget, the
+ * device stays in poll mode; once a batch comes up short, RX interrupts
+ * are unmasked again.
+ *
+ * nn_poll  - Receive and dispatch up to 'budget' frames.  Returns the
+ *            number of frames received.  Called with the network locked.
+ * nn_rxint - Mask (false) or unmask (true) the RX interrupt.  Unmasking
+ *            must raise the interrupt if frames are already pending.  May
+ *            be called from the interrupt handler.
+ */
+
+typedef CODE int (*netdev_napi_poll_t)(FAR struct net_driver_s *dev,
+                                       int budget);
+typedef CODE void (*netdev_napi_rxint_t)(FAR struct net_driver_s *dev,
+                                         bool enable);
+
+struct netdev_napi_s
+{
+  struct work_s nn_work;           /* Deferred poll work */
+  FAR struct net_driver_s *nn_dev; /* The device that is polled */
+  netdev_napi_poll_t nn_poll;      /* Driver receive method */
+  netdev_napi_rxint_t nn_rxint;    /* Driver RX interrupt control */
+  int nn_qid;                      /* Work queue used for polling */
+  volatile bool nn_sched;          /* Poll pending; RX interrupt masked */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -581,6 +646,146 @@ void neighbor_out(FAR struct net_driver_s *dev);
 int netdev_carrier_on(FAR struct net_driver_s *dev);
 int netdev_carrier_off(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device has an I/O buffer attached and point d_buf
+ *   at its data.  This should be called before devif_poll() or before a
+ *   received frame is written into d_buf.  An I/O buffer that is already
+ *   attached is reused.
+ *
+ * Input Parameters:
+ *   dev       - The device driver structure
+ *   throttled - An indication of the I/O buffer allocation throttle
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM is returned if no I/O buffer
+ *   is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Detach the I/O buffer holding the d_len byte frame in d_buf from the
+ *   device.  The caller becomes the owner of the returned I/O buffer and
+ *   must call netdev_iob_prepare() again before d_buf is next used.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *
+ * Returned Value:
+ *   The detached I/O buffer or NULL if none was attached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+FAR struct iob_s *netdev_iob_release(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_replace
+ *
+ * Description:
+ *   Attach a received frame held in an I/O buffer chain to the device so
+ *   that it can be passed to the network via ipv4_input() and friends.
+ *   Any I/O buffer that was previously attached is freed.  A frame in a
+ *   single I/O buffer is attached without copying; a chain is first packed
+ *   into its head buffer.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *   iob - The received frame
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the frame is empty or cannot be held in
+ *   a single I/O buffer.  On failure, the caller still owns iob.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+int netdev_iob_replace(FAR struct net_driver_s *dev, FAR struct iob_s *iob);
+#endif
+
+/****************************************************************************
+ * Name: netdev_napi_initialize
+ *
+ * Description:
+ *   Initialize the batched receive state of a device.
+ *
+ * Input Parameters:
+ *   napi  - The batched receive state to initialize
+ *   dev   - The device driver structure
+ *   qid   - The work queue on which frames are received (HPWORK or LPWORK)
+ *   poll  - The driver receive method
+ *   rxint - The driver RX interrupt control method
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_initialize(FAR struct netdev_napi_s *napi,
+                            FAR struct net_driver_s *dev, int qid,
+                            netdev_napi_poll_t poll,
+                            netdev_napi_rxint_t rxint);
+#endif
+
+/****************************************************************************
+ * Name: netdev_napi_schedule
+ *
+ * Description:
+ *   Switch the device to poll mode: mask the RX interrupt and schedule a
+ *   receive poll on the work queue.  Nothing is done if a poll is already
+ *   pending.  This is normally called from the RX interrupt handler.
+ *
+ * Input Parameters:
+ *   napi - The batched receive state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_schedule(FAR struct netdev_napi_s *napi);
+#endif
+
+/****************************************************************************
+ * Name: netdev_napi_cancel
+ *
+ * Description:
+ *   Cancel any pending receive poll, e.g. when the interface is brought
+ *   down.  The RX interrupt is left masked.
+ *
+ * Input Parameters:
+ *   napi - The batched receive state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_cancel(FAR struct netdev_napi_s *napi);
+#endif
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -93,7 +93,9 @@
 #define wd_static(w) \
   do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
 
-#ifdef CONFIG_PIC
+#if defined(CONFIG_WDOG_TIMERWHEEL) && defined(CONFIG_PIC)
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_WDOG_TIMERWHEEL) || defined(CONFIG_PIC)
 #  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
 #  define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -136,13 +138,23 @@ typedef CODE void (*wdentry_t)(int argc, wdparm_t arg1, ...);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  FAR struct wdog_s *prev;       /* Support for doubly linked wheel slots */
+#endif
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint32_t           expire;     /* Clock tick at which the delay expires */
+#else
   int                lag;        /* Timer associated with the delay */
+#endif
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint8_t            slot;       /* Wheel slot holding the active watchdog */
+#endif
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
 };
 
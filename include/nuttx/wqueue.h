@@ -296,6 +296,24 @@ struct work_s
   systime_t delay;       /* Delay until work performed */
 };
 
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_WORKQUEUE_EVENT)
+/* This structure is used to return the state and statistics of one kernel
+ * work queue (see work_info()).
+ */
+
+struct work_info_s
+{
+  FAR const char *name;  /* Name of the work queue */
+  uint8_t  nthreads;     /* Number of worker threads */
+  uint16_t nready;       /* Number of work items ready to run */
+  uint16_t ndelayed;     /* Number of delayed work items */
+  uint32_t nrun;         /* Number of work items run */
+  uint32_t nwakeups;     /* Number of worker thread wake-ups */
+  uint32_t latmax;       /* Maximum queuing latency (microseconds) */
+  uint32_t latavg;       /* Average queuing latency (microseconds) */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -420,6 +438,28 @@ int work_signal(int qid);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_info
+ *
+ * Description:
+ *   Return the state and statistics of a kernel work queue.  The queuing
+ *   latency is the time from when the work becomes ready to run (it is
+ *   queued without delay or its delay expires) until a worker thread starts
+ *   it.
+ *
+ * Input Parameters:
+ *   qid  - The work queue ID (HPWORK or LPWORK)
+ *   info - The location to return the information
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the work queue does not exist.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_WORKQUEUE_EVENT)
+int work_info(int qid, FAR struct work_info_s *info);
+#endif
+
 /****************************************************************************
  * Name: lpwork_boostpriority
  *
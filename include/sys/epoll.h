@@ -74,6 +74,10 @@ enum EPOLL_EVENTS
 #define EPOLLERR EPOLLERR
     EPOLLHUP = POLLHUP,
 #define EPOLLHUP EPOLLHUP
+    EPOLLONESHOT = 0x40,
+#define EPOLLONESHOT EPOLLONESHOT
+    EPOLLET = 0x80,
+#define EPOLLET EPOLLET
   };
 
 typedef union poll_data
@@ -90,11 +94,23 @@ struct epoll_event
   FAR void    *priv;     /* For use by drivers */
 };
 
+/* The interest list.  Each descriptor is set up for polling once, when it
+ * is added with epoll_ctl(), and stays set up until it is removed.  An
+ * entry in evs[] is unused if its sem field is NULL.  The epoll instance
+ * holds its own reference on the open file or socket of each entry in
+ * files[] so that the entry remains valid if the descriptor is closed.
+ */
+
+struct epoll_file_s;
+
 struct epoll_head
 {
-  int size;
-  int occupied;
-  FAR struct epoll_event *evs;
+  int size;                       /* Size of the interest list */
+  int occupied;                   /* Number of descriptors in the list */
+  int next;                       /* Where the next scan for events starts */
+  sem_t sem;                      /* Posted by the drivers on any event */
+  FAR struct epoll_event *evs;    /* The interest list */
+  FAR struct epoll_file_s *files; /* References held on each entry */
 };
 
 /****************************************************************************
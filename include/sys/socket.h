@@ -42,6 +42,7 @@
  ****************************************************************************/
 
 #include <sys/types.h>
+#include <sys/uio.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -217,6 +218,22 @@ struct linger
   int  l_linger;  /* Linger time, in seconds. */
 };
 
+/* The msghdr structure is used by recvmsg() and sendmsg() to describe a
+ * scattered receive buffer or a gathered send buffer.  Ancillary data is
+ * not supported:  msg_controllen is always returned as zero.
+ */
+
+struct msghdr
+{
+  FAR void *msg_name;          /* Optional address */
+  socklen_t msg_namelen;       /* Size of address */
+  FAR struct iovec *msg_iov;   /* Scatter/gather array */
+  int msg_iovlen;              /* Members in msg_iov */
+  FAR void *msg_control;       /* Ancillary data (unused) */
+  socklen_t msg_controllen;    /* Ancillary data buffer len */
+  int msg_flags;               /* Flags on received message */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -245,6 +262,9 @@ ssize_t recv(int sockfd, FAR void *buf, size_t len, int flags);
 ssize_t recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
                  FAR struct sockaddr *from, FAR socklen_t *fromlen);
 
+ssize_t sendmsg(int sockfd, FAR const struct msghdr *msg, int flags);
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
+
 int shutdown(int sockfd, int how);
 
 int setsockopt(int sockfd, int level, int option,
@@ -40,17 +40,122 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/ioctl.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 
 #include "libc.h"
 
 #if CONFIG_NSOCKET_DESCRIPTORS > 0 || CONFIG_NFILE_DESCRIPTORS > 0
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile_mapped
+ *
+ * Description:
+ *   If the input file can be mapped into memory (FIOC_MMAP, e.g., a file in
+ *   ROMFS in XIP FLASH or in TMPFS), write the file data directly from
+ *   memory instead of copying it through an allocated I/O buffer.
+ *
+ * Input Parameters:
+ *   See sendfile().  In addition:
+ *   result - The location to return the result of sendfile()
+ *
+ * Returned Value:
+ *   True if the input file could be mapped and the transfer was performed;
+ *   false if the caller must fall back to the read/write loop.
+ *
+ ****************************************************************************/
+
+static bool sendfile_mapped(int outfd, int infd, FAR off_t *offset,
+                            size_t count, FAR ssize_t *result)
+{
+  FAR const uint8_t *addr = NULL;
+  ssize_t nbyteswritten;
+  size_t ntransferred;
+  off_t curpos;
+  off_t startpos;
+  off_t size;
+
+  if (ioctl(infd, FIOC_MMAP, (unsigned long)((uintptr_t)&addr)) < 0 ||
+      addr == NULL)
+    {
+      return false;
+    }
+
+  /* Get the file position to start from and the size of the file */
+
+  curpos   = lseek(infd, 0, SEEK_CUR);
+  size     = lseek(infd, 0, SEEK_END);
+  startpos = offset != NULL ? *offset : curpos;
+
+  if (curpos == (off_t)-1 || size == (off_t)-1 ||
+      lseek(infd, curpos, SEEK_SET) == (off_t)-1)
+    {
+      return false;
+    }
+
+  if (startpos >= size)
+    {
+      count = 0;
+    }
+  else if (count > (size_t)(size - startpos))
+    {
+      count = size - startpos;
+    }
+
+  /* Write the data from memory until all of it has been transferred */
+
+  for (ntransferred = 0; ntransferred < count; )
+    {
+      nbyteswritten = _NX_WRITE(outfd, addr + startpos + ntransferred,
+                                count - ntransferred);
+      if (nbyteswritten < 0)
+        {
+#ifndef CONFIG_DISABLE_SIGNALS
+          /* EINTR is not an error if some data has been transferred (but
+           * will still stop the copy).
+           */
+
+          if (_NX_GETERRNO(nbyteswritten) == EINTR && ntransferred > 0)
+            {
+              break;
+            }
+#endif
+
+          _NX_SETERRNO(nbyteswritten);
+          *result = ERROR;
+          return true;
+        }
+
+      ntransferred += nbyteswritten;
+    }
+
+  /* Return the new file position or update the file offset */
+
+  if (offset != NULL)
+    {
+      *offset = startpos + ntransferred;
+    }
+  else if (lseek(infd, startpos + ntransferred, SEEK_SET) == (off_t)-1)
+    {
+      *result = ERROR;
+      return true;
+    }
+
+  *result = ntransferred;
+  return true;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -113,6 +218,13 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
   size_t  ntransferred;
   bool endxfr;
 
+  /* Write directly from memory if the input file can be mapped */
+
+  if (sendfile_mapped(outfd, infd, offset, count, &nbyteswritten))
+    {
+      return nbyteswritten;
+    }
+
   /* Get the current file position. */
 
   if (offset)
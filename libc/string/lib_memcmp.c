@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_memword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +53,45 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  /* If both buffers can be brought to a word boundary together, then skip
+   * over the leading equal words.  The bytes of the first differing word,
+   * if any, are compared below.
+   */
+
+  if (n >= LIB_SMALLSIZE &&
+      (((uintptr_t)p1 ^ (uintptr_t)p2) & LIB_WORDMASK) == 0)
+    {
+      FAR const lib_word_t *w1;
+      FAR const lib_word_t *w2;
+
+      while (!LIB_ISALIGNED(p1))
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      w1 = (FAR const lib_word_t *)p1;
+      w2 = (FAR const lib_word_t *)p2;
+
+      while (n >= LIB_WORDSIZE && *w1 == *w2)
+        {
+          w1++;
+          w2++;
+          n -= LIB_WORDSIZE;
+        }
+
+      p1 = (unsigned char *)w1;
+      p2 = (unsigned char *)w2;
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
@@ -65,6 +106,7 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
       p1++;
       p2++;
     }
+
   return 0;
 }
 #endif
@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_memword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,6 +56,131 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  if (n >= LIB_SMALLSIZE)
+    {
+      FAR lib_word_t *wout;
+
+#ifdef CONFIG_LIBC_STRING_SSE2
+      if (n >= LIB_VECTHRESH)
+        {
+          FAR lib_vec_t *vout;
+          FAR const lib_uvec_t *vin;
+
+          /* Align the destination to a 16-byte boundary.  The source may
+           * remain unaligned.
+           */
+
+          while (((uintptr_t)pout & LIB_VECMASK) != 0)
+            {
+              *pout++ = *pin++;
+              n--;
+            }
+
+          vout = (FAR lib_vec_t *)pout;
+          vin  = (FAR const lib_uvec_t *)pin;
+
+          while (n >= 4 * LIB_VECSIZE)
+            {
+              lib_vec_t v0 = vin[0];
+              lib_vec_t v1 = vin[1];
+              lib_vec_t v2 = vin[2];
+              lib_vec_t v3 = vin[3];
+
+              vout[0] = v0;
+              vout[1] = v1;
+              vout[2] = v2;
+              vout[3] = v3;
+
+              vout   += 4;
+              vin    += 4;
+              n      -= 4 * LIB_VECSIZE;
+            }
+
+          pout = (FAR unsigned char *)vout;
+          pin  = (FAR unsigned char *)vin;
+        }
+#endif
+
+      /* Align the destination to a word boundary */
+
+      while (!LIB_ISALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR lib_word_t *)pout;
+
+      if (LIB_ISALIGNED(pin))
+        {
+          FAR const lib_word_t *win = (FAR const lib_word_t *)pin;
+
+          /* Source and destination are both aligned.  Copy four words per
+           * iteration, then the remaining whole words.
+           */
+
+          while (n >= 4 * LIB_WORDSIZE)
+            {
+              lib_word_t w0 = win[0];
+              lib_word_t w1 = win[1];
+              lib_word_t w2 = win[2];
+              lib_word_t w3 = win[3];
+
+              wout[0] = w0;
+              wout[1] = w1;
+              wout[2] = w2;
+              wout[3] = w3;
+
+              wout   += 4;
+              win    += 4;
+              n      -= 4 * LIB_WORDSIZE;
+            }
+
+          while (n >= LIB_WORDSIZE)
+            {
+              *wout++ = *win++;
+              n      -= LIB_WORDSIZE;
+            }
+
+          pin = (FAR unsigned char *)win;
+        }
+      else if (n >= LIB_WORDSIZE)
+        {
+          FAR const lib_word_t *win;
+          unsigned int shift;
+          lib_word_t lo;
+          lib_word_t hi;
+
+          /* The source is not aligned.  Read aligned source words and
+           * shift them into place.  Every source word read contains at
+           * least one byte that is part of the copy.
+           */
+
+          shift = ((uintptr_t)pin & LIB_WORDMASK) << 3;
+          win   = (FAR const lib_word_t *)((uintptr_t)pin & ~LIB_WORDMASK);
+          lo    = *win++;
+
+          while (n >= LIB_WORDSIZE)
+            {
+              hi      = *win++;
+              *wout++ = LIB_MERGE(lo, hi, shift);
+              lo      = hi;
+              n      -= LIB_WORDSIZE;
+            }
+
+          /* The next source byte is in the last word read */
+
+          pin = (FAR unsigned char *)(win - 1) + (shift >> 3);
+        }
+
+      pout = (FAR unsigned char *)wout;
+    }
+#endif
+
+  /* Copy any remaining bytes */
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
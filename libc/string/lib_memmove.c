@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_memword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,11 +53,53 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
   FAR char *tmp;
   FAR char *s;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  /* If the regions do not overlap, then memcpy() can be used */
+
+  if ((FAR char *)dest + count <= (FAR const char *)src ||
+      (FAR const char *)src + count <= (FAR char *)dest)
+    {
+      return memcpy(dest, src, count);
+    }
+#endif
+
   if (dest <= src)
     {
       tmp = (FAR char *) dest;
       s   = (FAR char *) src;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+      /* Copy forward one word at a time if both regions can be brought to
+       * a word boundary together.  Each word is read before it is written,
+       * so this is safe when the destination is below the source.
+       */
+
+      if (count >= LIB_SMALLSIZE &&
+          (((uintptr_t)tmp ^ (uintptr_t)s) & LIB_WORDMASK) == 0)
+        {
+          FAR lib_word_t *wtmp;
+          FAR lib_word_t *ws;
+
+          while (!LIB_ISALIGNED(tmp))
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          wtmp = (FAR lib_word_t *)tmp;
+          ws   = (FAR lib_word_t *)s;
+
+          while (count >= LIB_WORDSIZE)
+            {
+              *wtmp++ = *ws++;
+              count  -= LIB_WORDSIZE;
+            }
+
+          tmp = (FAR char *)wtmp;
+          s   = (FAR char *)ws;
+        }
+#endif
+
       while (count--)
         {
           *tmp++ = *s++;
@@ -66,6 +110,37 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest + count;
       s   = (FAR char *) src + count;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+      /* Copy backward one word at a time if both regions can be brought
+       * to a word boundary together.
+       */
+
+      if (count >= LIB_SMALLSIZE &&
+          (((uintptr_t)tmp ^ (uintptr_t)s) & LIB_WORDMASK) == 0)
+        {
+          FAR lib_word_t *wtmp;
+          FAR lib_word_t *ws;
+
+          while (!LIB_ISALIGNED(tmp))
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          wtmp = (FAR lib_word_t *)tmp;
+          ws   = (FAR lib_word_t *)s;
+
+          while (count >= LIB_WORDSIZE)
+            {
+              *--wtmp = *--ws;
+              count  -= LIB_WORDSIZE;
+            }
+
+          tmp = (FAR char *)wtmp;
+          s   = (FAR char *)ws;
+        }
+#endif
+
       while (count--)
         {
           *--tmp = *--s;
@@ -46,6 +46,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include "string/lib_memword.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -65,7 +67,89 @@
 #ifndef CONFIG_LIBC_ARCH_MEMSET
 FAR void *memset(FAR void *s, int c, size_t n)
 {
-#ifdef CONFIG_MEMSET_OPTSPEED
+#if defined(CONFIG_LIBC_STRING_OPTIMIZE)
+  FAR unsigned char *p = (FAR unsigned char *)s;
+
+  if (n >= LIB_SMALLSIZE)
+    {
+      FAR lib_word_t *wp;
+      lib_word_t val;
+
+      /* Replicate the fill byte into every byte of a word */
+
+      val = (lib_word_t)(unsigned char)c * ((lib_word_t)-1 / 0xff);
+
+      /* Align to a word boundary */
+
+      while (!LIB_ISALIGNED(p))
+        {
+          *p++ = (unsigned char)c;
+          n--;
+        }
+
+      wp = (FAR lib_word_t *)p;
+
+#ifdef CONFIG_LIBC_STRING_SSE2
+      if (n >= LIB_VECTHRESH)
+        {
+          FAR lib_vec_t *vp;
+          lib_vec_t vval =
+          {
+            (long long)val, (long long)val
+          };
+
+          /* Align to a 16-byte boundary */
+
+          while (((uintptr_t)wp & LIB_VECMASK) != 0)
+            {
+              *wp++ = val;
+              n    -= LIB_WORDSIZE;
+            }
+
+          vp = (FAR lib_vec_t *)wp;
+          while (n >= 4 * LIB_VECSIZE)
+            {
+              vp[0] = vval;
+              vp[1] = vval;
+              vp[2] = vval;
+              vp[3] = vval;
+              vp   += 4;
+              n    -= 4 * LIB_VECSIZE;
+            }
+
+          wp = (FAR lib_word_t *)vp;
+        }
+#endif
+
+      /* Set four words per iteration, then the remaining whole words */
+
+      while (n >= 4 * LIB_WORDSIZE)
+        {
+          wp[0] = val;
+          wp[1] = val;
+          wp[2] = val;
+          wp[3] = val;
+          wp   += 4;
+          n    -= 4 * LIB_WORDSIZE;
+        }
+
+      while (n >= LIB_WORDSIZE)
+        {
+          *wp++ = val;
+          n    -= LIB_WORDSIZE;
+        }
+
+      p = (FAR unsigned char *)wp;
+    }
+
+  /* Set any remaining bytes */
+
+  while (n-- > 0)
+    {
+      *p++ = (unsigned char)c;
+    }
+
+#elif defined(CONFIG_MEMSET_OPTSPEED)
   /* This version is optimized for speed (you could do better
    * still by exploiting processor caching or memory burst
    * knowledge.)
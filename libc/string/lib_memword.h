@@ -0,0 +1,118 @@
+/****************************************************************************
+ * libc/string/lib_memword.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBC_STRING_LIB_MEMWORD_H
+#define __LIBC_STRING_LIB_MEMWORD_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The optimized memory functions operate on lib_word_t, the natural machine
+ * word.
+ */
+
+#define LIB_WORDSIZE      sizeof(lib_word_t)
+#define LIB_WORDMASK      (LIB_WORDSIZE - 1)
+#define LIB_WORDBITS      (8 * LIB_WORDSIZE)
+
+/* Below this size, the setup cost of the word loops is not worthwhile and
+ * the operation is performed one byte at a time.
+ */
+
+#define LIB_SMALLSIZE     (2 * LIB_WORDSIZE)
+
+#define LIB_ISALIGNED(p)  (((uintptr_t)(p) & LIB_WORDMASK) == 0)
+
+/* Build the word that begins 'shift' bits into the aligned word 'lo' and
+ * continues into the following aligned word 'hi'.  This is used to copy
+ * from a source that is not aligned to the same boundary as the
+ * destination.  'shift' must not be zero.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#  define LIB_MERGE(lo, hi, shift) \
+     (((lo) << (shift)) | ((hi) >> (LIB_WORDBITS - (shift))))
+#else
+#  define LIB_MERGE(lo, hi, shift) \
+     (((lo) >> (shift)) | ((hi) << (LIB_WORDBITS - (shift))))
+#endif
+
+/* SSE2 is used for larger operations in the x86_64 simulation */
+
+#ifdef CONFIG_LIBC_STRING_SSE2
+#  define LIB_VECSIZE     16
+#  define LIB_VECMASK     (LIB_VECSIZE - 1)
+#  define LIB_VECTHRESH   256
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Words are accessed through a type that may alias any other type since
+ * the caller's buffers may be declared as anything.
+ */
+
+#ifdef __GNUC__
+typedef uintptr_t lib_word_t __attribute__((__may_alias__));
+#else
+typedef uintptr_t lib_word_t;
+#endif
+
+#ifdef CONFIG_LIBC_STRING_SSE2
+/* 16-byte vectors.  The GCC vector extension compiles to SSE2 loads and
+ * stores on x86_64 without requiring the host compiler's intrinsic
+ * headers.  lib_uvec_t may be unaligned.
+ */
+
+typedef long long lib_vec_t
+  __attribute__((__vector_size__(16), __may_alias__));
+typedef long long lib_uvec_t
+  __attribute__((__vector_size__(16), __may_alias__, __aligned__(1)));
+#endif
+
+#endif /* CONFIG_LIBC_STRING_OPTIMIZE */
+#endif /* __LIBC_STRING_LIB_MEMWORD_H */
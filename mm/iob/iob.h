@@ -46,6 +46,7 @@
 #include <debug.h>
 
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_IOB
 
@@ -87,32 +88,14 @@
  * Public Data
  ****************************************************************************/
 
-/* A list of all free, unallocated I/O buffers */
+/* The pool of I/O buffers */
 
-extern FAR struct iob_s *g_iob_freelist;
-
-/* A list of I/O buffers that are committed for allocation */
-
-extern FAR struct iob_s *g_iob_committed;
+extern struct mempool_s g_iob_pool;
 
 #if CONFIG_IOB_NCHAINS > 0
-/* A list of all free, unallocated I/O buffer queue containers */
-
-extern FAR struct iob_qentry_s *g_iob_freeqlist;
+/* The pool of I/O buffer queue containers */
 
-/* A list of I/O buffer queue containers that are committed for allocation */
-
-extern FAR struct iob_qentry_s *g_iob_qcommitted;
-#endif
-
-/* Counting semaphores that tracks the number of free IOBs/qentries */
-
-extern sem_t g_iob_sem;       /* Counts free I/O buffers */
-#if CONFIG_IOB_THROTTLE > 0
-extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
-#endif
-#if CONFIG_IOB_NCHAINS > 0
-extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
+extern struct mempool_s g_iob_qpool;
 #endif
 
 /****************************************************************************
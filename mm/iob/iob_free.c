@@ -39,13 +39,11 @@
 
 #include <nuttx/config.h>
 
-#include <semaphore.h>
 #include <assert.h>
 #include <debug.h>
 
-#include <nuttx/irq.h>
-#include <nuttx/arch.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #include "iob.h"
 
@@ -65,7 +63,6 @@
 FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 {
   FAR struct iob_s *next = iob->io_flink;
-  irqstate_t flags;
 
   iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
           iob, iob->io_pktlen, iob->io_len, next);
@@ -101,42 +98,11 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
               next, next->io_pktlen, next->io_len);
     }
 
-  /* Free the I/O buffer by adding it to the head of the free or the
-   * committed list. We don't know what context we are called from so
-   * we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
+  /* Free the I/O buffer by returning it to the pool.  This will wake up
+   * a thread waiting for an I/O buffer, if any.
    */
 
-  flags = enter_critical_section();
-
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
-   */
-
-  if (g_iob_sem.semcount < 0)
-    {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-    }
-  else
-    {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
-    }
-
-  /* Signal that an IOB is available.  If there is a thread waiting
-   * for an IOB, this will wake up exactly one thread.  The semaphore
-   * count will correctly indicated that the awakened task owns an
-   * IOB and should find it in the committed list.
-   */
-
-  nxsem_post(&g_iob_sem);
-#if CONFIG_IOB_THROTTLE > 0
-  nxsem_post(&g_throttle_sem);
-#endif
-  leave_critical_section(flags);
+  mempool_free(&g_iob_pool, iob);
 
   /* And return the I/O buffer after the one that was freed */
 
@@ -39,12 +39,8 @@
 
 #include <nuttx/config.h>
 
-#include <semaphore.h>
-#include <assert.h>
-
-#include <nuttx/irq.h>
-#include <nuttx/arch.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #include "iob.h"
 
@@ -66,42 +62,12 @@
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq)
 {
   FAR struct iob_qentry_s *nextq = iobq->qe_flink;
-  irqstate_t flags;
-
-  /* Free the I/O buffer chain container by adding it to the head of the
-   * free or the committed list. We don't know what context we are called
-   * from so we use extreme measures to protect the free list:  We disable
-   * interrupts very briefly.
-   */
-
-  flags = enter_critical_section();
-
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
-   */
-
-  if (g_iob_sem.semcount < 0)
-    {
-      iobq->qe_flink   = g_iob_qcommitted;
-      g_iob_qcommitted = iobq;
-    }
-  else
-    {
-      iobq->qe_flink   = g_iob_freeqlist;
-      g_iob_freeqlist  = iobq;
-    }
 
-  /* Signal that an I/O buffer chain container is available.  If there
-   * is a thread waiting for an I/O buffer chain container, this will
-   * wake up exactly one thread.  The semaphore count will correctly
-   * indicated that the awakened task owns an I/O buffer chain container
-   * and should find it in the committed list.
+  /* Free the I/O buffer chain container by returning it to the pool.
+   * This will wake up a thread waiting for a container, if any.
    */
 
-  nxsem_post(&g_qentry_sem);
-  leave_critical_section(flags);
+  mempool_free(&g_iob_qpool, iobq);
 
   /* And return the I/O buffer chain container after the one that was freed */
 
@@ -41,8 +41,8 @@
 
 #include <stdbool.h>
 
-#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #include "iob.h"
 
@@ -60,41 +60,39 @@
 
 /* This is a pool of pre-allocated I/O buffers */
 
-static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+static struct iob_s        g_iob_buffers[CONFIG_IOB_NBUFFERS];
 #if CONFIG_IOB_NCHAINS > 0
-static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
+static struct iob_qentry_s g_iob_qentries[CONFIG_IOB_NCHAINS];
 #endif
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* A list of all free, unallocated I/O buffers */
+/* The pool of I/O buffers.  Throttled allocations may not take the last
+ * CONFIG_IOB_THROTTLE buffers.
+ */
 
-FAR struct iob_s *g_iob_freelist;
-
-/* A list of I/O buffers that are committed for allocation */
-
-FAR struct iob_s *g_iob_committed;
+struct mempool_s g_iob_pool =
+{
+  "iob",                       /* name */
+  sizeof(struct iob_s),        /* bsize */
+  CONFIG_IOB_THROTTLE,         /* nreserve */
+  0,                           /* nexpand */
+  NULL                         /* wait */
+};
 
 #if CONFIG_IOB_NCHAINS > 0
-/* A list of all free, unallocated I/O buffer queue containers */
-
-FAR struct iob_qentry_s *g_iob_freeqlist;
-
-/* A list of I/O buffer queue containers that are committed for allocation */
+/* The pool of I/O buffer queue containers */
 
-FAR struct iob_qentry_s *g_iob_qcommitted;
-#endif
-
-/* Counting semaphores that tracks the number of free IOBs/qentries */
-
-sem_t g_iob_sem;            /* Counts free I/O buffers */
-#if CONFIG_IOB_THROTTLE > 0
-sem_t g_throttle_sem;       /* Counts available I/O buffers when throttled */
-#endif
-#if CONFIG_IOB_NCHAINS > 0
-sem_t g_qentry_sem;         /* Counts free I/O buffer queue containers */
+struct mempool_s g_iob_qpool =
+{
+  "iob_qentry",                /* name */
+  sizeof(struct iob_qentry_s), /* bsize */
+  0,                           /* nreserve */
+  0,                           /* nexpand */
+  NULL                         /* wait */
+};
 #endif
 
 /****************************************************************************
@@ -112,47 +110,19 @@ sem_t g_qentry_sem;         /* Counts free I/O buffer queue containers */
 void iob_initialize(void)
 {
   static bool initialized = false;
-  int i;
 
   /* Perform one-time initialization */
 
   if (!initialized)
     {
-      /* Add each I/O buffer to the free list */
-
-      for (i = 0; i < CONFIG_IOB_NBUFFERS; i++)
-        {
-          FAR struct iob_s *iob = &g_iob_pool[i];
-
-          /* Add the pre-allocate I/O buffer to the head of the free list */
-
-          iob->io_flink  = g_iob_freelist;
-          g_iob_freelist = iob;
-        }
-
-      g_iob_committed = NULL;
+      /* Add each I/O buffer to the pool */
 
-      nxsem_init(&g_iob_sem, 0, CONFIG_IOB_NBUFFERS);
-#if CONFIG_IOB_THROTTLE > 0
-      nxsem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
-#endif
+      mempool_initialize(&g_iob_pool, g_iob_buffers, CONFIG_IOB_NBUFFERS);
 
 #if CONFIG_IOB_NCHAINS > 0
-      /* Add each I/O buffer chain queue container to the free list */
-
-      for (i = 0; i < CONFIG_IOB_NCHAINS; i++)
-        {
-          FAR struct iob_qentry_s *iobq = &g_iob_qpool[i];
-
-          /* Add the pre-allocate buffer container to the head of the free list */
-
-          iobq->qe_flink  = g_iob_freeqlist;
-          g_iob_freeqlist = iobq;
-        }
-
-      g_iob_qcommitted = NULL;
+      /* Add each I/O buffer chain queue container to the pool */
 
-      nxsem_init(&g_qentry_sem, 0, CONFIG_IOB_NCHAINS);
+      mempool_initialize(&g_iob_qpool, g_iob_qentries, CONFIG_IOB_NCHAINS);
 #endif
       initialized = true;
     }
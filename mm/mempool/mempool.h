@@ -0,0 +1,87 @@
+/****************************************************************************
+ * mm/mempool/mempool.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MM_MEMPOOL_MEMPOOL_H
+#define __MM_MEMPOOL_MEMPOOL_H 1
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/mm/mempool.h>
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of all initialized pools, most recently initialized first */
+
+extern FAR struct mempool_s *g_mempools;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_addblocks
+ *
+ * Description:
+ *   Carve nblocks blocks out of the memory at storage and add them to the
+ *   free list of the pool.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void mempool_addblocks(FAR struct mempool_s *pool, FAR void *storage,
+                       unsigned int nblocks);
+
+/****************************************************************************
+ * Name: mempool_wakeup
+ *
+ * Description:
+ *   Wake up one waiter if there is a free block that it can use.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void mempool_wakeup(FAR struct mempool_s *pool);
+
+#endif /* __MM_MEMPOOL_MEMPOOL_H */
@@ -0,0 +1,278 @@
+/****************************************************************************
+ * mm/mempool/mempool_alloc.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/mempool.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_remove
+ *
+ * Description:
+ *   Remove the block at the head of the free list if the caller is allowed
+ *   to take it.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+static FAR void *mempool_remove(FAR struct mempool_s *pool, bool throttled)
+{
+  FAR sq_entry_t *node;
+  uint16_t nused;
+
+  if (pool->nfree <= (throttled ? pool->nreserve : 0))
+    {
+      return NULL;
+    }
+
+  node           = pool->freelist;
+  DEBUGASSERT(node != NULL);
+  pool->freelist = node->flink;
+  pool->nfree--;
+  pool->nalloc++;
+
+  nused = pool->ntotal - pool->nfree;
+  if (nused > pool->peak)
+    {
+      pool->peak = nused;
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: mempool_expand
+ *
+ * Description:
+ *   Add blocks from the kernel heap so that an allocation can succeed.
+ *   This is only possible from a normal task context.
+ *
+ * Assumptions:
+ *   Called within a critical section.  The critical section is broken
+ *   while the heap is accessed.
+ *
+ ****************************************************************************/
+
+static bool mempool_expand(FAR struct mempool_s *pool, bool throttled,
+                           FAR irqstate_t *flags)
+{
+  FAR void *storage;
+  unsigned int nblocks;
+  unsigned int needed;
+
+  if (pool->nexpand == 0 || up_interrupt_context() || sched_idletask())
+    {
+      return false;
+    }
+
+  /* A throttled allocation must also restore the reserve */
+
+  needed  = (throttled ? pool->nreserve : 0) + 1 - pool->nfree;
+  nblocks = pool->nexpand > needed ? pool->nexpand : needed;
+  if (pool->ntotal + nblocks > UINT16_MAX)
+    {
+      return false;
+    }
+
+  leave_critical_section(*flags);
+  storage = kmm_malloc(nblocks * pool->bsize);
+  *flags  = enter_critical_section();
+
+  if (storage == NULL)
+    {
+      return false;
+    }
+
+  mempool_addblocks(pool, storage, nblocks);
+  pool->nexpanded++;
+
+  /* Other callers may have been waiting.  The caller will take one of the
+   * new blocks; wake up one waiter for each of the others.
+   */
+
+  while (--nblocks > 0 && (pool->nwaiting > 0 || pool->nthrottled > 0))
+    {
+      mempool_wakeup(pool);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_tryalloc
+ *
+ * Description:
+ *   Allocate a block without waiting.  This may be called from an
+ *   interrupt handler.  Returns NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_tryalloc(FAR struct mempool_s *pool, bool throttled)
+{
+  FAR void *blk;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  blk = mempool_remove(pool, throttled);
+  if (blk == NULL && mempool_expand(pool, throttled, &flags))
+    {
+      blk = mempool_remove(pool, throttled);
+    }
+
+  if (blk == NULL)
+    {
+      pool->nfail++;
+    }
+
+  leave_critical_section(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate a block, waiting for one to be freed if the pool is exhausted
+ *   and cannot be expanded.  If called from an interrupt handler or from
+ *   the IDLE thread, this behaves like mempool_tryalloc().
+ *
+ *   Throttled allocations may not take the last pool->nreserve blocks.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool, bool throttled)
+{
+  FAR void *blk;
+  irqstate_t flags;
+  int ret;
+
+  if (up_interrupt_context() || sched_idletask())
+    {
+      return mempool_tryalloc(pool, throttled);
+    }
+
+  /* The following must be atomic with respect to interrupt level
+   * allocations.  Interrupts will be re-enabled while we wait.
+   */
+
+  flags = enter_critical_section();
+
+  blk = mempool_remove(pool, throttled);
+  if (blk == NULL && mempool_expand(pool, throttled, &flags))
+    {
+      blk = mempool_remove(pool, throttled);
+    }
+
+  while (blk == NULL)
+    {
+      FAR sem_t *sem;
+
+      /* Register as a waiter.  mempool_free() removes us from the count
+       * when it posts the semaphore.
+       */
+
+      if (throttled && pool->nreserve > 0)
+        {
+          pool->nthrottled++;
+          sem = &pool->throttlesem;
+        }
+      else
+        {
+          pool->nwaiting++;
+          sem = &pool->waitsem;
+        }
+
+      pool->nwait++;
+      ret = pool->wait != NULL ? pool->wait(sem) : nxsem_wait(sem);
+      if (ret < 0)
+        {
+          /* We were not posted, so remove ourself from the count of
+           * waiters.  EINTR is not an error here:  we simply try again.
+           */
+
+          if (sem == &pool->waitsem)
+            {
+              DEBUGASSERT(pool->nwaiting > 0);
+              pool->nwaiting--;
+            }
+          else
+            {
+              DEBUGASSERT(pool->nthrottled > 0);
+              pool->nthrottled--;
+            }
+
+          if (ret != -EINTR)
+            {
+              pool->nfail++;
+              break;
+            }
+        }
+
+      /* Try again.  An interrupt handler may have taken the block that
+       * was freed; in that case we will wait again.
+       */
+
+      blk = mempool_remove(pool, throttled);
+    }
+
+  leave_critical_section(flags);
+  return blk;
+}
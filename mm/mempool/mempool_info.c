@@ -0,0 +1,117 @@
+/****************************************************************************
+ * mm/mempool/mempool_info.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/mempool.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_navail
+ *
+ * Description:
+ *   Return the number of blocks that an allocation could take now without
+ *   waiting or expanding the pool.
+ *
+ ****************************************************************************/
+
+int mempool_navail(FAR struct mempool_s *pool, bool throttled)
+{
+  int navail = pool->nfree;
+
+  if (throttled)
+    {
+      navail -= pool->nreserve;
+    }
+
+  return navail > 0 ? navail : 0;
+}
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return a snapshot of the ndx'th registered pool.  This is used by
+ *   procfs to enumerate the pools.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no pool with that index.
+ *
+ ****************************************************************************/
+
+int mempool_info(int ndx, FAR struct mempoolinfo_s *info)
+{
+  FAR struct mempool_s *pool;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  flags = enter_critical_section();
+
+  for (pool = g_mempools; pool != NULL && ndx > 0; pool = pool->flink)
+    {
+      ndx--;
+    }
+
+  if (pool != NULL)
+    {
+      info->name      = pool->name;
+      info->bsize     = pool->bsize;
+      info->ntotal    = pool->ntotal;
+      info->nfree     = pool->nfree;
+      info->peak      = pool->peak;
+      info->nreserve  = pool->nreserve;
+      info->nwaiting  = pool->nwaiting + pool->nthrottled;
+      info->nexpanded = pool->nexpanded;
+      info->nalloc    = pool->nalloc;
+      info->nfail     = pool->nfail;
+      info->nwait     = pool->nwait;
+      ret             = OK;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
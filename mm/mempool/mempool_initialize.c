@@ -0,0 +1,191 @@
+/****************************************************************************
+ * mm/mempool/mempool_initialize.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/mempool.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of all initialized pools, most recently initialized first */
+
+FAR struct mempool_s *g_mempools;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_addblocks
+ *
+ * Description:
+ *   Carve nblocks blocks out of the memory at storage and add them to the
+ *   free list of the pool.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void mempool_addblocks(FAR struct mempool_s *pool, FAR void *storage,
+                       unsigned int nblocks)
+{
+  FAR uint8_t *blk = (FAR uint8_t *)storage;
+
+  pool->ntotal += nblocks;
+  pool->nfree  += nblocks;
+
+  while (nblocks-- > 0)
+    {
+      FAR sq_entry_t *node = (FAR sq_entry_t *)blk;
+
+      node->flink    = pool->freelist;
+      pool->freelist = node;
+      blk           += pool->bsize;
+    }
+}
+
+/****************************************************************************
+ * Name: mempool_wakeup
+ *
+ * Description:
+ *   Wake up one waiter if there is a free block that it can use.
+ *   Un-throttled waiters can use any block and are preferred.  Throttled
+ *   waiters are only awakened if a block above the reserve is available.
+ *
+ *   The awakened thread is not guaranteed to get the block:  an interrupt
+ *   handler may take it first.  In that case the waiter simply waits
+ *   again; it will be awakened by the next mempool_free().
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void mempool_wakeup(FAR struct mempool_s *pool)
+{
+  if (pool->nfree > 0 && pool->nwaiting > 0)
+    {
+      pool->nwaiting--;
+      nxsem_post(&pool->waitsem);
+    }
+  else if (pool->nfree > pool->nreserve && pool->nthrottled > 0)
+    {
+      pool->nthrottled--;
+      nxsem_post(&pool->throttlesem);
+    }
+}
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a pool of fixed size blocks and register it so that it is
+ *   visible in /proc/mempool.  The configuration fields of the pool
+ *   structure must be set before calling this function.
+ *
+ * Input Parameters:
+ *   pool    - The pool to be initialized
+ *   storage - Memory for the initial blocks, at least nblocks * pool->bsize
+ *             bytes.  If NULL, the initial blocks are taken from the kernel
+ *             heap.
+ *   nblocks - The number of initial blocks
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int mempool_initialize(FAR struct mempool_s *pool, FAR void *storage,
+                       unsigned int nblocks)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && pool->bsize >= sizeof(sq_entry_t));
+
+  if (storage == NULL && nblocks > 0)
+    {
+      storage = kmm_malloc(nblocks * pool->bsize);
+      if (storage == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  pool->freelist   = NULL;
+  pool->nwaiting   = 0;
+  pool->nthrottled = 0;
+  pool->ntotal     = 0;
+  pool->nfree      = 0;
+  pool->peak       = 0;
+  pool->nalloc     = 0;
+  pool->nfail      = 0;
+  pool->nwait      = 0;
+  pool->nexpanded  = 0;
+
+  /* The semaphores are used only as wait queues and so should not
+   * participate in priority inheritance.
+   */
+
+  nxsem_init(&pool->waitsem, 0, 0);
+  nxsem_setprotocol(&pool->waitsem, SEM_PRIO_NONE);
+  nxsem_init(&pool->throttlesem, 0, 0);
+  nxsem_setprotocol(&pool->throttlesem, SEM_PRIO_NONE);
+
+  flags = enter_critical_section();
+  mempool_addblocks(pool, storage, nblocks);
+
+  pool->flink = g_mempools;
+  g_mempools  = pool;
+  leave_critical_section(flags);
+
+  return OK;
+}
@@ -54,6 +54,36 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_MM_TLSF
+void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *next;
+
+  /* Convert the size to a segregated list index */
+
+  int ndx = mm_size2ndx(node->size);
+
+  /* The lists are not ordered by size, so just add the node to the head of
+   * the list.
+   */
+
+  next        = heap->mm_freelist[ndx];
+  node->blink = NULL;
+  node->flink = next;
+
+  if (next)
+    {
+      next->blink = node;
+    }
+
+  heap->mm_freelist[ndx] = node;
+
+  /* Mark the list (and its first-level list) as non-empty */
+
+  heap->mm_flbitmap                      |= (uint32_t)1 << (ndx >> MM_SL_SHIFT);
+  heap->mm_slbitmap[ndx >> MM_SL_SHIFT] |= (uint32_t)1 << (ndx & (MM_NSL - 1));
+}
+#else
 void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 {
   FAR struct mm_freenode_s *next;
@@ -82,3 +112,4 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
       next->blink = node;
     }
 }
+#endif
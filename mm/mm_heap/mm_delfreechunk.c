@@ -0,0 +1,106 @@
+/****************************************************************************
+ * mm/mm_heap/mm_delfreechunk.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from the free nodelist.  It is assumed that the
+ *   caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+#ifdef CONFIG_MM_TLSF
+  /* If there is no predecessor, then this node is at the head of its
+   * segregated list.
+   */
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      int ndx = mm_size2ndx(node->size);
+      int fl  = ndx >> MM_SL_SHIFT;
+
+      DEBUGASSERT(heap->mm_freelist[ndx] == node);
+      heap->mm_freelist[ndx] = node->flink;
+
+      /* Clear the bitmap bits if the list has become empty */
+
+      if (node->flink == NULL)
+        {
+          heap->mm_slbitmap[fl] &= ~((uint32_t)1 << (ndx & (MM_NSL - 1)));
+          if (heap->mm_slbitmap[fl] == 0)
+            {
+              heap->mm_flbitmap &= ~((uint32_t)1 << fl);
+            }
+        }
+    }
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+#else
+  /* There must be a predecessor, but there may not be a successor node. */
+
+  DEBUGASSERT(node->blink);
+  node->blink->flink = node->flink;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+#endif
+}
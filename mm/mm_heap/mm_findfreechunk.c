@@ -0,0 +1,165 @@
+/****************************************************************************
+ * mm/mm_heap/mm_findfreechunk.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <strings.h>
+
+#include <nuttx/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef NULL
+#  define NULL ((void *)0)
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes.  The chunk is not removed
+ *   from the free nodelist.  It is assumed that the caller holds the mm
+ *   semaphore.
+ *
+ *   If CONFIG_MM_TLSF is selected, the size is first rounded up to the
+ *   next second-level list boundary so that any chunk in the first
+ *   non-empty list at or above that index is large enough (good fit).
+ *   Otherwise, the size-ordered nodelist is searched for the smallest
+ *   chunk that satisfies the request (best fit).
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The whole chunk size (payload and header)
+ *
+ * Returned Value:
+ *   The free chunk or NULL if no chunk large enough is available.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+#ifdef CONFIG_MM_TLSF
+  size_t search = size;
+  uint32_t bitmap;
+  int ndx;
+  int fl;
+
+  /* Round the size up so that every chunk in the selected list will be
+   * large enough.  Small chunks are already in exact-sized lists.
+   */
+
+  if (size >= (1 << MM_FL_SHIFT) && size < MM_MAX_CHUNK)
+    {
+      search += ((size_t)1 << (fls((int)size) - 1 - MM_SL_SHIFT)) - 1;
+    }
+
+  ndx = mm_size2ndx(search);
+  fl  = ndx >> MM_SL_SHIFT;
+
+  /* Look for a non-empty second-level list in this first-level list */
+
+  bitmap = heap->mm_slbitmap[fl] & ((uint32_t)~0 << (ndx & (MM_NSL - 1)));
+  if (bitmap == 0)
+    {
+      /* None.. look for the next non-empty first-level list */
+
+      if (fl + 1 >= MM_NFL)
+        {
+          return NULL;
+        }
+
+      bitmap = heap->mm_flbitmap & ((uint32_t)~0 << (fl + 1));
+      if (bitmap == 0)
+        {
+          return NULL;
+        }
+
+      fl     = ffs((int)bitmap) - 1;
+      bitmap = heap->mm_slbitmap[fl];
+    }
+
+  node = heap->mm_freelist[(fl << MM_SL_SHIFT) + ffs((int)bitmap) - 1];
+
+  /* The final first-level list collects all very large chunks regardless
+   * of size.  That is the only list that may need to be searched.
+   */
+
+  if (fl == MM_NFL - 1)
+    {
+      for (; node && node->size < size; node = node->flink);
+    }
+
+#else
+  int ndx;
+
+  /* Get the location in the node list to start the search. Special case
+   * really big allocations
+   */
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      ndx = MM_NNODES-1;
+    }
+  else
+    {
+      /* Convert the request size into a nodelist index */
+
+      ndx = mm_size2ndx(size);
+    }
+
+  /* Search for a large enough chunk in the list of nodes. This list is
+   * ordered by size, but will have occasional zero sized nodes as we visit
+   * other mm_nodelist[] entries.
+   */
+
+  for (node = heap->mm_nodelist[ndx].flink;
+       node && node->size < size;
+       node = node->flink);
+#endif
+
+  return node;
+}
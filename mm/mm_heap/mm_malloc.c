@@ -40,6 +40,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -73,7 +74,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   FAR struct mm_freenode_s *node;
   size_t alignsize;
   void *ret = NULL;
-  int ndx;
+#ifdef CONFIG_MM_RECLAIM
+  bool reclaimed = false;
+#endif
 
   /* Ignore zero-length allocations */
 
@@ -89,38 +92,18 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
   DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
 
+#ifdef CONFIG_MM_RECLAIM
+retry:
+#endif
   /* We need to hold the MM semaphore while we muck with the nodelist. */
 
   mm_takesemaphore(heap);
 
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
-
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES-1;
-    }
-  else
-    {
-      /* Convert the request size into a nodelist index */
-
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
+  /* Find a free chunk that is large enough */
 
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink);
+  node = mm_findfreechunk(heap, alignsize);
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
-   */
+  /* If we found a node with non-zero size, then this is one to use. */
 
   if (node)
     {
@@ -128,16 +111,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free nodelist */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -184,6 +160,21 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   mm_givesemaphore(heap);
 
+#ifdef CONFIG_MM_RECLAIM
+  /* If the allocation failed, let any cache that lives in the heap release
+   * memory and then try one more time.
+   */
+
+  if (ret == NULL && !reclaimed)
+    {
+      reclaimed = true;
+      if (mm_reclaim(heap, alignsize) > 0)
+        {
+          goto retry;
+        }
+    }
+#endif
+
   /* If CONFIG_DEBUG_MM is defined, then output the result of the allocation
    * to the SYSLOG.
    */
@@ -220,16 +220,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           FAR struct mm_allocnode_s *newnode;
 
-          /* Remove the previous node.  There must be a predecessor, but
-           * there may not be a successor node.
-           */
+          /* Remove the previous node from the free nodelist */
 
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          mm_delfreechunk(heap, prev);
 
           /* Extend the node into the previous free chunk */
 
@@ -266,12 +259,12 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
           oldnode = newnode;
           oldsize = newnode->size;
 
-          /* Now we have to move the user contents 'down' in memory.  memcpy should
-           * should be save for this.
+          /* Now we have to move the user contents 'down' in memory.  The
+           * regions may overlap so memcpy() is not safe for this.
            */
 
           newmem = (FAR void *)((FAR char *)newnode + SIZEOF_MM_ALLOCNODE);
-          memcpy(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
+          memmove(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
         }
 
       /* Extend into the next free chunk */
@@ -287,16 +280,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
           andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + nextsize);
 
-          /* Remove the next node.  There must be a predecessor, but there
-           * may not be a successor node.
-           */
+          /* Remove the next node from the free nodelist */
 
-          DEBUGASSERT(next->blink);
-          next->blink->flink = next->flink;
-          if (next->flink)
-            {
-              next->flink->blink = next->blink;
-            }
+          mm_delfreechunk(heap, next);
 
           /* Extend the node into the next chunk */
 
@@ -0,0 +1,157 @@
+/****************************************************************************
+ * mm/mm_heap/mm_reclaim.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_RECLAIM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of reclaim handlers.  At present, the clients are the
+ * file system page cache and the user heap cache.
+ */
+
+#define MM_NRECLAIM 4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One registered reclaim handler and the heap that its cache lives in */
+
+struct mm_reclaim_s
+{
+  FAR struct mm_heap_s *heap;      /* The heap, or NULL for any heap */
+  mm_reclaim_t handler;            /* The reclaim handler */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The registered reclaim handlers */
+
+static struct mm_reclaim_s g_mm_reclaim[MM_NRECLAIM];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addreclaim
+ *
+ * Description:
+ *   Register a handler that is called to release cached memory when an
+ *   allocation from 'heap' fails.  Handlers are called in the order of
+ *   registration.
+ *
+ * Input Parameters:
+ *   heap    - The heap that the cached memory belongs to.  NULL means that
+ *             the handler is called when an allocation from any heap fails.
+ *   handler - The reclaim handler
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSPC if no more handlers can be registered.
+ *
+ ****************************************************************************/
+
+int mm_addreclaim(FAR struct mm_heap_s *heap, mm_reclaim_t handler)
+{
+  int i;
+
+  DEBUGASSERT(handler != NULL);
+
+  for (i = 0; i < MM_NRECLAIM; i++)
+    {
+      if (g_mm_reclaim[i].handler == NULL)
+        {
+          g_mm_reclaim[i].heap    = heap;
+          g_mm_reclaim[i].handler = handler;
+          return OK;
+        }
+    }
+
+  DEBUGPANIC();
+  return -ENOSPC;
+}
+
+/****************************************************************************
+ * Name: mm_reclaim
+ *
+ * Description:
+ *   Ask the reclaim handlers registered for 'heap' to release memory.  The
+ *   handlers are called until 'size' bytes have been released or until all
+ *   of them have been called.
+ *
+ * Input Parameters:
+ *   heap - The heap in which the allocation failed
+ *   size - The number of bytes that the failed allocation needed
+ *
+ * Returned Value:
+ *   The number of bytes released; zero if nothing could be released.
+ *
+ ****************************************************************************/
+
+size_t mm_reclaim(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_reclaim_s *reclaim;
+  size_t released = 0;
+  int i;
+
+  for (i = 0; i < MM_NRECLAIM && released < size; i++)
+    {
+      reclaim = &g_mm_reclaim[i];
+      if (reclaim->handler != NULL &&
+          (reclaim->heap == NULL || reclaim->heap == heap))
+        {
+          released += reclaim->handler(size - released);
+        }
+    }
+
+  return released;
+}
+
+#endif /* CONFIG_MM_RECLAIM */
@@ -39,6 +39,8 @@
 
 #include <nuttx/config.h>
 
+#include <strings.h>
+
 #include <nuttx/mm/mm.h>
 
 /****************************************************************************
@@ -51,8 +53,47 @@
  * Description:
  *    Convert the size to a nodelist index.
  *
+ *    If CONFIG_MM_TLSF is selected, the returned value is the index of the
+ *    segregated free list that holds chunks of this size, i.e.,
+ *    (fl << MM_SL_SHIFT) + sl.
+ *
  ****************************************************************************/
 
+#ifdef CONFIG_MM_TLSF
+int mm_size2ndx(size_t size)
+{
+  int fl;
+  int sl;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      /* All very large chunks share the final list */
+
+      return (MM_NFL - 1) << MM_SL_SHIFT;
+    }
+
+  if (size < (1 << MM_FL_SHIFT))
+    {
+      /* Small chunks: One second-level list per granule */
+
+      fl = 0;
+      sl = (int)(size >> MM_MIN_SHIFT);
+    }
+  else
+    {
+      /* fls() returns the one-based index of the most significant bit.  The
+       * MM_SL_SHIFT bits just below it select the second-level list.
+       */
+
+      int msb = fls((int)size) - 1;
+
+      fl = msb - MM_FL_SHIFT + 1;
+      sl = (int)(size >> (msb - MM_SL_SHIFT)) - MM_NSL;
+    }
+
+  return (fl << MM_SL_SHIFT) + sl;
+}
+#else
 int mm_size2ndx(size_t size)
 {
   int ndx = 0;
@@ -71,3 +112,4 @@ int mm_size2ndx(size_t size)
 
   return ndx;
 }
+#endif
@@ -60,5 +60,14 @@
 
 void free(FAR void *mem)
 {
+#ifdef CONFIG_MM_UMM_CACHE
+  /* Small chunks are returned to the per-CPU cache, if possible */
+
+  if (umm_mcache_free(mem))
+    {
+      return;
+    }
+#endif
+
   mm_free(USR_HEAP, mem);
 }
@@ -97,4 +97,10 @@
 void umm_initialize(FAR void *heap_start, size_t heap_size)
 {
   mm_initialize(USR_HEAP, heap_start, heap_size);
+
+#ifdef CONFIG_MM_UMM_CACHE
+  /* Let the heap drain the small allocation cache when it runs out */
+
+  umm_mcache_initialize();
+#endif
 }
@@ -66,6 +66,18 @@
 
 FAR void *malloc(size_t size)
 {
+#ifdef CONFIG_MM_UMM_CACHE
+  FAR void *mem;
+
+  /* Small allocations are satisfied from the per-CPU cache, if possible */
+
+  mem = umm_mcache_alloc(size);
+  if (mem != NULL)
+    {
+      return mem;
+    }
+#endif
+
 #ifdef CONFIG_BUILD_KERNEL
   FAR void *brkaddr;
   FAR void *mem;
@@ -0,0 +1,527 @@
+/****************************************************************************
+ * mm/umm_heap/umm_mcache.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#include "umm_heap/umm_heap.h"
+
+#ifdef CONFIG_MM_UMM_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define MCACHE_NCPUS     CONFIG_SMP_NCPUS
+#else
+#  define MCACHE_NCPUS     1
+#endif
+
+#define MCACHE_NCLASSES    CONFIG_MM_UMM_CACHE_NCLASSES
+#define MCACHE_DEPTH       CONFIG_MM_UMM_CACHE_DEPTH
+#define MCACHE_BATCH       ((MCACHE_DEPTH + 1) >> 1)
+
+/* Size class 'ndx' holds the chunks of exactly MCACHE_CHUNKSIZE(ndx) bytes
+ * (including the chunk header).
+ */
+
+#define MCACHE_CHUNKSIZE(n) ((size_t)((n) + 1) << MM_MIN_SHIFT)
+#define MCACHE_MAXCHUNK     MCACHE_CHUNKSIZE(MCACHE_NCLASSES - 1)
+
+/* The magazines of a CPU are normally accessed only by that CPU, with local
+ * interrupts disabled.  In SMP mode, the reclaim handler also drains the
+ * magazines of the other CPUs, so each CPU's magazines are protected by a
+ * spinlock as well.  It is only contended while the heap is reclaiming.
+ */
+
+#ifdef CONFIG_SMP
+#  define mcache_lock(cpu)   spin_lock(&g_mcache_lock[cpu])
+#  define mcache_unlock(cpu) spin_unlock(&g_mcache_lock[cpu])
+#else
+#  define mcache_lock(cpu)
+#  define mcache_unlock(cpu)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This is one magazine:  A stack of cached chunks of one size class that
+ * belongs to one CPU.  From the point of view of the heap, all cached
+ * chunks are allocated.
+ *
+ * mg_batch[] holds the chunks of a refill or drain while they are moved to
+ * or from the heap.  The heap cannot be called with interrupts disabled,
+ * so the task doing the transfer owns mg_batch[] until it is done, even if
+ * it is preempted or migrated to another CPU meanwhile.  mg_busy tells
+ * other tasks to bypass the cache until then.
+ */
+
+struct mcache_magazine_s
+{
+  uint16_t mg_ncached;               /* Number of chunks in mg_chunks[] */
+  bool mg_busy;                      /* mg_batch[] is in use */
+  FAR void *mg_chunks[MCACHE_DEPTH]; /* Cached chunks (user addresses) */
+  FAR void *mg_batch[MCACHE_BATCH];  /* Chunks in transit to/from the heap */
+
+  /* Statistics */
+
+  unsigned long mg_hits;             /* Allocations satisfied from the cache */
+  unsigned long mg_misses;           /* Allocations that required a refill */
+  unsigned long mg_frees;            /* Frees returned to the cache */
+  unsigned long mg_drains;           /* Frees that required a drain */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mcache_magazine_s g_mcache[MCACHE_NCPUS][MCACHE_NCLASSES];
+
+#ifdef CONFIG_SMP
+static volatile spinlock_t g_mcache_lock[MCACHE_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mcache_size2ndx
+ *
+ * Description:
+ *   Convert a chunk size to a size class index.  Returns a negative value
+ *   if the chunk size is not cached.
+ *
+ ****************************************************************************/
+
+static inline int mcache_size2ndx(size_t chunksize)
+{
+  if (chunksize > MCACHE_MAXCHUNK || (chunksize & MM_GRAN_MASK) != 0)
+    {
+      return -1;
+    }
+
+  return (int)(chunksize >> MM_MIN_SHIFT) - 1;
+}
+
+/****************************************************************************
+ * Name: mcache_unbusy
+ *
+ * Description:
+ *   Give up the ownership of the mg_batch[] array of the magazine of size
+ *   class 'ndx' of 'cpu'.  The caller may be running on a different CPU by
+ *   now.
+ *
+ ****************************************************************************/
+
+static void mcache_unbusy(int cpu, int ndx)
+{
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  mcache_lock(cpu);
+  g_mcache[cpu][ndx].mg_busy = false;
+  mcache_unlock(cpu);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mcache_reclaim
+ *
+ * Description:
+ *   The heap reclaim handler:  Drain the magazines of all CPUs back into
+ *   the user heap.  Everything is drained, not just 'size' bytes, since the
+ *   freed chunks must coalesce before they can satisfy a larger request.
+ *
+ ****************************************************************************/
+
+static size_t mcache_reclaim(size_t size)
+{
+  FAR struct mcache_magazine_s *mag;
+  FAR void *mem;
+  irqstate_t flags;
+  size_t released = 0;
+  int cpu;
+  int ndx;
+
+  mm_takesemaphore(USR_HEAP);
+
+  for (cpu = 0; cpu < MCACHE_NCPUS; cpu++)
+    {
+      for (ndx = 0; ndx < MCACHE_NCLASSES; ndx++)
+        {
+          mag = &g_mcache[cpu][ndx];
+
+          /* The chunks are removed one at a time because the heap cannot be
+           * called with interrupts disabled.
+           */
+
+          for (; ; )
+            {
+              mem   = NULL;
+              flags = up_irq_save();
+              mcache_lock(cpu);
+
+              if (mag->mg_ncached > 0)
+                {
+                  mem = mag->mg_chunks[--mag->mg_ncached];
+                }
+
+              mcache_unlock(cpu);
+              up_irq_restore(flags);
+
+              if (mem == NULL)
+                {
+                  break;
+                }
+
+              mm_free(USR_HEAP, mem);
+              released += MCACHE_CHUNKSIZE(ndx);
+            }
+        }
+    }
+
+  mm_givesemaphore(USR_HEAP);
+  return released;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_mcache_initialize
+ *
+ * Description:
+ *   Register the reclaim handler that drains the magazines when a user heap
+ *   allocation fails.  Called once from umm_initialize().
+ *
+ ****************************************************************************/
+
+void umm_mcache_initialize(void)
+{
+#ifdef CONFIG_SMP
+  int cpu;
+
+  for (cpu = 0; cpu < MCACHE_NCPUS; cpu++)
+    {
+      spin_initialize(&g_mcache_lock[cpu], SP_UNLOCKED);
+    }
+#endif
+
+  (void)mm_addreclaim(USR_HEAP, mcache_reclaim);
+}
+
+/****************************************************************************
+ * Name: umm_mcache_alloc
+ *
+ * Description:
+ *   Allocate a small chunk from the calling CPU's magazine.  If the
+ *   magazine is empty, it is refilled with a batch of chunks from the user
+ *   heap.  Only the refill requires the heap semaphore; access to the
+ *   magazine itself requires only that local interrupts are disabled so
+ *   that the caller cannot be preempted or migrated to another CPU.
+ *
+ * Input Parameters:
+ *   size - Size (in bytes) of the memory region to be allocated.
+ *
+ * Returned Value:
+ *   The address of the allocated memory (NULL on failure to allocate).
+ *   NULL is also returned if the size is not cached; in that case the
+ *   caller should allocate from the heap directly.
+ *
+ ****************************************************************************/
+
+FAR void *umm_mcache_alloc(size_t size)
+{
+  FAR struct mcache_magazine_s *mag;
+  FAR void **batch;
+  FAR void *mem = NULL;
+  irqstate_t flags;
+  size_t chunksize;
+  int nalloc;
+  int owner;
+  int cpu;
+  int ndx;
+
+  chunksize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  ndx       = mcache_size2ndx(chunksize);
+  if (size < 1 || ndx < 0)
+    {
+      return NULL;
+    }
+
+  /* Try the magazine of this CPU first */
+
+  flags = up_irq_save();
+  cpu   = up_cpu_index();
+  mag   = &g_mcache[cpu][ndx];
+  mcache_lock(cpu);
+
+  if (mag->mg_ncached > 0)
+    {
+      mem = mag->mg_chunks[--mag->mg_ncached];
+      mag->mg_hits++;
+      mcache_unlock(cpu);
+      up_irq_restore(flags);
+      return mem;
+    }
+
+  /* The magazine is empty.  If another task is already refilling or
+   * draining it, let the caller allocate from the heap directly.
+   */
+
+  mag->mg_misses++;
+  if (mag->mg_busy)
+    {
+      mcache_unlock(cpu);
+      up_irq_restore(flags);
+      return NULL;
+    }
+
+  mag->mg_busy = true;
+  batch        = mag->mg_batch;
+  owner        = cpu;
+  mcache_unlock(cpu);
+  up_irq_restore(flags);
+
+  /* Allocate a batch of chunks from the heap, holding the heap semaphore
+   * only once for the whole batch.
+   */
+
+  mm_takesemaphore(USR_HEAP);
+  for (nalloc = 0; nalloc < MCACHE_BATCH; nalloc++)
+    {
+      batch[nalloc] = mm_malloc(USR_HEAP, chunksize - SIZEOF_MM_ALLOCNODE);
+      if (batch[nalloc] == NULL)
+        {
+          break;
+        }
+    }
+
+  mm_givesemaphore(USR_HEAP);
+
+  if (nalloc == 0)
+    {
+      mcache_unbusy(owner, ndx);
+      return NULL;
+    }
+
+  /* Keep the first chunk for the caller and push the rest into the
+   * magazine.  We may have been migrated to a different CPU and the
+   * magazine may have been refilled in the meantime.
+   */
+
+  mem   = batch[--nalloc];
+  flags = up_irq_save();
+  cpu   = up_cpu_index();
+  mag   = &g_mcache[cpu][ndx];
+  mcache_lock(cpu);
+
+  while (nalloc > 0 && mag->mg_ncached < MCACHE_DEPTH)
+    {
+      mag->mg_chunks[mag->mg_ncached++] = batch[--nalloc];
+    }
+
+  mcache_unlock(cpu);
+  up_irq_restore(flags);
+
+  /* Return any chunks that did not fit */
+
+  while (nalloc > 0)
+    {
+      mm_free(USR_HEAP, batch[--nalloc]);
+    }
+
+  mcache_unbusy(owner, ndx);
+  return mem;
+}
+
+/****************************************************************************
+ * Name: umm_mcache_free
+ *
+ * Description:
+ *   Return a chunk to the calling CPU's magazine if it belongs to one of
+ *   the cached size classes.  If the magazine is full, a batch of chunks
+ *   is drained back into the user heap.
+ *
+ * Input Parameters:
+ *   mem - The memory to be freed
+ *
+ * Returned Value:
+ *   true if the chunk was accepted by the cache; false if the caller must
+ *   free the chunk to the heap directly.
+ *
+ ****************************************************************************/
+
+bool umm_mcache_free(FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mcache_magazine_s *mag;
+  FAR void **batch;
+  irqstate_t flags;
+  int ndrain = 0;
+  int cpu;
+  int ndx;
+
+  if (mem == NULL)
+    {
+      return false;
+    }
+
+  /* The size class is determined by the size of the allocated chunk */
+
+  node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) != 0);
+
+  ndx = mcache_size2ndx(node->size);
+  if (ndx < 0)
+    {
+      return false;
+    }
+
+  flags = up_irq_save();
+  cpu   = up_cpu_index();
+  mag   = &g_mcache[cpu][ndx];
+  mcache_lock(cpu);
+
+  /* If the magazine is full, remove a batch of chunks to make room.  If
+   * another task is already using the batch array, let the caller free the
+   * chunk to the heap directly.
+   */
+
+  if (mag->mg_ncached >= MCACHE_DEPTH)
+    {
+      if (mag->mg_busy)
+        {
+          mcache_unlock(cpu);
+          up_irq_restore(flags);
+          return false;
+        }
+
+      mag->mg_busy = true;
+      batch        = mag->mg_batch;
+
+      while (ndrain < MCACHE_BATCH)
+        {
+          batch[ndrain++] = mag->mg_chunks[--mag->mg_ncached];
+        }
+
+      mag->mg_drains++;
+    }
+
+  mag->mg_chunks[mag->mg_ncached++] = mem;
+  mag->mg_frees++;
+  mcache_unlock(cpu);
+  up_irq_restore(flags);
+
+  /* Release the drained chunks while holding the heap semaphore only once */
+
+  if (ndrain > 0)
+    {
+      mm_takesemaphore(USR_HEAP);
+      while (ndrain > 0)
+        {
+          mm_free(USR_HEAP, batch[--ndrain]);
+        }
+
+      mm_givesemaphore(USR_HEAP);
+      mcache_unbusy(cpu, ndx);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: umm_mcacheinfo
+ *
+ * Description:
+ *   Return the statistics for one size class of the user heap cache,
+ *   summed over all CPUs.
+ *
+ * Input Parameters:
+ *   ndx  - The size class index in the range 0 through
+ *          CONFIG_MM_UMM_CACHE_NCLASSES-1
+ *   info - The location to return the statistics
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the size class does not exist.
+ *
+ ****************************************************************************/
+
+int umm_mcacheinfo(int ndx, FAR struct mcacheinfo_s *info)
+{
+  FAR struct mcache_magazine_s *mag;
+  int cpu;
+
+  if (ndx < 0 || ndx >= MCACHE_NCLASSES || info == NULL)
+    {
+      return -EINVAL;
+    }
+
+  memset(info, 0, sizeof(struct mcacheinfo_s));
+  info->chunksize = MCACHE_CHUNKSIZE(ndx);
+
+  for (cpu = 0; cpu < MCACHE_NCPUS; cpu++)
+    {
+      /* The counts are sampled without locking and so are approximate */
+
+      mag            = &g_mcache[cpu][ndx];
+      info->ncached += mag->mg_ncached;
+      info->hits    += mag->mg_hits;
+      info->misses  += mag->mg_misses;
+      info->frees   += mag->mg_frees;
+      info->drains  += mag->mg_drains;
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_MM_UMM_CACHE */
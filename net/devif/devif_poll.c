@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/clock.h>
@@ -479,22 +480,34 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
+  int burst;
+  bool sent;
 
   /* Traverse all of the active TCP connections and perform the poll action */
 
   while (!bstop && (conn = tcp_nextconn(conn)))
     {
-      /* Perform the TCP TX poll */
+      /* Let the connection send up to CONFIG_NET_TCP_SEND_BURST segments
+       * as long as the driver accepts them.
+       */
 
-      tcp_poll(dev, conn);
+      burst = CONFIG_NET_TCP_SEND_BURST;
+      do
+        {
+          /* Perform the TCP TX poll */
 
-      /* Perform any necessary conversions on outgoing packets */
+          tcp_poll(dev, conn);
+          sent = dev->d_len > 0;
 
-      devif_packet_conversion(dev, DEVIF_TCP);
+          /* Perform any necessary conversions on outgoing packets */
 
-      /* Call back into the driver */
+          devif_packet_conversion(dev, DEVIF_TCP);
 
-      bstop = callback(dev);
+          /* Call back into the driver */
+
+          bstop = callback(dev);
+        }
+      while (!bstop && sent && --burst > 0);
     }
 
   return bstop;
@@ -0,0 +1,358 @@
+/****************************************************************************
+ * net/inet/inet_iobloan.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+#include <assert.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/mm/iob.h>
+
+#include "tcp/tcp.h"
+#include "udp/udp.h"
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET_IOB_LOAN
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inet_tcp_recviob
+ *
+ * Description:
+ *   Detach the I/O buffer chain at the head of the TCP read-ahead queue.
+ *
+ ****************************************************************************/
+
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_READAHEAD)
+static ssize_t inet_tcp_recviob(FAR struct socket *psock,
+                                FAR struct iob_s **iob)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  FAR struct iob_s *head;
+
+  DEBUGASSERT(conn != NULL);
+
+  net_lock();
+  head = iob_remove_queue(&conn->readahead);
+  net_unlock();
+
+  if (head == NULL)
+    {
+      /* Nothing buffered.  Report end-of-file if the peer closed the
+       * connection gracefully, otherwise let the caller poll for data.
+       */
+
+      if (!_SS_ISCONNECTED(psock->s_flags))
+        {
+          return _SS_ISCLOSED(psock->s_flags) ? 0 : -ENOTCONN;
+        }
+
+      return -EAGAIN;
+    }
+
+  DEBUGASSERT(head->io_pktlen > 0);
+  *iob = head;
+  return head->io_pktlen;
+}
+#endif
+
+/****************************************************************************
+ * Name: inet_udp_recviob
+ *
+ * Description:
+ *   Detach the datagram at the head of the UDP read-ahead queue and strip
+ *   the source address that udp_callback() stored in front of the payload.
+ *
+ ****************************************************************************/
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_READAHEAD)
+static ssize_t inet_udp_recviob(FAR struct socket *psock,
+                                FAR struct iob_s **iob,
+                                FAR struct sockaddr *from,
+                                FAR socklen_t *fromlen)
+{
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  FAR struct iob_s *head;
+  uint8_t src_addr_size;
+  int ret;
+
+  DEBUGASSERT(conn != NULL);
+
+  net_lock();
+  head = iob_remove_queue(&conn->readahead);
+  net_unlock();
+
+  if (head == NULL)
+    {
+      return -EAGAIN;
+    }
+
+  /* Each read-ahead entry is [src_addr_size][src_addr][payload] */
+
+  ret = iob_copyout(&src_addr_size, head, sizeof(uint8_t), 0);
+  if (ret != sizeof(uint8_t) ||
+      head->io_pktlen < sizeof(uint8_t) + src_addr_size)
+    {
+      nerr("ERROR: Malformed read-ahead entry\n");
+      (void)iob_free_chain(head);
+      return -EIO;
+    }
+
+  if (from != NULL && fromlen != NULL)
+    {
+      socklen_t len = *fromlen;
+
+      if ((socklen_t)src_addr_size < len)
+        {
+          len = src_addr_size;
+        }
+
+      (void)iob_copyout((FAR uint8_t *)from, head, len, sizeof(uint8_t));
+      *fromlen = src_addr_size;
+    }
+
+  /* Hand only the payload to the caller */
+
+  head = iob_trimhead(head, sizeof(uint8_t) + src_addr_size);
+  *iob = head;
+  return head->io_pktlen;
+}
+#endif
+
+/****************************************************************************
+ * Name: inet_udp_peeraddr
+ *
+ * Description:
+ *   Get the address of the peer of a connected UDP socket.
+ *
+ ****************************************************************************/
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_WRITE_BUFFERS)
+static socklen_t inet_udp_peeraddr(FAR struct udp_conn_s *conn,
+                                   FAR struct sockaddr_storage *addr)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      FAR struct sockaddr_in *addr4 = (FAR struct sockaddr_in *)addr;
+
+      addr4->sin_family = AF_INET;
+      addr4->sin_port   = conn->rport;
+      net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
+      return sizeof(struct sockaddr_in);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      FAR struct sockaddr_in6 *addr6 = (FAR struct sockaddr_in6 *)addr;
+
+      addr6->sin6_family = AF_INET6;
+      addr6->sin6_port   = conn->rport;
+      net_ipv6addr_copy(addr6->sin6_addr.s6_addr, conn->u.ipv6.raddr);
+      return sizeof(struct sockaddr_in6);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Loan the next unit of buffered receive data to the caller without
+ *   copying it.  For a TCP socket this is the oldest I/O buffer chain in
+ *   the read-ahead queue; for a UDP socket it is one complete datagram.
+ *   The caller owns the returned chain and must release it with
+ *   iob_free_chain() when done.
+ *
+ *   Only data that is already buffered can be loaned; this function never
+ *   waits.  Use poll() to wait for POLLIN before calling it.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iob     - Location to return the loaned I/O buffer chain
+ *   from    - Address of source (may be NULL).  Only used for UDP.
+ *   fromlen - The length of the address structure
+ *
+ * Returned Value:
+ *   On success, the number of bytes in the loaned chain is returned.  Zero
+ *   is returned for a TCP socket whose peer has closed the connection (no
+ *   chain is loaned) and for an empty UDP datagram.  Otherwise, a negated
+ *   errno value is returned:
+ *
+ *   EAGAIN       - No data is buffered
+ *   EBADF        - Invalid socket
+ *   ENOTCONN     - The TCP socket is not connected
+ *   EOPNOTSUPP   - The socket type does not buffer data in I/O buffers
+ *
+ ****************************************************************************/
+
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      FAR struct sockaddr *from, FAR socklen_t *fromlen)
+{
+  if (psock == NULL || psock->s_crefs <= 0 || iob == NULL)
+    {
+      return -EBADF;
+    }
+
+  *iob = NULL;
+
+  if (psock->s_domain != PF_INET && psock->s_domain != PF_INET6)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  switch (psock->s_type)
+    {
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_READAHEAD)
+      case SOCK_STREAM:
+        return inet_tcp_recviob(psock, iob);
+#endif
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_READAHEAD)
+      case SOCK_DGRAM:
+        return inet_udp_recviob(psock, iob, from, fromlen);
+#endif
+
+      default:
+        return -EOPNOTSUPP;
+    }
+}
+
+/****************************************************************************
+ * Name: psock_sendiob
+ *
+ * Description:
+ *   Send a caller-provided I/O buffer chain without copying it.  For a TCP
+ *   socket the chain is appended to the byte stream; for a UDP socket it is
+ *   sent as one datagram.  On success, the network takes ownership of the
+ *   chain and releases it when it is no longer needed.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   iob   - The I/O buffer chain to send.  io_pktlen must be valid in the
+ *           head buffer.
+ *   to    - Address of recipient.  Ignored for TCP.  May be NULL for a
+ *           connected UDP socket.
+ *   tolen - The length of the address structure
+ *
+ * Returned Value:
+ *   On success, the number of bytes queued for transmission is returned.
+ *   On failure, a negated errno value is returned and the caller still
+ *   owns the chain:
+ *
+ *   EBADF        - Invalid socket
+ *   EDESTADDRREQ - A UDP socket is not connected and no address was given
+ *   ENOMEM       - No write buffer is available
+ *   ENOTCONN     - The TCP socket is not connected
+ *   EOPNOTSUPP   - The socket type does not use write buffers
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendiob(FAR struct socket *psock, FAR struct iob_s *iob,
+                      FAR const struct sockaddr *to, socklen_t tolen)
+{
+  if (psock == NULL || psock->s_crefs <= 0 || iob == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_domain != PF_INET && psock->s_domain != PF_INET6)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  switch (psock->s_type)
+    {
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_WRITE_BUFFERS)
+      case SOCK_STREAM:
+        return psock_tcp_sendiob(psock, iob);
+#endif
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_WRITE_BUFFERS)
+      case SOCK_DGRAM:
+        {
+          struct sockaddr_storage addr;
+
+          if (to == NULL)
+            {
+              /* Use the peer address of a connected socket */
+
+              if (!_SS_ISCONNECTED(psock->s_flags))
+                {
+                  return -EDESTADDRREQ;
+                }
+
+              tolen = inet_udp_peeraddr(
+                        (FAR struct udp_conn_s *)psock->s_conn, &addr);
+              to    = (FAR const struct sockaddr *)&addr;
+            }
+
+          return psock_udp_sendtoiob(psock, iob, to, tolen);
+        }
+#endif
+
+      default:
+        return -EOPNOTSUPP;
+    }
+}
+
+#endif /* CONFIG_NET_IOB_LOAN */
@@ -1177,6 +1177,7 @@ static ssize_t inet_recvfrom_result(int result, struct inet_recvfrom_s *pstate)
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags.  Only MSG_DONTWAIT is interpreted.
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1189,7 +1190,8 @@ static ssize_t inet_recvfrom_result(int result, struct inet_recvfrom_s *pstate)
 
 #ifdef NET_UDP_HAVE_STACK
 static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
@@ -1234,7 +1236,7 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 #endif
 
 #ifdef CONFIG_NET_UDP_READAHEAD
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1256,6 +1258,14 @@ static ssize_t inet_udp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
    */
 
   else if (state.ir_recvlen <= 0)
+#else
+  /* Without read-ahead buffering, data can be received only by waiting */
+
+  if ((flags & MSG_DONTWAIT) != 0)
+    {
+      ret = -EAGAIN;
+    }
+  else
 #endif
     {
       /* Get the device that will handle the packet transfers.  This may be
@@ -1313,6 +1323,7 @@ errout_with_state:
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
+ *   flags  Receive flags.  Only MSG_DONTWAIT is interpreted.
  *   from   INET address of source (may be NULL)
  *
  * Returned Value:
@@ -1325,7 +1336,8 @@ errout_with_state:
 
 #ifdef NET_TCP_HAVE_STACK
 static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                                 FAR struct sockaddr *from, FAR socklen_t *fromlen)
+                                 int flags, FAR struct sockaddr *from,
+                                 FAR socklen_t *fromlen)
 {
   struct inet_recvfrom_s state;
   int               ret;
@@ -1400,7 +1412,7 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
 
   else
 #ifdef CONFIG_NET_TCP_READAHEAD
-  if (_SS_ISNONBLOCK(psock->s_flags))
+  if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
     {
       /* Return the number of bytes read from the read-ahead buffer if
        * something was received (already in 'ret'); EAGAIN if not.
@@ -1420,6 +1432,14 @@ static ssize_t inet_tcp_recvfrom(FAR struct socket *psock, FAR void *buf, size_t
    */
 
   else
+#else
+  /* Without read-ahead buffering, data can be received only by waiting */
+
+  if ((flags & MSG_DONTWAIT) != 0)
+    {
+      ret = -EAGAIN;
+    }
+  else
 #endif
 
   /* We get here when we we decide that we need to setup the wait for incoming
@@ -1570,7 +1590,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_STREAM:
       {
 #ifdef NET_TCP_HAVE_STACK
-        ret = inet_tcp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_tcp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
@@ -1582,7 +1602,7 @@ ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     case SOCK_DGRAM:
       {
 #ifdef NET_UDP_HAVE_STACK
-        ret = inet_udp_recvfrom(psock, buf, len, from, fromlen);
+        ret = inet_udp_recvfrom(psock, buf, len, flags, from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
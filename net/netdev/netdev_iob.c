@@ -0,0 +1,202 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NETDEV_IOB)
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The network still requires that a frame be contiguous in d_buf, so every
+ * frame must fit within a single I/O buffer.
+ */
+
+#if CONFIG_IOB_BUFSIZE < (MAX_NET_DEV_MTU + CONFIG_NET_GUARDSIZE)
+#  error CONFIG_IOB_BUFSIZE is too small to hold a full network frame
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device has an I/O buffer attached and point d_buf
+ *   at its data.  This should be called before devif_poll() or before a
+ *   received frame is written into d_buf.  An I/O buffer that is already
+ *   attached is reused.
+ *
+ * Input Parameters:
+ *   dev       - The device driver structure
+ *   throttled - An indication of the I/O buffer allocation throttle
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM is returned if no I/O buffer
+ *   is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+
+  if (iob == NULL)
+    {
+      iob = iob_tryalloc(throttled);
+      if (iob == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      dev->d_iob = iob;
+    }
+
+  iob->io_offset = 0;
+  dev->d_buf     = iob->io_data;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Detach the I/O buffer holding the d_len byte frame in d_buf from the
+ *   device.  The caller becomes the owner of the returned I/O buffer and
+ *   must call netdev_iob_prepare() again before d_buf is next used.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *
+ * Returned Value:
+ *   The detached I/O buffer or NULL if none was attached.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_release(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+
+  if (iob != NULL)
+    {
+      DEBUGASSERT(dev->d_buf == iob->io_data &&
+                  dev->d_len <= CONFIG_IOB_BUFSIZE);
+
+      iob->io_len    = dev->d_len;
+      iob->io_pktlen = dev->d_len;
+
+      dev->d_iob     = NULL;
+      dev->d_buf     = NULL;
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_replace
+ *
+ * Description:
+ *   Attach a received frame held in an I/O buffer chain to the device so
+ *   that it can be passed to the network via ipv4_input() and friends.
+ *   Any I/O buffer that was previously attached is freed.  A frame in a
+ *   single I/O buffer is attached without copying; a chain is first packed
+ *   into its head buffer.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *   iob - The received frame
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the frame is empty or cannot be held in
+ *   a single I/O buffer.  On failure, the caller still owns iob.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int netdev_iob_replace(FAR struct net_driver_s *dev, FAR struct iob_s *iob)
+{
+  uint16_t pktlen = iob->io_pktlen;
+
+  if (pktlen == 0 || pktlen > CONFIG_IOB_BUFSIZE)
+    {
+      return -EINVAL;
+    }
+
+  /* The network addresses the frame through d_buf and may build a reply
+   * of up to the MTU in place, so the data must start at the beginning of
+   * the head buffer.
+   */
+
+  if (iob->io_flink != NULL || iob->io_offset > 0)
+    {
+      iob = iob_pack(iob);
+    }
+
+  DEBUGASSERT(iob->io_flink == NULL && iob->io_len == pktlen);
+
+  if (dev->d_iob != NULL && dev->d_iob != iob)
+    {
+      iob_free_chain(dev->d_iob);
+    }
+
+  iob->io_pktlen = pktlen;
+  dev->d_iob     = iob;
+  dev->d_buf     = iob->io_data;
+  dev->d_len     = pktlen;
+  return OK;
+}
+
+#endif /* CONFIG_NET && CONFIG_NETDEV_IOB */
@@ -0,0 +1,216 @@
+/****************************************************************************
+ * net/netdev/netdev_napi.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NETDEV_NAPI)
+
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NETDEV_NAPI_BUDGET
+#  define CONFIG_NETDEV_NAPI_BUDGET 16
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_napi_work
+ *
+ * Description:
+ *   Receive one batch of frames with the network locked, then either stay
+ *   in poll mode or return the device to interrupt mode.
+ *
+ * Input Parameters:
+ *   arg - The batched receive state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void netdev_napi_work(FAR void *arg)
+{
+  FAR struct netdev_napi_s *napi = (FAR struct netdev_napi_s *)arg;
+  FAR struct net_driver_s *dev = napi->nn_dev;
+  irqstate_t flags;
+  int nrecvd;
+
+  net_lock();
+  nrecvd = napi->nn_poll(dev, CONFIG_NETDEV_NAPI_BUDGET);
+
+#ifdef CONFIG_NETDEV_STATISTICS
+  /* Account the batch in the power-of-two histogram */
+
+  dev->d_statistics.rx_batch[nrecvd > 0 ?
+                             MIN(fls(nrecvd), NETDEV_NBATCH - 1) : 0]++;
+#endif
+
+  net_unlock();
+
+  if (nrecvd >= CONFIG_NETDEV_NAPI_BUDGET)
+    {
+      /* The budget was used up, so more frames are likely pending.  Stay in
+       * poll mode, but go to the back of the work queue so that other work
+       * is not starved.
+       */
+
+      work_queue(napi->nn_qid, &napi->nn_work, netdev_napi_work, napi, 0);
+    }
+  else
+    {
+      /* The device is drained.  Return to interrupt mode. */
+
+      flags = enter_critical_section();
+      napi->nn_sched = false;
+      napi->nn_rxint(dev, true);
+      leave_critical_section(flags);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_napi_initialize
+ *
+ * Description:
+ *   Initialize the batched receive state of a device.
+ *
+ * Input Parameters:
+ *   napi  - The batched receive state to initialize
+ *   dev   - The device driver structure
+ *   qid   - The work queue on which frames are received (HPWORK or LPWORK)
+ *   poll  - The driver receive method
+ *   rxint - The driver RX interrupt control method
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_initialize(FAR struct netdev_napi_s *napi,
+                            FAR struct net_driver_s *dev, int qid,
+                            netdev_napi_poll_t poll,
+                            netdev_napi_rxint_t rxint)
+{
+  DEBUGASSERT(napi != NULL && dev != NULL && poll != NULL && rxint != NULL);
+
+  memset(napi, 0, sizeof(struct netdev_napi_s));
+  napi->nn_dev   = dev;
+  napi->nn_poll  = poll;
+  napi->nn_rxint = rxint;
+  napi->nn_qid   = qid;
+}
+
+/****************************************************************************
+ * Name: netdev_napi_schedule
+ *
+ * Description:
+ *   Switch the device to poll mode: mask the RX interrupt and schedule a
+ *   receive poll on the work queue.  Nothing is done if a poll is already
+ *   pending.  This is normally called from the RX interrupt handler.
+ *
+ * Input Parameters:
+ *   napi - The batched receive state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_schedule(FAR struct netdev_napi_s *napi)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!napi->nn_sched)
+    {
+      napi->nn_sched = true;
+      napi->nn_rxint(napi->nn_dev, false);
+      work_queue(napi->nn_qid, &napi->nn_work, netdev_napi_work, napi, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: netdev_napi_cancel
+ *
+ * Description:
+ *   Cancel any pending receive poll, e.g. when the interface is brought
+ *   down.  The RX interrupt is left masked.
+ *
+ * Input Parameters:
+ *   napi - The batched receive state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_cancel(FAR struct netdev_napi_s *napi)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  napi->nn_rxint(napi->nn_dev, false);
+  (void)work_cancel(napi->nn_qid, &napi->nn_work);
+  napi->nn_sched = false;
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_NET && CONFIG_NETDEV_NAPI */
@@ -76,6 +76,10 @@ static int netprocfs_rxstatistics_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxstatistics(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NETDEV_NAPI
+static int netprocfs_rxbatch_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_rxbatch(FAR struct netprocfs_file_s *netfile);
+#endif
 static int netprocfs_txstatistics_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_errors(FAR struct netprocfs_file_s *netfile);
@@ -106,6 +110,10 @@ static const linegen_t g_netstat_linegen[] =
   netprocfs_rxstatistics,
   netprocfs_rxpackets_header,
   netprocfs_rxpackets,
+#ifdef CONFIG_NETDEV_NAPI
+  netprocfs_rxbatch_header,
+  netprocfs_rxbatch,
+#endif
   netprocfs_txstatistics_header,
   netprocfs_txstatistics,
   netprocfs_errors
@@ -495,6 +503,49 @@ static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
+/****************************************************************************
+ * Name: netprocfs_rxbatch_header
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_NAPI)
+static int netprocfs_rxbatch_header(FAR struct netprocfs_file_s *netfile)
+{
+  DEBUGASSERT(netfile != NULL);
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\tRX batches: %-7s %-7s %-7s %-7s %-7s %-7s %-7s\n",
+                  "0", "1", "2-3", "4-7", "8-15", "16-31", "32+");
+}
+#endif /* CONFIG_NETDEV_STATISTICS && CONFIG_NETDEV_NAPI */
+
+/****************************************************************************
+ * Name: netprocfs_rxbatch
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_NAPI)
+static int netprocfs_rxbatch(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct netdev_statistics_s *stats;
+  FAR struct net_driver_s *dev;
+  int len;
+  int i;
+
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+  dev = netfile->dev;
+  stats = &dev->d_statistics;
+
+  len = snprintf(netfile->line, NET_LINELEN, "\t           ");
+  for (i = 0; i < NETDEV_NBATCH; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %07lx",
+                      (unsigned long)stats->rx_batch[i]);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+#endif /* CONFIG_NETDEV_STATISTICS && CONFIG_NETDEV_NAPI */
+
 /****************************************************************************
  * Name: netprocfs_txstatistics_header
  ****************************************************************************/
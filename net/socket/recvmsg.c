@@ -0,0 +1,343 @@
+/****************************************************************************
+ * net/socket/recvmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: recvmsg_iovlen
+ *
+ * Description:
+ *   Validate the I/O vector of a message and return its total length.
+ *
+ ****************************************************************************/
+
+static ssize_t recvmsg_iovlen(FAR const struct msghdr *msg)
+{
+  size_t total = 0;
+  int i;
+
+  if (msg == NULL || msg->msg_iovlen < 0 ||
+      (msg->msg_iov == NULL && msg->msg_iovlen > 0))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < msg->msg_iovlen; i++)
+    {
+      if (msg->msg_iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += msg->msg_iov[i].iov_len;
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: recvmsg_maxdgram
+ *
+ * Description:
+ *   Return the size of the largest datagram that the socket can receive.
+ *   Without IP reassembly, a packet or IP datagram is no larger than the
+ *   largest device MTU.  Other datagrams, such as those of local sockets,
+ *   have 16-bit lengths.
+ *
+ ****************************************************************************/
+
+static size_t recvmsg_maxdgram(FAR struct socket *psock)
+{
+#if !defined(CONFIG_NET_USRSOCK) && \
+    (defined(CONFIG_NET_IPv4) || defined(CONFIG_NET_IPv6))
+  if (psock->s_domain == PF_INET || psock->s_domain == PF_INET6)
+    {
+      return MAX_NET_DEV_MTU;
+    }
+#endif
+
+#ifdef CONFIG_NET_PKT
+  if (psock->s_domain == PF_PACKET)
+    {
+      return MAX_NET_DEV_MTU;
+    }
+#endif
+
+  return UINT16_MAX;
+}
+
+/****************************************************************************
+ * Name: recvmsg_stream
+ *
+ * Description:
+ *   Fill the vectors of a message in turn from a stream socket.  Only the
+ *   first receive may block; the remaining vectors are filled only with
+ *   data that is already available, by receiving with MSG_DONTWAIT.
+ *
+ ****************************************************************************/
+
+static ssize_t recvmsg_stream(FAR struct socket *psock,
+                              FAR struct msghdr *msg, int flags,
+                              FAR socklen_t *fromlen)
+{
+  FAR struct sockaddr *from = (FAR struct sockaddr *)msg->msg_name;
+  ssize_t total = 0;
+  ssize_t nrecvd;
+  int i;
+
+  for (i = 0; i < msg->msg_iovlen; i++)
+    {
+      if (msg->msg_iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nrecvd = psock_recvfrom(psock, msg->msg_iov[i].iov_base,
+                              msg->msg_iov[i].iov_len, flags, from,
+                              fromlen);
+      if (nrecvd < 0)
+        {
+          if (total == 0)
+            {
+              total = nrecvd;
+            }
+
+          break;
+        }
+
+      total += nrecvd;
+      if ((size_t)nrecvd < msg->msg_iov[i].iov_len)
+        {
+          break;
+        }
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+      /* Local stream sockets do not support MSG_DONTWAIT */
+
+      if (psock->s_domain == PF_LOCAL)
+        {
+          break;
+        }
+#endif
+
+      /* Something was received:  Do not wait for more */
+
+      flags  |= MSG_DONTWAIT;
+      from    = NULL;
+      fromlen = NULL;
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives data into the msg_iov array of 'msg'.  A
+ *   stream socket fills the vectors in turn while data is available; a
+ *   datagram socket scatters one datagram across the vectors.  This is an
+ *   internal OS interface that is functionally equivalent to recvmsg()
+ *   except that it is not a cancellation point and it does not modify the
+ *   errno variable.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Message to receive into
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On any
+ *   failure, a negated errno value is returned (see comments with
+ *   recvfrom() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  FAR socklen_t *fromlen;
+  FAR uint8_t *buffer;
+  ssize_t total;
+  ssize_t nrecvd;
+  size_t ncopy;
+  size_t offset;
+  int i;
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  total = recvmsg_iovlen(msg);
+  if (total < 0)
+    {
+      return total;
+    }
+
+  /* Ancillary data is not supported */
+
+  msg->msg_controllen = 0;
+  msg->msg_flags      = 0;
+  fromlen             = msg->msg_name != NULL ? &msg->msg_namelen : NULL;
+
+  /* A single vector needs no scattering */
+
+  if (msg->msg_iovlen == 1)
+    {
+      return psock_recvfrom(psock, msg->msg_iov[0].iov_base,
+                            msg->msg_iov[0].iov_len, flags,
+                            (FAR struct sockaddr *)msg->msg_name, fromlen);
+    }
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      return recvmsg_stream(psock, msg, flags, fromlen);
+    }
+
+  /* Message boundaries must be preserved:  Receive one datagram into a
+   * buffer large enough for all vectors, then scatter it.  The buffer need
+   * not be larger than the largest datagram.
+   */
+
+  if ((size_t)total > recvmsg_maxdgram(psock))
+    {
+      total = recvmsg_maxdgram(psock);
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(total > 0 ? total : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nrecvd = psock_recvfrom(psock, buffer, total, flags,
+                          (FAR struct sockaddr *)msg->msg_name, fromlen);
+
+  for (i = 0, offset = 0; nrecvd > 0 && offset < (size_t)nrecvd &&
+       i < msg->msg_iovlen; i++)
+    {
+      ncopy = nrecvd - offset;
+      if (ncopy > msg->msg_iov[i].iov_len)
+        {
+          ncopy = msg->msg_iov[i].iov_len;
+        }
+
+      memcpy(msg->msg_iov[i].iov_base, &buffer[offset], ncopy);
+      offset += ncopy;
+    }
+
+  kmm_free(buffer);
+  return nrecvd;
+}
+
+/****************************************************************************
+ * Name: recvmsg
+ *
+ * Description:
+ *   recvmsg() receives a message from a socket.  The data is scattered
+ *   across the msg_iov array of 'msg' and, if msg_name is not NULL, the
+ *   source address is returned there.  Ancillary data is not supported:
+ *   msg_controllen is always set to zero.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - Message to receive into
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On error, -1
+ *   is returned, and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* recvmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_recvmsg do all of the work */
+
+  ret = psock_recvmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
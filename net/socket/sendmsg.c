@@ -0,0 +1,253 @@
+/****************************************************************************
+ * net/socket/sendmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendmsg_iovlen
+ *
+ * Description:
+ *   Validate the I/O vector of a message and return its total length.
+ *
+ ****************************************************************************/
+
+static ssize_t sendmsg_iovlen(FAR const struct msghdr *msg)
+{
+  size_t total = 0;
+  int i;
+
+  if (msg == NULL || msg->msg_iovlen < 0 ||
+      (msg->msg_iov == NULL && msg->msg_iovlen > 0))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < msg->msg_iovlen; i++)
+    {
+      if (msg->msg_iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += msg->msg_iov[i].iov_len;
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends the data gathered from the msg_iov array of
+ *   'msg'.  A stream socket sends each vector in turn; a datagram socket
+ *   sends all vectors as a single datagram.  This is an internal OS
+ *   interface that is functionally equivalent to sendmsg() except that it
+ *   is not a cancellation point and it does not modify the errno variable.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned (See comments with sendto() for a list
+ *   of the appropriate errno value).
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
+                      int flags)
+{
+  FAR const struct sockaddr *to;
+  FAR uint8_t *buffer;
+  ssize_t total;
+  ssize_t nsent;
+  int i;
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  total = sendmsg_iovlen(msg);
+  if (total < 0)
+    {
+      return total;
+    }
+
+  to = (FAR const struct sockaddr *)msg->msg_name;
+
+  /* A single vector needs no gathering */
+
+  if (msg->msg_iovlen == 1)
+    {
+      return psock_sendto(psock, msg->msg_iov[0].iov_base,
+                          msg->msg_iov[0].iov_len, flags, to,
+                          msg->msg_namelen);
+    }
+
+  if (psock->s_type == SOCK_STREAM)
+    {
+      /* Send each vector in turn.  Stop at the first vector that is not
+       * accepted in full.
+       */
+
+      total = 0;
+      for (i = 0; i < msg->msg_iovlen; i++)
+        {
+          if (msg->msg_iov[i].iov_len == 0)
+            {
+              continue;
+            }
+
+          nsent = psock_sendto(psock, msg->msg_iov[i].iov_base,
+                               msg->msg_iov[i].iov_len, flags, to,
+                               msg->msg_namelen);
+          if (nsent < 0)
+            {
+              return total > 0 ? total : nsent;
+            }
+
+          total += nsent;
+          if ((size_t)nsent < msg->msg_iov[i].iov_len)
+            {
+              break;
+            }
+        }
+
+      return total;
+    }
+
+  /* Message boundaries must be preserved:  Gather the vectors into one
+   * buffer and send it as one datagram.
+   */
+
+  buffer = (FAR uint8_t *)kmm_malloc(total > 0 ? total : 1);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0, nsent = 0; i < msg->msg_iovlen; i++)
+    {
+      memcpy(&buffer[nsent], msg->msg_iov[i].iov_base,
+             msg->msg_iov[i].iov_len);
+      nsent += msg->msg_iov[i].iov_len;
+    }
+
+  nsent = psock_sendto(psock, buffer, total, flags, to, msg->msg_namelen);
+  kmm_free(buffer);
+  return nsent;
+}
+
+/****************************************************************************
+ * Name: sendmsg
+ *
+ * Description:
+ *   sendmsg() sends a message on a socket.  The data is gathered from the
+ *   msg_iov array of 'msg' and, for an unconnected socket, sent to the
+ *   address in msg_name.  Ancillary data is not supported and msg_control
+ *   is ignored.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - Message to send
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On error, -1 is
+ *   returned, and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+ssize_t sendmsg(int sockfd, FAR const struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* sendmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_sendmsg do all of the work */
+
+  ret = psock_sendmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      set_errno((int)-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -57,6 +57,23 @@
 
 #define NET_TCP_HAVE_STACK 1
 
+/* Connection hash tables */
+
+#ifndef CONFIG_NET_TCP_HASHSIZE
+#  define CONFIG_NET_TCP_HASHSIZE 8
+#endif
+
+#if CONFIG_NET_TCP_HASHSIZE < 1 || \
+    (CONFIG_NET_TCP_HASHSIZE & (CONFIG_NET_TCP_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_TCP_HASHSIZE must be a power of two
+#endif
+
+/* Number of segments that a connection may send per device poll */
+
+#ifndef CONFIG_NET_TCP_SEND_BURST
+#  define CONFIG_NET_TCP_SEND_BURST 1
+#endif
+
 /* Conditions for support TCP poll/select operations */
 
 #if !defined(CONFIG_DISABLE_POLL) && CONFIG_NSOCKET_DESCRIPTORS > 0 && \
@@ -100,6 +117,27 @@
 #  endif
 #endif
 
+/* Sequence number comparisons that are correct across wrap-around */
+
+#define TCP_SEQ_LT(a,b)   ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_LTE(a,b)  ((int32_t)((a) - (b)) <= 0)
+#define TCP_SEQ_GT(a,b)   ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GTE(a,b)  ((int32_t)((a) - (b)) >= 0)
+
+/* Options negotiated in the SYN exchange (struct tcp_conn_s optflags) */
+
+#define TCP_OPTF_WS        (1 << 0) /* Window scaling is in use */
+#define TCP_OPTF_SACK      (1 << 1) /* The peer may send SACK blocks */
+
+/* Maximum number of SACK blocks retained from one ACK */
+
+#define TCP_SACK_NBLOCKS   4
+
+/* Congestion control events reported to tcp_cc_ops_s::loss() */
+
+#define TCP_CC_DUPACK      0        /* Third duplicate ACK */
+#define TCP_CC_TIMEOUT     1        /* Retransmission time-out */
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -117,10 +155,57 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_conn_s;        /* Forward reference */
+
+#ifdef CONFIG_NET_TCP_SACK
+/* One block of out-of-order data received by the peer */
+
+struct tcp_sack_s
+{
+  uint32_t left;          /* First sequence number of the block */
+  uint32_t right;         /* Sequence number just past the block */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+/* Congestion control algorithm.  Each algorithm adjusts conn->cwnd and
+ * conn->ssthresh.  Duplicate ACK counting and fast recovery are common to
+ * all algorithms and are handled by tcp_cc_ack().
+ *
+ *   name - Name used with the TCP_CONGESTION socket option
+ *   init - Called when the connection is established
+ *   ack  - Called outside of fast recovery when 'acked' bytes of new data
+ *          have been acknowledged
+ *   loss - Called on a loss event (TCP_CC_DUPACK or TCP_CC_TIMEOUT) to set
+ *          the new ssthresh.  The caller sets cwnd afterward.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE void (*ack)(FAR struct tcp_conn_s *conn, uint32_t acked);
+  CODE void (*loss)(FAR struct tcp_conn_s *conn, int event);
+};
+
+/* Private state of the CUBIC algorithm */
+
+struct tcp_cubic_s
+{
+  systime_t epoch;        /* Start of the current growth epoch (0: none) */
+  uint32_t  wmax;         /* Window before the last reduction (bytes) */
+  uint32_t  k;            /* Time to grow back to wmax (msec) */
+  uint32_t  west;         /* Reno-equivalent window estimate (bytes) */
+};
+#endif
 
 struct tcp_conn_s
 {
   dq_entry_t node;        /* Implements a doubly linked list */
+  FAR struct tcp_conn_s *hnext; /* Next active connection in the same
+                                 * address/port hash bucket */
+  FAR struct tcp_conn_s *pnext; /* Next bound connection in the same
+                                 * local port hash bucket */
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -142,12 +227,56 @@ struct tcp_conn_s
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current window size of the connection */
+#else
   uint16_t winsize;       /* Current window size of the connection */
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t unacked;       /* Number bytes sent but not yet ACKed */
 #else
   uint16_t unacked;       /* Number bytes sent but not yet ACKed */
 #endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+  uint8_t  optflags;      /* Negotiated options.  See TCP_OPTF_* */
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint8_t  snd_scale;     /* Shift count of the peer's window */
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* SACK blocks from the most recent ACK, valid until processed by the
+   * send logic.
+   */
+
+  uint8_t  nsacks;        /* Number of valid entries in sacks[] */
+  struct tcp_sack_s sacks[TCP_SACK_NBLOCKS];
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control.  All window sizes are in bytes.
+   *
+   *   cc       - The selected algorithm (NULL until established)
+   *   cwnd     - Congestion window
+   *   ssthresh - Slow start threshold
+   *   snduna   - Oldest unacknowledged sequence number
+   *   recover  - Highest sequence number sent when recovery began
+   *   dupacks  - Number of consecutive duplicate ACKs
+   *   recovery - True while in fast recovery
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t   cwnd;
+  uint32_t   ssthresh;
+  uint32_t   snduna;
+  uint32_t   recover;
+  uint8_t    dupacks;
+  bool       recovery;
+  union
+  {
+    struct tcp_cubic_s cubic;
+  } ccpriv;
+#endif
 
   /* If the TCP socket is bound to a local address, then this is
    * a reference to the device that routes traffic on the corresponding
@@ -215,6 +344,20 @@ struct tcp_conn_s
   uint8_t    keepretries; /* Number of retries attempted */
 #endif
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* Delayed ACK */
+
+  systime_t  rx_acktime;  /* Time when the oldest un-ACKed segment arrived */
+  uint8_t    rx_unackseg; /* Number of received segments not yet ACKed */
+#endif
+
+#ifdef CONFIG_NET_TCP_NAGLE
+  /* Nagle algorithm */
+
+  bool       nodelay;     /* TCP_NODELAY: Don't hold back partial segments */
+  bool       cork;        /* TCP_CORK: Hold back all partial segments */
+#endif
+
   /* Application callbacks:
    *
    * Data transfer events are retained in 'list'.  Event handlers in 'list'
@@ -271,6 +414,9 @@ struct tcp_wrbuffer_s
   uint16_t   wb_sent;      /* Number of bytes sent from the I/O buffer chain */
   uint8_t    wb_nrtx;      /* The number of retransmissions for the last
                             * segment sent */
+#ifdef CONFIG_NET_TCP_SACK
+  bool       wb_sacked;    /* The peer holds all of the data (SACKed) */
+#endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
 #endif
@@ -318,6 +464,13 @@ extern "C"
 EXTERN struct net_driver_s *g_netdevices;
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* Congestion control algorithms (tcp_cc_newreno.c and tcp_cc_cubic.c) */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_newreno;
+EXTERN const struct tcp_cc_ops_s g_tcp_cubic;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1287,6 +1440,29 @@ struct socket;
 ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+/****************************************************************************
+ * Name: psock_tcp_sendiob
+ *
+ * Description:
+ *   Queue a caller-provided I/O buffer chain for transmission on a
+ *   connected TCP socket without copying it.  On success, the chain
+ *   belongs to the network.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iob      The I/O buffer chain to send.
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  On failure, a negated
+ *   errno value is returned and the caller still owns the chain.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IOB_LOAN) && defined(CONFIG_NET_TCP_WRITE_BUFFERS)
+struct iob_s;
+ssize_t psock_tcp_sendiob(FAR struct socket *psock, FAR struct iob_s *iob);
+#endif
+
 /****************************************************************************
  * Name: tcp_setsockopt
  *
@@ -1418,6 +1594,30 @@ struct tcp_wrbuffer_s;
 FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void);
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_wrbuffer_tryalloc
+ *
+ * Description:
+ *   Allocate a TCP write buffer without waiting and without an initial I/O
+ *   buffer.  This is used when the caller already has the I/O buffer chain
+ *   to be sent.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The write buffer with wb_iob set to NULL, or NULL if no write buffer is
+ *   available.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_NET_IOB_LOAN)
+FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void);
+#endif
+
 /****************************************************************************
  * Name: tcp_wrbuffer_release
  *
@@ -1467,6 +1667,177 @@ void tcp_wrbuffer_dump(FAR const char *msg, FAR struct tcp_wrbuffer_s *wrb,
 #endif
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.  On
+ *   an established connection the new algorithm takes over the current
+ *   congestion window; only its private state is initialized.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *   name - The name of the algorithm ("newreno" or "cubic")
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if no algorithm has that name.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *   This is the default algorithm if none has been selected yet.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The name of the algorithm.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Set up the congestion window of a newly established connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection; conn->isn and conn->mss must be valid
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion state for an incoming ACK.  New data grows the
+ *   window through the selected algorithm; the third duplicate ACK enters
+ *   fast recovery (RFC 6582).
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   ackno - The acknowledgement number of the segment
+ *   pure  - True if the segment carried no data and no window change, i.e.
+ *           it may count as a duplicate ACK
+ *
+ * Returned Value:
+ *   True if the oldest unacknowledged segment should be retransmitted now
+ *   (fast retransmit, or a partial ACK during recovery).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool pure);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission time-out.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_sndwnd
+ *
+ * Description:
+ *   Return the number of new bytes the congestion window allows to be sent.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The usable congestion window in bytes (zero if it is full).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_sndwnd(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_delack
+ *
+ * Description:
+ *   Decide whether the ACK of a newly received data segment may be
+ *   delayed.  The first segment starts the delayed ACK timer; the second
+ *   one must be ACKed immediately (RFC 1122, 4.2.3.2).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection that received the data
+ *
+ * Returned Value:
+ *   True if the ACK may be delayed; false if it must be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+bool tcp_delack(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_delack_expired
+ *
+ * Description:
+ *   Check if a delayed ACK of the connection is due.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   True if an ACK is pending and its delay has elapsed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+bool tcp_delack_expired(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_pollsetup
  *
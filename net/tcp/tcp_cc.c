@@ -0,0 +1,358 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCP_CC)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <netinet/tcp.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/net.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Number of duplicate ACKs that trigger a fast retransmission */
+
+#define TCP_CC_DUPTHRESH  3
+
+/* Upper bound of the initial window (RFC 3390) */
+
+#define TCP_CC_IW_MAX     4380
+
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+#  define TCP_CC_DEFAULT  (&g_tcp_cubic)
+#else
+#  define TCP_CC_DEFAULT  (&g_tcp_newreno)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All available congestion control algorithms */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algorithms[] =
+{
+  &g_tcp_newreno,
+  &g_tcp_cubic
+};
+
+#define TCP_CC_NALGORITHMS \
+  (sizeof(g_tcp_cc_algorithms) / sizeof(g_tcp_cc_algorithms[0]))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.  On
+ *   an established connection the new algorithm takes over the current
+ *   congestion window; only its private state is initialized.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *   name - The name of the algorithm ("newreno" or "cubic")
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if no algorithm has that name.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  unsigned int i;
+
+  for (i = 0; i < TCP_CC_NALGORITHMS; i++)
+    {
+      ops = g_tcp_cc_algorithms[i];
+      if (strncmp(ops->name, name, TCP_CA_NAME_MAX) == 0)
+        {
+          conn->cc = ops;
+
+          /* The generic window state (cwnd, ssthresh) carries over, only
+           * the private state of the new algorithm has to be set up.
+           */
+
+          if (conn->cwnd > 0 && ops->init != NULL)
+            {
+              ops->init(conn);
+            }
+
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *   This is the default algorithm if none has been selected yet.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The name of the algorithm.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn)
+{
+  return conn->cc != NULL ? conn->cc->name : TCP_CC_DEFAULT->name;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Set up the congestion window of a newly established connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection; conn->isn and conn->mss must be valid
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  uint32_t mss = conn->mss;
+
+  if (conn->cc == NULL)
+    {
+      conn->cc = TCP_CC_DEFAULT;
+    }
+
+  /* Initial window per RFC 3390 */
+
+  conn->cwnd     = MIN(4 * mss, MAX(2 * mss, TCP_CC_IW_MAX));
+  conn->ssthresh = UINT32_MAX;
+  conn->snduna   = conn->isn;
+  conn->recover  = conn->isn;
+  conn->dupacks  = 0;
+  conn->recovery = false;
+
+  if (conn->cc->init != NULL)
+    {
+      conn->cc->init(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion state for an incoming ACK.  New data grows the
+ *   window through the selected algorithm; the third duplicate ACK enters
+ *   fast recovery (RFC 6582).
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   ackno - The acknowledgement number of the segment
+ *   pure  - True if the segment carried no data and no window change, i.e.
+ *           it may count as a duplicate ACK
+ *
+ * Returned Value:
+ *   True if the oldest unacknowledged segment should be retransmitted now
+ *   (fast retransmit, or a partial ACK during recovery).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool pure)
+{
+  uint32_t acked;
+
+  if (conn->cc == NULL)
+    {
+      return false;
+    }
+
+  if (TCP_SEQ_GT(ackno, conn->snduna))
+    {
+      /* New data has been acknowledged */
+
+      acked          = ackno - conn->snduna;
+      conn->snduna   = ackno;
+      conn->dupacks  = 0;
+
+      if (!conn->recovery)
+        {
+          conn->cc->ack(conn, acked);
+          return false;
+        }
+
+      if (TCP_SEQ_GTE(ackno, conn->recover))
+        {
+          /* A full acknowledgement ends fast recovery.  Deflate the window
+           * to what is still in flight plus one segment.
+           */
+
+          conn->cwnd     = MIN(conn->ssthresh, conn->unacked + conn->mss);
+          conn->recovery = false;
+          return false;
+        }
+
+      /* A partial acknowledgement:  The next segment was lost as well.
+       * Deflate the window by the amount acknowledged and retransmit.
+       */
+
+      conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+      if (acked >= conn->mss || conn->cwnd < conn->mss)
+        {
+          conn->cwnd += conn->mss;
+        }
+
+      return true;
+    }
+
+  if (pure && ackno == conn->snduna && conn->unacked > 0)
+    {
+      /* A duplicate ACK:  The peer has received a segment out of order */
+
+      if (conn->recovery)
+        {
+          /* Each further duplicate means a segment has left the network */
+
+          conn->cwnd += conn->mss;
+          return false;
+        }
+
+      if (conn->dupacks < TCP_CC_DUPTHRESH &&
+          ++conn->dupacks == TCP_CC_DUPTHRESH &&
+          TCP_SEQ_GT(ackno, conn->recover))
+        {
+          /* Fast retransmit and enter fast recovery */
+
+          conn->cc->loss(conn, TCP_CC_DUPACK);
+          conn->recover  = conn->sndseq_max;
+          conn->recovery = true;
+          conn->cwnd     = conn->ssthresh + TCP_CC_DUPTHRESH * conn->mss;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission time-out.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cc == NULL)
+    {
+      return;
+    }
+
+  conn->cc->loss(conn, TCP_CC_TIMEOUT);
+
+  /* Restart in slow start from one segment.  Duplicate ACKs for data sent
+   * before the time-out must not start another fast recovery.
+   */
+
+  conn->cwnd     = conn->mss;
+  conn->recover  = conn->sndseq_max;
+  conn->dupacks  = 0;
+  conn->recovery = false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sndwnd
+ *
+ * Description:
+ *   Return the number of new bytes the congestion window allows to be sent.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The usable congestion window in bytes (zero if it is full).
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_sndwnd(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cc == NULL)
+    {
+      return UINT32_MAX;
+    }
+
+  return conn->cwnd > conn->unacked ? conn->cwnd - conn->unacked : 0;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC */
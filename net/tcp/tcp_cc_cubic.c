@@ -0,0 +1,252 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCP_CC)
+
+#include <stdint.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/net.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CUBIC parameters (RFC 8312) use beta = 0.7 and C = 0.4.  All arithmetic
+ * is done with integers, windows in bytes and time in milliseconds.
+ *
+ *   CUBIC_K3_SCALE   - 1 / C in msec^3 per second^3:  K^3 = W * 2.5 sec^3
+ *   CUBIC_OFFS_MAX   - Limit of |t - K| so that the cube cannot overflow
+ */
+
+#define CUBIC_BETA_NUM      7
+#define CUBIC_BETA_DEN      10
+#define CUBIC_K3_SCALE      2500000000ull
+#define CUBIC_OFFS_MAX      60000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void cubic_loss(FAR struct tcp_conn_s *conn, int event);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cubic =
+{
+  "cubic",         /* name */
+  cubic_init,      /* init */
+  cubic_ack,       /* ack */
+  cubic_loss       /* loss */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->ccpriv.cubic;
+
+  cubic->epoch = 0;
+  cubic->wmax  = 0;
+  cubic->k     = 0;
+  cubic->west  = 0;
+}
+
+/****************************************************************************
+ * Name: cubic_ack
+ *
+ * Description:
+ *   Grow the congestion window along the cubic function of the time since
+ *   the last reduction, but never slower than standard TCP would.
+ *
+ ****************************************************************************/
+
+static void cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->ccpriv.cubic;
+  uint32_t mss = conn->mss;
+  uint64_t target;
+  int64_t delta;
+  int64_t offs;
+  systime_t now;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start */
+
+      conn->cwnd += MIN(acked, mss);
+      return;
+    }
+
+  now = clock_systimer();
+  if (cubic->epoch == 0)
+    {
+      /* First ACK of a new congestion avoidance epoch */
+
+      cubic->epoch = now != 0 ? now : 1;
+      if (conn->cwnd < cubic->wmax)
+        {
+          /* K = cbrt((W_max - cwnd) / C), scaled in two steps so that
+           * the intermediate product cannot overflow.
+           */
+
+          cubic->k = cubic_cbrt((uint64_t)(cubic->wmax - conn->cwnd) * 2500 /
+                                mss * (CUBIC_K3_SCALE / 2500));
+        }
+      else
+        {
+          cubic->k = 0;
+          cubic->wmax = conn->cwnd;
+        }
+
+      cubic->west = conn->cwnd;
+    }
+
+  /* W_cubic(t) = C * (t - K)^3 + W_max */
+
+  offs = (int64_t)TICK2MSEC(now - cubic->epoch) - cubic->k;
+  if (offs > CUBIC_OFFS_MAX)
+    {
+      offs = CUBIC_OFFS_MAX;
+    }
+  else if (offs < -CUBIC_OFFS_MAX)
+    {
+      offs = -CUBIC_OFFS_MAX;
+    }
+
+  delta  = offs * offs * offs / 1000000 * mss * 4 / 10000;
+  target = (int64_t)cubic->wmax + delta > 0 ?
+           (uint64_t)((int64_t)cubic->wmax + delta) : 0;
+
+  /* Never more than 1.5 times the current window per round trip */
+
+  target = MIN(target, (uint64_t)conn->cwnd * 3 / 2);
+  if (target > conn->cwnd)
+    {
+      conn->cwnd += (uint32_t)((target - conn->cwnd) * acked / conn->cwnd);
+    }
+
+  /* TCP friendly region:  Track the window standard TCP would have
+   * reached, growing by 3 * (1 - beta) / (1 + beta) segments per RTT.
+   */
+
+  cubic->west += (uint32_t)((uint64_t)acked * mss * 9 / 17 / conn->cwnd);
+  if (cubic->west > conn->cwnd)
+    {
+      conn->cwnd = cubic->west;
+    }
+}
+
+/****************************************************************************
+ * Name: cubic_loss
+ *
+ * Description:
+ *   Reduce the slow start threshold by beta and remember the window at
+ *   the time of the loss.
+ *
+ ****************************************************************************/
+
+static void cubic_loss(FAR struct tcp_conn_s *conn, int event)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->ccpriv.cubic;
+  uint64_t cwnd = conn->cwnd;
+
+  /* Fast convergence:  Release bandwidth sooner if the window has shrunk
+   * since the last loss.
+   */
+
+  if (cwnd < cubic->wmax)
+    {
+      cubic->wmax = (uint32_t)(cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+                               (2 * CUBIC_BETA_DEN));
+    }
+  else
+    {
+      cubic->wmax = (uint32_t)cwnd;
+    }
+
+  conn->ssthresh = MAX((uint32_t)(cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN),
+                       2 * (uint32_t)conn->mss);
+  cubic->epoch   = 0;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC */
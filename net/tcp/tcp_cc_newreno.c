@@ -0,0 +1,118 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_newreno.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCP_CC)
+
+#include <stdint.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/net.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void newreno_loss(FAR struct tcp_conn_s *conn, int event);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_newreno =
+{
+  "newreno",       /* name */
+  NULL,            /* init */
+  newreno_ack,     /* ack */
+  newreno_loss     /* loss */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_ack
+ *
+ * Description:
+ *   Grow the congestion window for newly acknowledged data (RFC 5681):
+ *   by up to one segment per ACK in slow start, and by about one segment
+ *   per round trip in congestion avoidance.
+ *
+ ****************************************************************************/
+
+static void newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t mss = conn->mss;
+  uint32_t incr;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      incr = MIN(acked, mss);
+    }
+  else
+    {
+      incr = MAX(mss * mss / conn->cwnd, 1);
+    }
+
+  if (conn->cwnd <= UINT32_MAX - incr)
+    {
+      conn->cwnd += incr;
+    }
+}
+
+/****************************************************************************
+ * Name: newreno_loss
+ *
+ * Description:
+ *   Halve the amount of data in flight to get the new slow start
+ *   threshold.
+ *
+ ****************************************************************************/
+
+static void newreno_loss(FAR struct tcp_conn_s *conn, int event)
+{
+  conn->ssthresh = MAX(conn->unacked / 2, 2 * (uint32_t)conn->mss);
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_CC */
@@ -72,6 +72,8 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#define TCP_HASH_MASK (CONFIG_NET_TCP_HASHSIZE - 1)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -88,6 +90,16 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+/* Active connections hashed by local port, remote port and remote IP
+ * address.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_HASHSIZE];
+
+/* Connections bound to a local port, hashed by local port */
+
+static FAR struct tcp_conn_s *g_tcp_porthash[CONFIG_NET_TCP_HASHSIZE];
+
 /* Last port used by a TCP connection connection. */
 
 static uint16_t g_last_tcp_port;
@@ -96,6 +108,163 @@ static uint16_t g_last_tcp_port;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_portndx and tcp_connndx
+ *
+ * Description:
+ *   Return the index of the hash bucket for a local port number or for the
+ *   local port, remote port, and (folded) remote IP address of an active
+ *   connection.  All values are in network byte order.
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_portndx(uint16_t portno)
+{
+  return (portno ^ (portno >> 8)) & TCP_HASH_MASK;
+}
+
+static inline unsigned int tcp_connndx(uint16_t lport, uint16_t rport,
+                                       uint32_t raddr)
+{
+  uint32_t hash = raddr ^ ((uint32_t)lport << 16) ^ rport;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash & TCP_HASH_MASK;
+}
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *ipaddr)
+{
+  return ((uint32_t)(ipaddr[0] ^ ipaddr[2] ^ ipaddr[4] ^ ipaddr[6]) << 16) |
+         (uint32_t)(ipaddr[1] ^ ipaddr[3] ^ ipaddr[5] ^ ipaddr[7]);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_bucket
+ *
+ * Description:
+ *   Return the address/port hash bucket that holds an active connection.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s **tcp_conn_bucket(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      ndx = tcp_connndx(conn->lport, conn->rport, conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      ndx = tcp_connndx(conn->lport, conn->rport,
+                        tcp_ipv6_fold(conn->u.ipv6.raddr));
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  return &g_tcp_connhash[ndx];
+}
+
+/****************************************************************************
+ * Name: tcp_activate and tcp_deactivate
+ *
+ * Description:
+ *   Add a connection to, or remove it from, the list of active connections
+ *   and the address/port hash table.  The local and remote addresses and
+ *   ports of the connection must not change while it is active.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_activate(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **bucket = tcp_conn_bucket(conn);
+
+  conn->hnext = *bucket;
+  *bucket     = conn;
+
+  dq_addlast(&conn->node, &g_active_tcp_connections);
+}
+
+static void tcp_deactivate(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = tcp_conn_bucket(conn); *link != NULL; link = &(*link)->hnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->hnext;
+          break;
+        }
+    }
+
+  conn->hnext = NULL;
+  dq_rem(&conn->node, &g_active_tcp_connections);
+}
+
+/****************************************************************************
+ * Name: tcp_port_unlink and tcp_setport
+ *
+ * Description:
+ *   Maintain the local port hash table.  Every connection that is not
+ *   closed and has a non-zero local port is in the table.  tcp_setport()
+ *   changes the local port (network byte order) of a connection and moves
+ *   it to the corresponding bucket.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_port_unlink(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  link = &g_tcp_porthash[tcp_portndx(conn->lport)];
+  for (; *link != NULL; link = &(*link)->pnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->pnext;
+          break;
+        }
+    }
+
+  conn->pnext = NULL;
+}
+
+static void tcp_setport(FAR struct tcp_conn_s *conn, uint16_t portno)
+{
+  FAR struct tcp_conn_s **bucket;
+
+  if (conn->lport != 0)
+    {
+      tcp_port_unlink(conn);
+    }
+
+  conn->lport = portno;
+
+  if (portno != 0)
+    {
+      bucket      = &g_tcp_porthash[tcp_portndx(portno)];
+      conn->pnext = *bucket;
+      *bucket     = conn;
+    }
+}
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -113,14 +282,16 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
-  int i;
 
-  /* Check if this port number is in use by any active UIP TCP connection */
+  /* Check if this port number is in use by any active UIP TCP connection.
+   * Only the connections bound to a port in the same hash bucket need to
+   * be examined.
+   */
 
-  for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+  for (conn = g_tcp_porthash[tcp_portndx(portno)];
+       conn != NULL;
+       conn = conn->pnext)
     {
-      conn = &g_tcp_connections[i];
-
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
        */
@@ -164,14 +335,16 @@ static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
-  int i;
 
-  /* Check if this port number is in use by any active UIP TCP connection */
+  /* Check if this port number is in use by any active UIP TCP connection.
+   * Only the connections bound to a port in the same hash bucket need to
+   * be examined.
+   */
 
-  for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+  for (conn = g_tcp_porthash[tcp_portndx(portno)];
+       conn != NULL;
+       conn = conn->pnext)
     {
-      conn = &g_tcp_connections[i];
-
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
        */
@@ -327,10 +500,16 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+  /* Only the connections in the hash bucket selected by the ports and
+   * the source address of the packet can match.
+   */
+
+  conn = g_tcp_connhash[tcp_connndx(tcp->destport, tcp->srcport,
+                                    srcipaddr)];
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -364,9 +543,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection in the hash bucket */
 
-      conn = (FAR struct tcp_conn_s *)conn->node.flink;
+      conn = conn->hnext;
     }
 
   return conn;
@@ -394,10 +573,16 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+  /* Only the connections in the hash bucket selected by the ports and
+   * the source address of the packet can match.
+   */
+
+  conn = g_tcp_connhash[tcp_connndx(tcp->destport, tcp->srcport,
+                                    tcp_ipv6_fold(ip->srcipaddr))];
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -431,9 +616,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection in the hash bucket */
 
-      conn = (FAR struct tcp_conn_s *)conn->node.flink;
+      conn = conn->hnext;
     }
 
   return conn;
@@ -479,7 +664,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
-  conn->lport = htons(port);
+  tcp_setport(conn, htons(port));
   net_ipv4addr_copy(conn->u.ipv4.laddr, addr->sin_addr.s_addr);
 
   /* Find the device that can receive packets on the network associated with
@@ -495,7 +680,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
-      conn->lport = 0;
+      tcp_setport(conn, 0);
       net_ipv4addr_copy(conn->u.ipv4.laddr, INADDR_ANY);
       return ret;
     }
@@ -546,7 +731,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
-  conn->lport = htons(port);
+  tcp_setport(conn, htons(port));
   net_ipv6addr_copy(conn->u.ipv6.laddr, addr->sin6_addr.in6_u.u6_addr16);
 
   /* Find the device that can receive packets on the network
@@ -562,7 +747,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
-      conn->lport = 0;
+      tcp_setport(conn, 0);
       net_ipv6addr_copy(conn->u.ipv6.laddr, g_ipv6_allzeroaddr);
       return ret;
     }
@@ -594,6 +779,12 @@ void tcp_initialize(void)
   dq_init(&g_free_tcp_connections);
   dq_init(&g_active_tcp_connections);
 
+  for (i = 0; i < CONFIG_NET_TCP_HASHSIZE; i++)
+    {
+      g_tcp_connhash[i] = NULL;
+      g_tcp_porthash[i] = NULL;
+    }
+
   /* Now initialize each connection structure */
 
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
@@ -771,7 +962,14 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      dq_rem(&conn->node, &g_active_tcp_connections);
+      tcp_deactivate(conn);
+    }
+
+  /* Release the local port */
+
+  if (conn->lport != 0)
+    {
+      tcp_port_unlink(conn);
     }
 
 #ifdef CONFIG_NET_TCP_READAHEAD
@@ -1000,7 +1198,6 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->sa            = 0;
       conn->sv            = 4;
       conn->nrtx          = 0;
-      conn->lport         = tcp->destport;
       conn->rport         = tcp->srcport;
       conn->tcpstateflags = TCP_SYN_RCVD;
 
@@ -1030,11 +1227,13 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       sq_init(&conn->unacked_q);
 #endif
 
-      /* And, finally, put the connection structure into the active list.
-       * Interrupts should already be disabled in this context.
+      /* And, finally, bind the local port and put the connection structure
+       * into the active list.  Interrupts should already be disabled in
+       * this context.
        */
 
-      dq_addlast(&conn->node, &g_active_tcp_connections);
+      tcp_setport(conn, tcp->destport);
+      tcp_activate(conn);
     }
 
   return conn;
@@ -1246,7 +1445,6 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->rto        = TCP_RTO;
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
-  conn->lport      = htons((uint16_t)port);
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
   conn->isn        = 0;
@@ -1267,9 +1465,12 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   sq_init(&conn->unacked_q);
 #endif
 
-  /* And, finally, put the connection structure into the active list. */
+  /* And, finally, bind the local port and put the connection structure
+   * into the active list.
+   */
 
-  dq_addlast(&conn->node, &g_active_tcp_connections);
+  tcp_setport(conn, htons((uint16_t)port));
+  tcp_activate(conn);
   ret = OK;
 
 errout_with_lock:
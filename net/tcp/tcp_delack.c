@@ -0,0 +1,194 @@
+/****************************************************************************
+ * net/tcp/tcp_delack.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_DELAYED_ACK)
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCP_DELACK_TICKS  MSEC2TICK(CONFIG_NET_TCP_DELAYED_ACK_MSEC)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* One timer serves the delayed ACKs of all connections */
+
+static struct work_s g_tcp_delack_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_delack_work
+ *
+ * Description:
+ *   Poll the devices of all connections whose delayed ACK is due.  The ACK
+ *   itself is sent from tcp_poll().  The timer is restarted for the
+ *   connections that are still waiting.
+ *
+ ****************************************************************************/
+
+static void tcp_delack_work(FAR void *arg)
+{
+  FAR struct tcp_conn_s *conn = NULL;
+  systime_t now;
+  systime_t elapsed;
+  systime_t next = TCP_DELACK_TICKS;
+  bool pending = false;
+
+  net_lock();
+  now = clock_systimer();
+
+  while ((conn = tcp_nextconn(conn)) != NULL)
+    {
+      if (conn->rx_unackseg == 0 || conn->dev == NULL)
+        {
+          continue;
+        }
+
+      elapsed = now - conn->rx_acktime;
+      if (elapsed >= TCP_DELACK_TICKS)
+        {
+          netdev_txnotify_dev(conn->dev);
+        }
+      else
+        {
+          if (TCP_DELACK_TICKS - elapsed < next)
+            {
+              next = TCP_DELACK_TICKS - elapsed;
+            }
+
+          pending = true;
+        }
+    }
+
+  if (pending)
+    {
+      (void)work_queue(LPWORK, &g_tcp_delack_work, tcp_delack_work, NULL,
+                       next);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_delack
+ *
+ * Description:
+ *   Decide whether the ACK of a newly received data segment may be
+ *   delayed.  The first segment starts the delayed ACK timer; the second
+ *   one must be ACKed immediately (RFC 1122, 4.2.3.2).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection that received the data
+ *
+ * Returned Value:
+ *   True if the ACK may be delayed; false if it must be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_delack(FAR struct tcp_conn_s *conn)
+{
+  if (conn->rx_unackseg > 0)
+    {
+      /* ACK every second segment.  tcp_send() clears the count. */
+
+      return false;
+    }
+
+  conn->rx_unackseg = 1;
+  conn->rx_acktime  = clock_systimer();
+
+  if (work_available(&g_tcp_delack_work))
+    {
+      (void)work_queue(LPWORK, &g_tcp_delack_work, tcp_delack_work, NULL,
+                       TCP_DELACK_TICKS);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: tcp_delack_expired
+ *
+ * Description:
+ *   Check if a delayed ACK of the connection is due.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   True if an ACK is pending and its delay has elapsed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_delack_expired(FAR struct tcp_conn_s *conn)
+{
+  return conn->rx_unackseg > 0 &&
+         clock_systimer() - conn->rx_acktime >= TCP_DELACK_TICKS;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_DELAYED_ACK */
@@ -124,6 +124,17 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
           result = tcp_callback(dev, conn, TCP_POLL);
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+          /* Send a pure ACK if a delayed ACK is due and there is no data
+           * to carry it.
+           */
+
+          if (tcp_delack_expired(conn))
+            {
+              result |= TCP_SNDACK;
+            }
+#endif
+
           /* Handle the callback response */
 
           tcp_appsend(dev, conn, result);
@@ -41,6 +41,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -97,9 +98,10 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_NAGLE)
+  /* Keep alive options, the congestion control algorithm and the Nagle
+   * options are the only TCP protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -120,10 +122,9 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
-
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -152,12 +153,32 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret                = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
 
+#ifdef CONFIG_NET_TCP_NAGLE
+      case TCP_NODELAY:  /* Avoid coalescing of small segments. */
+      case TCP_CORK:     /* Only send full segments */
+        if (*value_len < sizeof(int))
+          {
+            ret              = -EINVAL;
+          }
+        else
+          {
+            FAR int *enable  = (FAR int *)value;
+            *enable          = option == TCP_NODELAY ? conn->nodelay :
+                                                       conn->cork;
+            *value_len       = sizeof(int);
+            ret              = OK;
+          }
+        break;
+#else
       case TCP_NODELAY:  /* Avoid coalescing of small segments. */
         nerr("ERROR: TCP_NODELAY not supported\n");
         ret = -ENOSYS;
         break;
+#endif
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (*value_len < sizeof(struct timeval))
           {
@@ -238,6 +259,27 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret              = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          FAR const char *name = tcp_cc_name(conn);
+          socklen_t len        = strlen(name) + 1;
+
+          /* Truncate the name if the buffer is too small */
+
+          if (len > *value_len)
+            {
+              len = *value_len;
+            }
+
+          memcpy(value, name, len);
+          *value_len           = len;
+          ret                  = OK;
+        }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -248,7 +290,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || ... */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
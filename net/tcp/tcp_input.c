@@ -66,6 +66,132 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_parse_options
+ *
+ * Description:
+ *   Parse the options of an incoming TCP segment.  The MSS, window scale
+ *   and SACK permitted options are only accepted in SYN segments; SACK
+ *   blocks are only accepted after SACK has been negotiated.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received packet
+ *   conn   - The TCP connection of the segment
+ *   tcp    - The TCP header of the segment
+ *   iplen  - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN)
+ *   hdrlen - Offset of the TCP options in dev->d_buf
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_parse_options(FAR struct net_driver_s *dev,
+                              FAR struct tcp_conn_s *conn,
+                              FAR struct tcp_hdr_s *tcp,
+                              unsigned int iplen, unsigned int hdrlen)
+{
+  FAR uint8_t *optdata = &dev->d_buf[hdrlen];
+  bool syn = (tcp->flags & TCP_SYN) != 0;
+  uint16_t tmp16;
+  uint8_t opt;
+  uint8_t optlen;
+  int len;
+  int i;
+
+#ifdef CONFIG_NET_TCP_SACK
+  if (!syn)
+    {
+      conn->nsacks = 0;
+    }
+#endif
+
+  len = (((tcp->tcpoffset >> 4) - 5) << 2);
+  for (i = 0; i < len; )
+    {
+      opt = optdata[i];
+      if (opt == TCP_OPT_END)
+        {
+          /* End of options. */
+
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          /* NOP option. */
+
+          ++i;
+          continue;
+        }
+
+      /* All other options have a length field, so that we easily can skip
+       * past them.  If the length field is zero or runs beyond the header,
+       * the options are malformed and we don't process them further.
+       */
+
+      if (i + 1 >= len)
+        {
+          break;
+        }
+
+      optlen = optdata[i + 1];
+      if (optlen < 2 || i + optlen > len)
+        {
+          break;
+        }
+
+      if (syn && opt == TCP_OPT_MSS && optlen == TCP_OPT_MSS_LEN)
+        {
+          uint16_t tcp_mss = TCP_MSS(dev, iplen);
+
+          /* An MSS option with the right option length. */
+
+          tmp16 = ((uint16_t)optdata[i + 2] << 8) | (uint16_t)optdata[i + 3];
+          conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+        }
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      else if (syn && opt == TCP_OPT_WS && optlen == TCP_OPT_WS_LEN)
+        {
+          /* The peer will scale its window by this shift count */
+
+          conn->snd_scale = optdata[i + 2] > TCP_MAX_WS_SHIFT ?
+                            TCP_MAX_WS_SHIFT : optdata[i + 2];
+          conn->optflags |= TCP_OPTF_WS;
+        }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+      else if (syn && opt == TCP_OPT_SACK_PERM &&
+               optlen == TCP_OPT_SACK_PERM_LEN)
+        {
+          conn->optflags |= TCP_OPTF_SACK;
+        }
+      else if (!syn && opt == TCP_OPT_SACK &&
+               (conn->optflags & TCP_OPTF_SACK) != 0)
+        {
+          FAR uint8_t *block;
+          int j;
+
+          /* Each SACK block is a pair of 32-bit sequence numbers */
+
+          for (j = i + 2;
+               j + 8 <= i + optlen && conn->nsacks < TCP_SACK_NBLOCKS;
+               j += 8)
+            {
+              block = &optdata[j];
+              conn->sacks[conn->nsacks].left  = tcp_getsequence(block);
+              conn->sacks[conn->nsacks].right = tcp_getsequence(block + 4);
+              conn->nsacks++;
+            }
+        }
+#endif
+
+      i += optlen;
+    }
+}
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -95,9 +221,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
-  uint8_t  opt;
   int      len;
-  int      i;
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -227,57 +351,11 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP options, if present. */
 
           if ((tcp->tcpoffset & 0xf0) > 0x50)
             {
-              for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                {
-                  opt = dev->d_buf[hdrlen + i];
-                  if (opt == TCP_OPT_END)
-                    {
-                      /* End of options. */
-
-                      break;
-                    }
-                  else if (opt == TCP_OPT_NOOP)
-                    {
-                      /* NOP option. */
-
-                      ++i;
-                    }
-                  else if (opt == TCP_OPT_MSS &&
-                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                    {
-                      uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                      /* An MSS option with the right option length. */
-
-                      tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
-                               (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                      /* And we are done processing options. */
-
-                      break;
-                    }
-                  else
-                    {
-                      /* All other options have a length field, so that we easily
-                       * can skip past them.
-                       */
-
-                      if (dev->d_buf[hdrlen + 1 + i] == 0)
-                        {
-                          /* If the length field is zero, the options are malformed
-                           * and we don't process them further.
-                           */
-
-                          break;
-                        }
-                      i += dev->d_buf[hdrlen + 1 + i];
-                    }
-                }
+              tcp_parse_options(dev, conn, tcp, iplen, hdrlen);
             }
 
           /* Our response will be a SYNACK. */
@@ -314,6 +392,32 @@ found:
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window field of a SYN segment is never scaled */
+
+  if ((conn->optflags & TCP_OPTF_WS) != 0 && (tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_scale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Pick up any SACK blocks for the send logic */
+
+  if ((conn->optflags & TCP_OPTF_SACK) != 0 &&
+      (tcp->flags & (TCP_SYN | TCP_ACK)) == TCP_ACK)
+    {
+      if ((tcp->tcpoffset & 0xf0) > 0x50)
+        {
+          tcp_parse_options(dev, conn, tcp, iplen, hdrlen);
+        }
+      else
+        {
+          conn->nsacks = 0;
+        }
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -602,6 +706,9 @@ found:
             tcp_setsequence(conn->sndseq, conn->isn);
             conn->sent          = 0;
             conn->sndseq_max    = 0;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
 #endif
             conn->unacked       = 0;
             flags               = TCP_CONNECTED;
@@ -638,58 +745,11 @@ found:
 
         if ((flags & TCP_ACKDATA) != 0 && (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+            /* Parse the TCP options, if present. */
 
             if ((tcp->tcpoffset & 0xf0) > 0x50)
               {
-                for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                  {
-                    opt = dev->d_buf[hdrlen + i];
-                    if (opt == TCP_OPT_END)
-                      {
-                        /* End of options. */
-
-                        break;
-                      }
-                    else if (opt == TCP_OPT_NOOP)
-                      {
-                        /* NOP option. */
-
-                        ++i;
-                      }
-                    else if (opt == TCP_OPT_MSS &&
-                              dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                      {
-                        uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                        /* An MSS option with the right option length. */
-
-                        tmp16 =
-                          (dev->d_buf[hdrlen + 2 + i] << 8) |
-                          dev->d_buf[hdrlen + 3 + i];
-                        conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                        /* And we are done processing options. */
-
-                        break;
-                      }
-                    else
-                      {
-                        /* All other options have a length field, so that we
-                         * easily can skip past them.
-                         */
-
-                        if (dev->d_buf[hdrlen + 1 + i] == 0)
-                          {
-                            /* If the length field is zero, the options are
-                             * malformed and we don't process them further.
-                             */
-
-                            break;
-                          }
-                        i += dev->d_buf[hdrlen + 1 + i];
-                      }
-                  }
+                tcp_parse_options(dev, conn, tcp, iplen, hdrlen);
               }
 
             conn->tcpstateflags = TCP_ESTABLISHED;
@@ -701,6 +761,9 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -883,6 +946,17 @@ found:
                 /* Update the sequence number using the saved length */
 
                 net_incr32(conn->rcvseq, len);
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+                /* The ACK of new data may be delayed if there is no
+                 * outgoing data to carry it right now.
+                 */
+
+                if (len > 0 && dev->d_sndlen == 0 && tcp_delack(conn))
+                  {
+                    result &= ~TCP_SNDACK;
+                  }
+#endif
               }
 
             /* Send the response, ACKing the data or not, as appropriate */
@@ -58,7 +58,12 @@
  * Private Data
  ****************************************************************************/
 
-/* The tcp_listenports list all currently listening ports. */
+/* The tcp_listenports list all currently listening ports.  This is an open
+ * addressed hash table:  A listener is stored in the first free slot at or
+ * after the slot selected by its port number (see tcp_listenndx()).  There
+ * is never a free slot between the home slot of a listener and the slot
+ * that holds it.
+ */
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
 
@@ -66,6 +71,19 @@ static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_listenndx
+ *
+ * Description:
+ *   Return the home slot in tcp_listenports[] of a port number.
+ *
+ ****************************************************************************/
+
+static inline int tcp_listenndx(uint16_t portno)
+{
+  return (int)(portno % CONFIG_NET_MAX_LISTENPORTS);
+}
+
 /****************************************************************************
  * Name: tcp_findlistener
  *
@@ -83,27 +101,41 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno, uint8_t domain)
 FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
 #endif
 {
-  int ndx;
+  FAR struct tcp_conn_s *conn;
+  int ndx = tcp_listenndx(portno);
+  int i;
 
-  /* Examine each connection structure in each slot of the listener list */
+  /* Examine the slots starting at the home slot of the port number.  The
+   * first free slot ends the search.
+   */
 
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  for (i = 0; i < CONFIG_NET_MAX_LISTENPORTS; i++)
     {
       /* Is this slot assigned?  If so, does the connection have the same
        * local port number?
        */
 
-      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+      conn = tcp_listenports[ndx];
+      if (conn == NULL)
+        {
+          break;
+        }
+
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if (conn && conn->lport == portno && conn->domain == domain)
+      if (conn->lport == portno && conn->domain == domain)
 #else
-      if (conn && conn->lport == portno)
+      if (conn->lport == portno)
 #endif
         {
           /* Yes.. we found a listener on this port */
 
           return conn;
         }
+
+      if (++ndx >= CONFIG_NET_MAX_LISTENPORTS)
+        {
+          ndx = 0;
+        }
     }
 
   /* No listener for this port */
@@ -149,18 +181,70 @@ void tcp_listen_initialize(void)
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
-  int ndx;
+  FAR struct tcp_conn_s *next;
+  int ndx = tcp_listenndx(conn->lport);
+  int home;
+  int i;
   int ret = -EINVAL;
 
   net_lock();
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+
+  /* Find the slot holding the connection */
+
+  for (i = 0; i < CONFIG_NET_MAX_LISTENPORTS; i++)
     {
+      if (tcp_listenports[ndx] == NULL)
+        {
+          break;
+        }
+
       if (tcp_listenports[ndx] == conn)
         {
-          tcp_listenports[ndx] = NULL;
           ret = OK;
           break;
         }
+
+      if (++ndx >= CONFIG_NET_MAX_LISTENPORTS)
+        {
+          ndx = 0;
+        }
+    }
+
+  if (ret == OK)
+    {
+      /* Free the slot.  Then move back any following listener that could
+       * no longer be found across the new free slot.
+       */
+
+      tcp_listenports[ndx] = NULL;
+      i = ndx;
+
+      for (; ; )
+        {
+          if (++i >= CONFIG_NET_MAX_LISTENPORTS)
+            {
+              i = 0;
+            }
+
+          next = tcp_listenports[i];
+          if (next == NULL)
+            {
+              break;
+            }
+
+          /* The listener may stay in slot i if its home slot lies
+           * (cyclically) after the free slot and not after slot i.
+           */
+
+          home = tcp_listenndx(next->lport);
+          if ((ndx < i) ? (home <= ndx || home > i) :
+                          (home <= ndx && home > i))
+            {
+              tcp_listenports[ndx] = next;
+              tcp_listenports[i]   = NULL;
+              ndx                  = i;
+            }
+        }
     }
 
   net_unlock();
@@ -182,6 +266,7 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 {
   int ndx;
   int ret;
+  int i;
 
   /* This must be done with network locked because the listener table
    * is accessed from event processing logic as well.
@@ -209,9 +294,12 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -ENOBUFS; /* Assume failure */
 
-      /* Search all slots until an available slot is found */
+      /* Search the slots following the home slot of the port number until
+       * an available slot is found.
+       */
 
-      for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+      ndx = tcp_listenndx(conn->lport);
+      for (i = 0; i < CONFIG_NET_MAX_LISTENPORTS; i++)
         {
           /* Is the next slot available? */
 
@@ -223,6 +311,11 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               ret = OK;
               break;
             }
+
+          if (++ndx >= CONFIG_NET_MAX_LISTENPORTS)
+            {
+              ndx = 0;
+            }
         }
     }
 
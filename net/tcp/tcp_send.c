@@ -55,7 +55,7 @@
 #include <nuttx/net/tcp.h>
 
 #ifdef CONFIG_NET_TCP_RWND_CONTROL
-#  include <nuttx/semaphore.h>
+#  include <nuttx/mm/iob.h>
 #endif
 
 #include "devif/devif.h"
@@ -313,9 +313,8 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
                            FAR struct tcp_conn_s *conn,
                            FAR struct tcp_hdr_s *tcp)
 {
+  uint32_t wnd;
 #ifdef CONFIG_NET_TCP_RWND_CONTROL
-  extern sem_t g_qentry_sem;
-  int  qentry_sem_count;
   uint32_t rwnd;
 #endif
 
@@ -351,17 +350,20 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
   tcp->srcport  = conn->lport;
   tcp->destport = conn->rport;
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* Every outgoing segment acknowledges all data received so far */
+
+  conn->rx_unackseg = 0;
+#endif
+
 #ifdef CONFIG_NET_TCP_RWND_CONTROL
   /* Update the TCP received window based on I/O buffer */
   /* NOTE: This algorithm is still experimental */
 
-  if (OK == nxsem_getvalue(&g_qentry_sem, &qentry_sem_count))
-    {
-      rwnd = (qentry_sem_count * CONFIG_NET_ETH_TCP_RECVWNDO)
-             / CONFIG_IOB_NCHAINS;
+  rwnd = (iob_qentry_navail() * CONFIG_NET_ETH_TCP_RECVWNDO)
+         / CONFIG_IOB_NCHAINS;
 
-      NET_DEV_RCVWNDO(dev) = (uint16_t)rwnd;
-    }
+  NET_DEV_RCVWNDO(dev) = rwnd;
 #endif
 
   /* Set the TCP window */
@@ -377,8 +379,25 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     }
   else
     {
-      tcp->wnd[0] = ((NET_DEV_RCVWNDO(dev)) >> 8);
-      tcp->wnd[1] = ((NET_DEV_RCVWNDO(dev)) & 0xff);
+      wnd = NET_DEV_RCVWNDO(dev);
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      /* The window of a SYN segment is never scaled (RFC 7323) */
+
+      if ((conn->optflags & TCP_OPTF_WS) != 0 &&
+          (tcp->flags & TCP_SYN) == 0)
+        {
+          wnd >>= CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+        }
+#endif
+
+      if (wnd > 0xffff)
+        {
+          wnd = 0xffff;
+        }
+
+      tcp->wnd[0] = wnd >> 8;
+      tcp->wnd[1] = wnd & 0xff;
     }
 
   /* Finish the IP portion of the message and calculate checksums */
@@ -560,7 +579,9 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
              uint8_t ack)
 {
   struct tcp_hdr_s *tcp;
+  FAR uint8_t *optdata;
   uint16_t tcp_mss;
+  uint16_t optlen;
 
   /* Get values that vary with the underlying IP domain */
 
@@ -600,13 +621,45 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   tcp->flags      = ack;
 
-  /* We send out the TCP Maximum Segment Size option with our ack. */
+  /* We send out the TCP Maximum Segment Size option with our ack.  With
+   * the window scale and SACK-permitted options, up to 12 option bytes
+   * follow the header, more than the four of tcp_hdr_s.optdata[], so
+   * address the options from the start of the header.
+   */
+
+  optdata         = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  optdata[0]      = TCP_OPT_MSS;
+  optdata[1]      = TCP_OPT_MSS_LEN;
+  optdata[2]      = tcp_mss >> 8;
+  optdata[3]      = tcp_mss & 0xff;
+  optlen          = TCP_OPT_MSS_LEN;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* Offer window scaling in our SYN, or accept it in the SYNACK if the
+   * peer offered it.  Each option is padded to a 32-bit boundary.
+   */
+
+  if (ack == TCP_SYN || (conn->optflags & TCP_OPTF_WS) != 0)
+    {
+      optdata[optlen++] = TCP_OPT_NOOP;
+      optdata[optlen++] = TCP_OPT_WS;
+      optdata[optlen++] = TCP_OPT_WS_LEN;
+      optdata[optlen++] = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  if (ack == TCP_SYN || (conn->optflags & TCP_OPTF_SACK) != 0)
+    {
+      optdata[optlen++] = TCP_OPT_NOOP;
+      optdata[optlen++] = TCP_OPT_NOOP;
+      optdata[optlen++] = TCP_OPT_SACK_PERM;
+      optdata[optlen++] = TCP_OPT_SACK_PERM_LEN;
+    }
+#endif
 
-  tcp->optdata[0] = TCP_OPT_MSS;
-  tcp->optdata[1] = TCP_OPT_MSS_LEN;
-  tcp->optdata[2] = tcp_mss >> 8;
-  tcp->optdata[3] = tcp_mss & 0xff;
-  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  dev->d_len     += optlen - TCP_OPT_MSS_LEN;
+  tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
 
   /* Complete the common portions of the TCP message */
 
@@ -156,6 +156,199 @@ static void psock_insert_segment(FAR struct tcp_wrbuffer_s *wrb,
     }
 }
 
+/****************************************************************************
+ * Name: psock_fast_rexmit
+ *
+ * Description:
+ *   Move the oldest un-ACKed segment from the unacked_q back to the
+ *   write_q so that it is retransmitted right away.  If the peer has
+ *   reported SACK blocks, every segment below the highest SACKed sequence
+ *   number that the peer does not hold is a hole and is moved as well.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+static void psock_fast_rexmit(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *next;
+  uint32_t highsack = conn->snduna;
+  bool first = true;
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Find the end of the highest SACKed segment */
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if (wrb->wb_sacked &&
+          TCP_SEQ_GT(TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb), highsack))
+        {
+          highsack = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
+        }
+    }
+#endif
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = next)
+    {
+      next = sq_next(entry);
+      wrb  = (FAR struct tcp_wrbuffer_s *)entry;
+
+#ifdef CONFIG_NET_TCP_SACK
+      if (wrb->wb_sacked)
+        {
+          continue;
+        }
+#endif
+
+      if (!first && TCP_SEQ_GTE(TCP_WBSEQNO(wrb), highsack))
+        {
+          break;
+        }
+
+      ninfo("REXMIT: Fast retransmit wrb=%p seqno=%u\n",
+            wrb, TCP_WBSEQNO(wrb));
+
+      conn->unacked -= MIN(conn->unacked, (uint32_t)TCP_WBSENT(wrb));
+      conn->sent    -= MIN(conn->sent, (uint32_t)TCP_WBSENT(wrb));
+      TCP_WBSENT(wrb) = 0;
+
+      sq_rem(entry, &conn->unacked_q);
+      psock_insert_segment(wrb, &conn->write_q);
+      first = false;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: psock_send_nagle
+ *
+ * Description:
+ *   Apply Nagle's algorithm (RFC 896) and TCP_CORK to the head of the
+ *   write_q:  A partial segment of new data at the end of the queue is
+ *   held back while corked or, unless TCP_NODELAY is set, while earlier
+ *   data is still un-ACKed.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   True if nothing should be sent now.
+ *
+ * Assumptions:
+ *   The network is locked and the write_q is not empty
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_NAGLE
+static inline bool psock_send_nagle(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb =
+    (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+
+  /* Full segments, data that follows, and retransmissions go out now */
+
+  if (sq_next(&wrb->wb_node) != NULL ||
+      TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb) >= conn->mss ||
+      (TCP_WBSEQNO(wrb) != (unsigned)-1 && TCP_WBSENT(wrb) == 0))
+    {
+      return false;
+    }
+
+  return conn->cork || (!conn->nodelay && conn->unacked > 0);
+}
+#endif
+
+/****************************************************************************
+ * Name: psock_send_coalesce
+ *
+ * Description:
+ *   Append the data of a new write buffer to the write buffer at the tail
+ *   of the write_q if nothing of that buffer has been sent yet.  This lets
+ *   a sequence of small writes go out as one segment.
+ *
+ *   The free space at the end of the last I/O buffer of the tail is filled
+ *   first; only the data that does not fit there is chained on as further
+ *   I/O buffers.  Otherwise every small write would cost one partly filled
+ *   I/O buffer.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   wrb  - The new write buffer
+ *
+ * Returned Value:
+ *   True if the data was appended and 'wrb' has been released.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_NAGLE
+static bool psock_send_coalesce(FAR struct tcp_conn_s *conn,
+                                FAR struct tcp_wrbuffer_s *wrb)
+{
+  FAR struct tcp_wrbuffer_s *tail =
+    (FAR struct tcp_wrbuffer_s *)conn->write_q.tail;
+  FAR struct iob_s *last;
+  unsigned int ncopy;
+
+  if (tail == NULL || TCP_WBSEQNO(tail) != (unsigned)-1 ||
+      (uint32_t)TCP_WBPKTLEN(tail) + TCP_WBPKTLEN(wrb) > UINT16_MAX)
+    {
+      return false;
+    }
+
+  ninfo("Append wrb=%p pktlen=%u to wrb=%p pktlen=%u\n",
+        wrb, TCP_WBPKTLEN(wrb), tail, TCP_WBPKTLEN(tail));
+
+  /* Find the last I/O buffer of the tail and fill its free space */
+
+  last = TCP_WBIOB(tail);
+  while (last->io_flink != NULL)
+    {
+      last = last->io_flink;
+    }
+
+  ncopy = CONFIG_IOB_BUFSIZE - last->io_offset - last->io_len;
+  if (ncopy > TCP_WBPKTLEN(wrb))
+    {
+      ncopy = TCP_WBPKTLEN(wrb);
+    }
+
+  if (ncopy > 0)
+    {
+      (void)iob_copyout(&last->io_data[last->io_offset + last->io_len],
+                        TCP_WBIOB(wrb), ncopy, 0);
+
+      last->io_len       += ncopy;
+      TCP_WBPKTLEN(tail) += ncopy;
+      TCP_WBIOB(wrb)      = iob_trimhead(TCP_WBIOB(wrb), ncopy);
+    }
+
+  /* Chain on whatever did not fit; the tail I/O buffer is full now */
+
+  if (TCP_WBPKTLEN(wrb) > 0)
+    {
+      iob_concat(TCP_WBIOB(tail), TCP_WBIOB(wrb));
+      TCP_WBIOB(wrb) = NULL;
+    }
+
+  tcp_wrbuffer_release(wrb);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: psock_lost_connection
  *
@@ -411,6 +604,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)pvconn;
   FAR struct socket *psock = (FAR struct socket *)pvpriv;
+  bool fastrexmit = false;   /* Retransmit now without waiting for a poll */
 
   /* The TCP socket is connected and, hence, should be bound to a device.
    * Make sure that the polling device is the one that we are bound to.
@@ -569,6 +763,56 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_SACK
+      /* Remember which of the remaining segments the peer already holds */
+
+      if (conn->nsacks > 0)
+        {
+          for (entry = sq_peek(&conn->unacked_q); entry;
+               entry = sq_next(entry))
+            {
+              uint32_t lastseq;
+              int i;
+
+              wrb     = (FAR struct tcp_wrbuffer_s *)entry;
+              lastseq = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
+
+              for (i = 0; i < conn->nsacks; i++)
+                {
+                  if (TCP_SEQ_LTE(conn->sacks[i].left, TCP_WBSEQNO(wrb)) &&
+                      TCP_SEQ_GTE(conn->sacks[i].right, lastseq))
+                    {
+                      wrb->wb_sacked = true;
+                      break;
+                    }
+                }
+            }
+
+          conn->nsacks = 0;
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Update the congestion window.  Only an ACK without data may count
+       * as a duplicate.
+       */
+
+      if (tcp_cc_ack(conn, ackno, (flags & TCP_NEWDATA) == 0))
+        {
+          psock_fast_rexmit(conn);
+          fastrexmit = !sq_empty(&conn->write_q);
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_NAGLE
+      /* A partial segment may have been held back until now */
+
+      if (conn->unacked == 0 && !sq_empty(&conn->write_q))
+        {
+          netdev_txnotify_dev(dev);
+        }
+#endif
     }
 
   /* Check for a loss of connection */
@@ -604,6 +848,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_CC
+      /* A retransmission time-out is the strongest congestion signal */
+
+      tcp_cc_timeout(conn);
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -707,6 +957,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("REXMIT: wrb=%p sent=%u, conn unacked=%d sent=%d\n",
                 wrb, TCP_WBSENT(wrb), conn->unacked, conn->sent);
 
+#ifdef CONFIG_NET_TCP_SACK
+          /* SACK information is discarded after a time-out (RFC 2018) */
+
+          wrb->wb_sacked = false;
+#endif
+
           /* Free any write buffers that have exceed the retry count */
 
           if (++TCP_WBNRTX(wrb) >= TCP_MAXRTX)
@@ -764,15 +1020,23 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
    */
 
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
-      (flags & (TCP_POLL | TCP_REXMIT)) &&
+      ((flags & (TCP_POLL | TCP_REXMIT)) != 0 || fastrexmit) &&
       !(sq_empty(&conn->write_q)))
     {
       /* Check if the destination IP address is in the ARP  or Neighbor
        * table.  If not, then the send won't actually make it out... it
        * will be replaced with an ARP request or Neighbor Solicitation.
+       * Also hold back new data while the congestion window is full.
        */
 
-      if (psock_send_addrchck(conn))
+      if (psock_send_addrchck(conn)
+#ifdef CONFIG_NET_TCP_CC
+          && (fastrexmit || tcp_cc_sndwnd(conn) > 0)
+#endif
+#ifdef CONFIG_NET_TCP_NAGLE
+          && (fastrexmit || !psock_send_nagle(conn))
+#endif
+         )
         {
           FAR struct tcp_wrbuffer_s *wrb;
           uint32_t predicted_seqno;
@@ -803,6 +1067,13 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = conn->winsize;
             }
 
+#ifdef CONFIG_NET_TCP_CC
+          if (!fastrexmit && sndlen > tcp_cc_sndwnd(conn))
+            {
+              sndlen = tcp_cc_sndwnd(conn);
+            }
+#endif
+
           ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u\n",
                 wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen);
 
@@ -952,6 +1223,129 @@ static inline void send_txnotify(FAR struct socket *psock,
 #endif /* CONFIG_NET_IPv6 */
 }
 
+/****************************************************************************
+ * Name: send_addrmap
+ *
+ * Description:
+ *   Make sure that the link layer address of the peer is known before data
+ *   is queued for transmission.
+ *
+ * Input Parameters:
+ *   psock - Socket state structure
+ *   conn  - The TCP connection structure
+ *
+ * Returned Value:
+ *   OK if the address mapping is available; -ENETUNREACH otherwise.
+ *
+ ****************************************************************************/
+
+static inline int send_addrmap(FAR struct socket *psock,
+                               FAR struct tcp_conn_s *conn)
+{
+#if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
+  int ret;
+
+#ifdef CONFIG_NET_ARP_SEND
+#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
+  if (psock->s_domain == PF_INET)
+#endif
+    {
+      /* Make sure that the IP address mapping is in the ARP table */
+
+      ret = arp_send(conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_ARP_SEND */
+
+#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
+#ifdef CONFIG_NET_ARP_SEND
+  else
+#endif
+    {
+      /* Make sure that the IP address mapping is in the Neighbor Table */
+
+      ret = icmpv6_neighbor(conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_ICMPv6_NEIGHBOR */
+
+  /* Did we successfully get the address mapping? */
+
+  if (ret < 0)
+    {
+      nerr("ERROR: Not reachable\n");
+      return -ENETUNREACH;
+    }
+#endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: send_queue
+ *
+ * Description:
+ *   Set up the send callback, add a filled write buffer to the end of the
+ *   connection's write queue, and notify the device driver.
+ *
+ * Input Parameters:
+ *   psock - Socket state structure
+ *   conn  - The TCP connection structure
+ *   wrb   - The write buffer to be queued
+ *
+ * Returned Value:
+ *   OK on success; -ENOMEM if no callback could be allocated.  On failure,
+ *   the caller still owns the write buffer.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int send_queue(FAR struct socket *psock, FAR struct tcp_conn_s *conn,
+                      FAR struct tcp_wrbuffer_s *wrb)
+{
+  /* Allocate resources to receive a callback */
+
+  if (psock->s_sndcb == NULL)
+    {
+      psock->s_sndcb = tcp_callback_alloc(conn);
+    }
+
+  /* Test if the callback has been allocated */
+
+  if (psock->s_sndcb == NULL)
+    {
+      /* A buffer allocation error occurred */
+
+      nerr("ERROR: Failed to allocate callback\n");
+      return -ENOMEM;
+    }
+
+  /* Set up the callback in the connection */
+
+  psock->s_sndcb->flags = (TCP_ACKDATA | TCP_REXMIT | TCP_POLL |
+                           TCP_DISCONN_EVENTS);
+  psock->s_sndcb->priv  = (FAR void *)psock;
+  psock->s_sndcb->event = psock_send_eventhandler;
+
+  /* Dump I/O buffer chain */
+
+  TCP_WBDUMP("I/O buffer chain", wrb, TCP_WBPKTLEN(wrb), 0);
+
+  /* psock_send_eventhandler() will send data in FIFO order from the
+   * conn->write_q
+   */
+
+  sq_addlast(&wrb->wb_node, &conn->write_q);
+  ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
+        wrb, TCP_WBPKTLEN(wrb),
+        conn->write_q.head, conn->write_q.tail);
+
+  /* Notify the device driver of the availability of TX data */
+
+  send_txnotify(psock, conn);
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1038,38 +1432,11 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   conn = (FAR struct tcp_conn_s *)psock->s_conn;
   DEBUGASSERT(conn);
 
-#if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
-#ifdef CONFIG_NET_ARP_SEND
-#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
-  if (psock->s_domain == PF_INET)
-#endif
-    {
-      /* Make sure that the IP address mapping is in the ARP table */
-
-      ret = arp_send(conn->u.ipv4.raddr);
-    }
-#endif /* CONFIG_NET_ARP_SEND */
-
-#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
-#ifdef CONFIG_NET_ARP_SEND
-  else
-#endif
-    {
-      /* Make sure that the IP address mapping is in the Neighbor Table */
-
-      ret = icmpv6_neighbor(conn->u.ipv6.raddr);
-    }
-#endif /* CONFIG_NET_ICMPv6_NEIGHBOR */
-
-  /* Did we successfully get the address mapping? */
-
+  ret = send_addrmap(psock, conn);
   if (ret < 0)
     {
-      nerr("ERROR: Not reachable\n");
-      ret = -ENETUNREACH;
       goto errout;
     }
-#endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
   /* Dump the incoming buffer */
 
@@ -1096,31 +1463,6 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_lock;
         }
 
-      /* Allocate resources to receive a callback */
-
-      if (psock->s_sndcb == NULL)
-        {
-          psock->s_sndcb = tcp_callback_alloc(conn);
-        }
-
-      /* Test if the callback has been allocated */
-
-      if (psock->s_sndcb == NULL)
-        {
-          /* A buffer allocation error occurred */
-
-          nerr("ERROR: Failed to allocate callback\n");
-          ret = -ENOMEM;
-          goto errout_with_wrb;
-        }
-
-      /* Set up the callback in the connection */
-
-      psock->s_sndcb->flags = (TCP_ACKDATA | TCP_REXMIT | TCP_POLL |
-                               TCP_DISCONN_EVENTS);
-      psock->s_sndcb->priv  = (FAR void *)psock;
-      psock->s_sndcb->event = psock_send_eventhandler;
-
       /* Initialize the write buffer */
 
       TCP_WBSEQNO(wrb) = (unsigned)-1;
@@ -1139,23 +1481,28 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
           result = TCP_WBCOPYIN(wrb, (FAR uint8_t *)buf, len);
         }
 
-      /* Dump I/O buffer chain */
-
-      TCP_WBDUMP("I/O buffer chain", wrb, TCP_WBPKTLEN(wrb), 0);
-
-      /* psock_send_eventhandler() will send data in FIFO order from the
-       * conn->write_q
+#ifdef CONFIG_NET_TCP_NAGLE
+      /* Append the data to a write buffer that is still waiting to be
+       * sent, if possible.
        */
 
-      sq_addlast(&wrb->wb_node, &conn->write_q);
-      ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
-            wrb, TCP_WBPKTLEN(wrb),
-            conn->write_q.head, conn->write_q.tail);
+      if (result > 0 && psock_send_coalesce(conn, wrb))
+        {
+          net_unlock();
+        }
+      else
+#endif
+        {
+          /* Queue the write buffer and notify the device driver */
 
-      /* Notify the device driver of the availability of TX data */
+          ret = send_queue(psock, conn, wrb);
+          if (ret < 0)
+            {
+              goto errout_with_wrb;
+            }
 
-      send_txnotify(psock, conn);
-      net_unlock();
+          net_unlock();
+        }
     }
 
   /* Set the socket state to idle */
@@ -1196,6 +1543,98 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_tcp_sendiob
+ *
+ * Description:
+ *   Queue a caller-provided I/O buffer chain for transmission on a
+ *   connected TCP socket.  The chain becomes the payload of a write buffer
+ *   without being copied; ownership passes to the network on success and
+ *   the chain is released when the peer has acknowledged all of its data.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   iob      The I/O buffer chain to send.  io_pktlen must be valid in the
+ *            head buffer.
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  On failure, a negated
+ *   errno value is returned and the caller still owns the chain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_LOAN
+ssize_t psock_tcp_sendiob(FAR struct socket *psock, FAR struct iob_s *iob)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR struct tcp_wrbuffer_s *wrb;
+  ssize_t len;
+  int ret;
+
+  DEBUGASSERT(psock != NULL && psock->s_crefs > 0 && iob != NULL);
+
+  if (psock->s_type != SOCK_STREAM || !_SS_ISCONNECTED(psock->s_flags))
+    {
+      nerr("ERROR: Not connected\n");
+      return -ENOTCONN;
+    }
+
+  conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  DEBUGASSERT(conn);
+
+  ret = send_addrmap(psock, conn);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  len = iob->io_pktlen;
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
+
+  /* Allocate a write buffer for the caller's chain.  Do not wait for one:
+   * The caller can free or retry with its own chain.
+   */
+
+  net_lock();
+  wrb = tcp_wrbuffer_tryalloc();
+  if (wrb == NULL)
+    {
+      nerr("ERROR: Failed to allocate write buffer\n");
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  wrb->wb_iob = iob;
+
+  TCP_WBSEQNO(wrb) = (unsigned)-1;
+  TCP_WBNRTX(wrb)  = 0;
+
+  ret = send_queue(psock, conn, wrb);
+  if (ret < 0)
+    {
+      /* Give the chain back to the caller */
+
+      wrb->wb_iob = NULL;
+      tcp_wrbuffer_release(wrb);
+      goto errout_with_lock;
+    }
+
+  net_unlock();
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_IDLE);
+  return len;
+
+errout_with_lock:
+  net_unlock();
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_IDLE);
+  return ret;
+}
+#endif /* CONFIG_NET_IOB_LOAN */
+
 /****************************************************************************
  * Name: psock_tcp_cansend
  *
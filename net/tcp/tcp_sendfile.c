@@ -58,6 +58,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -99,6 +100,7 @@ struct sendfile_s
   FAR struct devif_callback_s *snd_datacb; /* Data callback */
   FAR struct devif_callback_s *snd_ackcb;  /* ACK callback */
   FAR struct file   *snd_file;    /* File structure of the input file */
+  FAR const uint8_t *snd_map;     /* Memory-mapped file data (or NULL) */
   sem_t              snd_sem;     /* Used to wake up the waiting thread */
   off_t              snd_foffset; /* Input file offset */
   size_t             snd_flen;    /* File length */
@@ -418,21 +420,36 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
-          if (ret < 0)
+          if (pstate->snd_map != NULL)
             {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
-            }
+              /* The file is mapped in memory:  Copy the data straight into
+               * the packet without going through the file system.
+               */
 
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
-          if (ret < 0)
+              memcpy(dev->d_appdata,
+                     pstate->snd_map + pstate->snd_foffset + pstate->snd_sent,
+                     sndlen);
+            }
+          else
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
+              ret = file_seek(pstate->snd_file,
+                              pstate->snd_foffset + pstate->snd_sent,
+                              SEEK_SET);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to lseek: %d\n", ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
+
+              ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to read from input file: %d\n",
+                       (int)ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
             }
 
           dev->d_sndlen = sndlen;
@@ -560,6 +577,59 @@ static inline void sendfile_txnotify(FAR struct socket *psock,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_map
+ *
+ * Description:
+ *   Get the memory address of the file data if the file system supports
+ *   FIOC_MMAP (ROMFS in XIP memory, TMPFS, ...) and limit the count to the
+ *   end of the file.
+ *
+ * Input Parameters:
+ *   infile - The input file
+ *   offset - The offset in the file of the first byte to send
+ *   count  - The location of the number of bytes to send
+ *
+ * Returned Value:
+ *   The address of the beginning of the file, or NULL if the file cannot be
+ *   mapped.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *sendfile_map(FAR struct file *infile, off_t offset,
+                                       FAR size_t *count)
+{
+  FAR void *addr = NULL;
+  off_t pos;
+  off_t size;
+
+  if (file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&addr)) < 0 ||
+      addr == NULL)
+    {
+      return NULL;
+    }
+
+  /* The data must not be read beyond the end of the mapped file */
+
+  pos  = file_seek(infile, 0, SEEK_CUR);
+  size = file_seek(infile, 0, SEEK_END);
+  if (pos < 0 || size < 0 || file_seek(infile, pos, SEEK_SET) < 0)
+    {
+      return NULL;
+    }
+
+  if (offset >= size)
+    {
+      *count = 0;
+    }
+  else if (*count > (size_t)(size - offset))
+    {
+      *count = size - offset;
+    }
+
+  return (FAR const uint8_t *)addr;
+}
+
 /****************************************************************************
  * Name: tcp_sendfile
  *
@@ -584,6 +654,7 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
                       FAR off_t *offset, size_t count)
 {
   FAR struct tcp_conn_s *conn;
+  FAR const uint8_t *map;
   struct sendfile_s state;
   int ret;
 
@@ -631,6 +702,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
+  /* Use the memory-mapped file data directly if it is available */
+
+  map = sendfile_map(infile, offset ? *offset : 0, &count);
+
   /* Set the socket state to sending */
 
   psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
@@ -654,6 +729,7 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_foffset = offset ? *offset : 0; /* Input file offset */
   state.snd_flen    = count;                /* Number of bytes to send */
   state.snd_file    = infile;               /* File to read from */
+  state.snd_map     = map;                  /* Mapped file data (or NULL) */
 
   /* Allocate resources to receive a callback */
 
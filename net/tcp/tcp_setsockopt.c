@@ -41,6 +41,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -51,6 +52,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/tcp.h>
 
+#include "netdev/netdev.h"
 #include "socket/socket.h"
 #include "utils/utils.h"
 #include "tcp/tcp.h"
@@ -88,9 +90,10 @@
 int tcp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_NAGLE)
+  /* Keep alive options, the congestion control algorithm and the Nagle
+   * options are the only TCP protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -110,10 +113,9 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
-
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -147,12 +149,48 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_NAGLE
+      case TCP_NODELAY: /* Avoid coalescing of small segments. */
+      case TCP_CORK:    /* Only send full segments */
+        if (value_len != sizeof(int))
+          {
+            ret = -EDOM;
+          }
+        else
+          {
+            bool enable = (*(FAR int *)value != 0);
+
+            net_lock();
+            if (option == TCP_NODELAY)
+              {
+                conn->nodelay = enable;
+              }
+            else
+              {
+                conn->cork    = enable;
+              }
+
+            /* Segments that were held back may go out now */
+
+            if (conn->dev != NULL)
+              {
+                netdev_txnotify_dev(conn->dev);
+              }
 
+            net_unlock();
+            ret = OK;
+          }
+        break;
+#else
       case TCP_NODELAY: /* Avoid coalescing of small segments. */
         nerr("ERROR: TCP_NODELAY not supported\n");
         ret = -ENOSYS;
         break;
+#endif
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (value_len != sizeof(struct timeval))
           {
@@ -251,6 +289,39 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        if (value_len < 1)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            char name[TCP_CA_NAME_MAX];
+
+            /* The name need not be NUL terminated */
+
+            if (value_len >= TCP_CA_NAME_MAX)
+              {
+                value_len = TCP_CA_NAME_MAX - 1;
+              }
+
+            memcpy(name, value, value_len);
+            name[value_len] = '\0';
+
+            net_lock();
+            ret = tcp_cc_select(conn, name);
+            net_unlock();
+
+            if (ret < 0)
+              {
+                nerr("ERROR: Unknown congestion control: %s\n", name);
+              }
+          }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -261,7 +332,8 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || \
+        * CONFIG_NET_TCP_NAGLE */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
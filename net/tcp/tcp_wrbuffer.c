@@ -54,41 +54,33 @@
 #include <errno.h>
 #include <debug.h>
 
-#include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #include "tcp/tcp.h"
 
 /****************************************************************************
- * Private Types
+ * Private Data
  ****************************************************************************/
 
-/* Package all globals used by this logic into a structure */
-
-struct wrbuffer_s
-{
-  /* The semaphore to protect the buffers */
-
-  sem_t sem;
+/* These are the pre-allocated write buffers */
 
-  /* This is the list of available write buffers */
+static struct tcp_wrbuffer_s g_wrbuffers[CONFIG_NET_TCP_NWRBCHAINS];
 
-  sq_queue_t freebuffers;
+/* This is the pool of available write buffers.  Waiting for a write buffer
+ * must not hold the network lock.
+ */
 
-  /* These are the pre-allocated write buffers */
-
-  struct tcp_wrbuffer_s buffers[CONFIG_NET_TCP_NWRBCHAINS];
+static struct mempool_s g_wrbuffer =
+{
+  "tcp_wrbuffer",                 /* name */
+  sizeof(struct tcp_wrbuffer_s),  /* bsize */
+  0,                              /* nreserve */
+  0,                              /* nexpand */
+  net_lockedwait                  /* wait */
 };
 
-/****************************************************************************
- * Private Data
- ****************************************************************************/
-
-/* This is the state of the global write buffer resource */
-
-static struct wrbuffer_s g_wrbuffer;
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -106,16 +98,7 @@ static struct wrbuffer_s g_wrbuffer;
 
 void tcp_wrbuffer_initialize(void)
 {
-  int i;
-
-  sq_init(&g_wrbuffer.freebuffers);
-
-  for (i = 0; i < CONFIG_NET_TCP_NWRBCHAINS; i++)
-    {
-      sq_addfirst(&g_wrbuffer.buffers[i].wb_node, &g_wrbuffer.freebuffers);
-    }
-
-  nxsem_init(&g_wrbuffer.sem, 0, CONFIG_NET_TCP_NWRBCHAINS);
+  mempool_initialize(&g_wrbuffer, g_wrbuffers, CONFIG_NET_TCP_NWRBCHAINS);
 }
 
 /****************************************************************************
@@ -146,14 +129,13 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void)
    * buffer
    */
 
-  DEBUGVERIFY(net_lockedwait(&g_wrbuffer.sem)); /* TODO: Handle EINTR. */
-
-  /* Now, we are guaranteed to have a write buffer structure reserved
-   * for us in the free list.
-   */
+  wrb = (FAR struct tcp_wrbuffer_s *)mempool_alloc(&g_wrbuffer, false);
+  if (wrb == NULL)
+    {
+      nerr("ERROR: Failed to allocate write buffer\n");
+      return NULL;
+    }
 
-  wrb = (FAR struct tcp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
-  DEBUGASSERT(wrb);
   memset(wrb, 0, sizeof(struct tcp_wrbuffer_s));
 
   /* Now get the first I/O buffer for the write buffer structure */
@@ -169,6 +151,42 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void)
   return wrb;
 }
 
+/****************************************************************************
+ * Name: tcp_wrbuffer_tryalloc
+ *
+ * Description:
+ *   Allocate a TCP write buffer without waiting and without an initial I/O
+ *   buffer.  This is used when the caller already has the I/O buffer chain
+ *   to be sent.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The write buffer with wb_iob set to NULL, or NULL if no write buffer is
+ *   available.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_LOAN
+FAR struct tcp_wrbuffer_s *tcp_wrbuffer_tryalloc(void)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+
+  wrb = (FAR struct tcp_wrbuffer_s *)mempool_tryalloc(&g_wrbuffer, false);
+  if (wrb == NULL)
+    {
+      return NULL;
+    }
+
+  memset(wrb, 0, sizeof(struct tcp_wrbuffer_s));
+  return wrb;
+}
+#endif /* CONFIG_NET_IOB_LOAN */
+
 /****************************************************************************
  * Name: tcp_wrbuffer_release
  *
@@ -184,18 +202,22 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void)
 
 void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb)
 {
-  DEBUGASSERT(wrb && wrb->wb_iob);
+  DEBUGASSERT(wrb);
 
   /* To avoid deadlocks, we must following this ordering:  Release the I/O
-   * buffer chain first, then the write buffer structure.
+   * buffer chain first, then the write buffer structure.  There is no
+   * chain if the I/O buffer allocation failed or if the chain has been
+   * handed over to another write buffer.
    */
 
-  iob_free_chain(wrb->wb_iob);
+  if (wrb->wb_iob != NULL)
+    {
+      iob_free_chain(wrb->wb_iob);
+    }
 
   /* Then free the write buffer structure */
 
-  sq_addlast(&wrb->wb_node, &g_wrbuffer.freebuffers);
-  nxsem_post(&g_wrbuffer.sem);
+  mempool_free(&g_wrbuffer, wrb);
 }
 
 /****************************************************************************
@@ -211,16 +233,7 @@ void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb)
 
 int tcp_wrbuffer_test(void)
 {
-  int val = 0;
-  int ret;
-
-  ret = nxsem_getvalue(&g_wrbuffer.sem, &val);
-  if (ret >= 0)
-    {
-      ret = val > 0 ? OK : -ENOSPC;
-    }
-
-  return ret;
+  return mempool_navail(&g_wrbuffer, false) > 0 ? OK : -ENOSPC;
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_WRITE_BUFFERS */
@@ -61,6 +61,17 @@
 
 #define NET_UDP_HAVE_STACK 1
 
+/* Connection hash table */
+
+#ifndef CONFIG_NET_UDP_HASHSIZE
+#  define CONFIG_NET_UDP_HASHSIZE 8
+#endif
+
+#if CONFIG_NET_UDP_HASHSIZE < 1 || \
+    (CONFIG_NET_UDP_HASHSIZE & (CONFIG_NET_UDP_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_UDP_HASHSIZE must be a power of two
+#endif
+
 /* Conditions for support UDP poll/select operations */
 
 #if !defined(CONFIG_DISABLE_POLL) && CONFIG_NSOCKET_DESCRIPTORS > 0 && \
@@ -98,6 +109,8 @@ struct udp_hdr_s;         /* Forward reference */
 struct udp_conn_s
 {
   dq_entry_t node;        /* Supports a doubly linked list */
+  FAR struct udp_conn_s *hnext; /* Next bound connection in the same
+                                 * local port hash bucket */
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -368,6 +381,30 @@ struct udp_wrbuffer_s;
 FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void);
 #endif /* CONFIG_NET_UDP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: udp_wrbuffer_tryalloc
+ *
+ * Description:
+ *   Allocate a UDP write buffer without waiting and without an initial I/O
+ *   buffer.  This is used when the caller already has the I/O buffer chain
+ *   to be sent.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The write buffer with wb_iob set to NULL, or NULL if no write buffer is
+ *   available.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_WRITE_BUFFERS) && defined(CONFIG_NET_IOB_LOAN)
+FAR struct udp_wrbuffer_s *udp_wrbuffer_tryalloc(void);
+#endif
+
 /****************************************************************************
  * Name: udp_wrbuffer_release
  *
@@ -594,6 +631,31 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
                          size_t len, int flags, FAR const struct sockaddr *to,
                          socklen_t tolen);
 
+/****************************************************************************
+ * Name: psock_udp_sendtoiob
+ *
+ * Description:
+ *   Queue a caller-provided I/O buffer chain as one UDP datagram without
+ *   copying it.  On success, the chain belongs to the network.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iob      The I/O buffer chain holding the datagram payload
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  On failure, a negated
+ *   errno value is returned and the caller still owns the chain.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IOB_LOAN) && defined(CONFIG_NET_UDP_WRITE_BUFFERS)
+struct iob_s;
+ssize_t psock_udp_sendtoiob(FAR struct socket *psock, FAR struct iob_s *iob,
+                            FAR const struct sockaddr *to, socklen_t tolen);
+#endif
+
 /****************************************************************************
  * Name: udp_pollsetup
  *
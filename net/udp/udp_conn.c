@@ -73,6 +73,8 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#define UDP_HASH_MASK (CONFIG_NET_UDP_HASHSIZE - 1)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,6 +92,10 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+/* Connections bound to a local port, hashed by local port */
+
+static FAR struct udp_conn_s *g_udp_porthash[CONFIG_NET_UDP_HASHSIZE];
+
 /* Last port used by a UDP connection connection. */
 
 static uint16_t g_last_udp_port;
@@ -126,6 +132,68 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_portndx
+ *
+ * Description:
+ *   Return the index of the hash bucket for a local port number (network
+ *   byte order).
+ *
+ ****************************************************************************/
+
+static inline unsigned int udp_portndx(uint16_t portno)
+{
+  return (portno ^ (portno >> 8)) & UDP_HASH_MASK;
+}
+
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Change the local port (network byte order) of a connection and move it
+ *   to the corresponding bucket of the local port hash table.  Every
+ *   connection with a non-zero local port is in the table.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+  FAR struct udp_conn_s **link;
+
+  if (conn->lport != 0)
+    {
+      for (link = &g_udp_porthash[udp_portndx(conn->lport)];
+           *link != NULL;
+           link = &(*link)->hnext)
+        {
+          if (*link == conn)
+            {
+              *link = conn->hnext;
+              break;
+            }
+        }
+    }
+
+  conn->lport = portno;
+  conn->hnext = NULL;
+
+  if (portno != 0)
+    {
+      /* Keep the bucket in binding order */
+
+      link = &g_udp_porthash[udp_portndx(portno)];
+      while (*link != NULL)
+        {
+          link = &(*link)->hnext;
+        }
+
+      *link = conn;
+    }
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -142,14 +210,15 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
-  int i;
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure bound to a port in the same hash
+   * bucket.
+   */
 
-  for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
+  for (conn = g_udp_porthash[udp_portndx(portno)];
+       conn != NULL;
+       conn = conn->hnext)
     {
-      conn = &g_udp_connections[i];
-
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
        * reference to the connection structure.  INADDR_ANY is a special
@@ -266,7 +335,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  /* Only the connections bound to a port in the same hash bucket as the
+   * destination port can match.
+   */
+
+  conn = g_udp_porthash[udp_portndx(udp->destport)];
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -327,9 +400,9 @@ static inline FAR struct udp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection in the hash bucket */
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+      conn = conn->hnext;
     }
 
   return conn;
@@ -355,7 +428,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  /* Only the connections bound to a port in the same hash bucket as the
+   * destination port can match.
+   */
+
+  conn = g_udp_porthash[udp_portndx(udp->destport)];
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -416,9 +493,9 @@ static inline FAR struct udp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection in the hash bucket */
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+      conn = conn->hnext;
     }
 
   return conn;
@@ -448,11 +525,17 @@ void udp_initialize(void)
   dq_init(&g_active_udp_connections);
   nxsem_init(&g_free_sem, 0, 1);
 
+  for (i = 0; i < CONFIG_NET_UDP_HASHSIZE; i++)
+    {
+      g_udp_porthash[i] = NULL;
+    }
+
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       /* Mark the connection closed and move it to the free list */
 
       g_udp_connections[i].lport = 0;
+      g_udp_connections[i].hnext = NULL;
       dq_addlast(&g_udp_connections[i].node, &g_free_udp_connections);
     }
 
@@ -520,7 +603,14 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+
+  /* Release the local port.  The port hash table is also accessed by the
+   * network input logic.
+   */
+
+  net_lock();
+  udp_setport(conn, 0);
+  net_unlock();
 
   /* Remove the connection from the active list */
 
@@ -663,38 +753,37 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     }
 #endif /* CONFIG_NET_IPv6 */
 
+  /* Interrupts must be disabled while access the UDP connection list */
+
+  net_lock();
+
   /* Is the user requesting to bind to any port? */
 
   if (portno == 0)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setport(conn, htons(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
-      /* Interrupts must be disabled while access the UDP connection list */
-
-      net_lock();
-
       /* Is any other UDP connection already bound to this address and port? */
 
       if (udp_find_conn(conn->domain, &conn->u, portno) == NULL)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
-          ret         = OK;
+          udp_setport(conn, portno);
+          ret = OK;
         }
       else
         {
-          ret         = -EADDRINUSE;
+          ret = -EADDRINUSE;
         }
-
-      net_unlock();
     }
 
+  net_unlock();
   return ret;
 }
 
@@ -735,7 +824,9 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      net_lock();
+      udp_setport(conn, htons(udp_select_port(conn->domain, &conn->u)));
+      net_unlock();
     }
 
   /* Is there a remote port (rport)? */
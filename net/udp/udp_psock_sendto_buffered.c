@@ -121,6 +121,11 @@ static inline int sendto_timeout(FAR struct socket *psock,
 #endif
 static int sendto_next_transfer(FAR struct socket *psock,
                                 FAR struct udp_conn_s *conn);
+static inline int sendto_addrmap(FAR struct socket *psock,
+                                 FAR struct udp_conn_s *conn);
+static int sendto_queue(FAR struct socket *psock,
+                        FAR struct udp_conn_s *conn,
+                        FAR struct udp_wrbuffer_s *wrb);
 static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
                                     FAR void *pvconn, FAR void *pvpriv,
                                     uint16_t flags);
@@ -582,6 +587,124 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
   return flags;
 }
 
+/****************************************************************************
+ * Name: sendto_addrmap
+ *
+ * Description:
+ *   Make sure that the link layer address of the peer is known before a
+ *   datagram is queued for transmission.
+ *
+ * Input Parameters:
+ *   psock - Socket state structure
+ *   conn  - The UDP connection structure
+ *
+ * Returned Value:
+ *   OK if the address mapping is available; -ENETUNREACH otherwise.
+ *
+ ****************************************************************************/
+
+static inline int sendto_addrmap(FAR struct socket *psock,
+                                 FAR struct udp_conn_s *conn)
+{
+#if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
+  int ret;
+
+#ifdef CONFIG_NET_ARP_SEND
+#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
+  if (psock->s_domain == PF_INET)
+#endif
+    {
+      /* Make sure that the IP address mapping is in the ARP table */
+
+      ret = arp_send(conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_ARP_SEND */
+
+#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
+#ifdef CONFIG_NET_ARP_SEND
+  else
+#endif
+    {
+      /* Make sure that the IP address mapping is in the Neighbor Table */
+
+      ret = icmpv6_neighbor(conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_ICMPv6_NEIGHBOR */
+
+  /* Did we successfully get the address mapping? */
+
+  if (ret < 0)
+    {
+      nerr("ERROR: Not reachable\n");
+      return -ENETUNREACH;
+    }
+#endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sendto_queue
+ *
+ * Description:
+ *   Add a filled write buffer to the end of the connection's write queue
+ *   and set up for the next packet transfer.
+ *
+ * Input Parameters:
+ *   psock - Socket state structure
+ *   conn  - The UDP connection structure
+ *   wrb   - The write buffer to be queued
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.  On failure, the
+ *   write buffer has been removed from the queue and the caller still owns
+ *   it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int sendto_queue(FAR struct socket *psock,
+                        FAR struct udp_conn_s *conn,
+                        FAR struct udp_wrbuffer_s *wrb)
+{
+  int ret;
+
+  /* Dump I/O buffer chain */
+
+  UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
+
+  /* sendto_eventhandler() will send data in FIFO order from the
+   * conn->write_q.
+   *
+   * REVISIT:  Why FIFO order?  Because it is easy.  In a real world
+   * environment where there are multiple network devices this might
+   * be inefficient because we could be sending data to different
+   * device out-of-queued-order to optimize performance.  Sending
+   * data to different networks from a single UDP socket is probably
+   * not a very common use case, however.
+   */
+
+  sq_addlast(&wrb->wb_node, &conn->write_q);
+  ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
+        wrb, wrb->wb_iob->io_pktlen,
+        conn->write_q.head, conn->write_q.tail);
+
+  /* Set up for the next packet transfer by setting the connection
+   * address to the address of the next packet now at the header of the
+   * write buffer queue.
+   */
+
+  ret = sendto_next_transfer(psock, conn);
+  if (ret < 0)
+    {
+      (void)sq_remlast(&conn->write_q);
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -624,37 +747,11 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
   conn = (FAR struct udp_conn_s *)psock->s_conn;
   DEBUGASSERT(conn);
 
-#if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
-#ifdef CONFIG_NET_ARP_SEND
-#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
-  if (psock->s_domain == PF_INET)
-#endif
-    {
-      /* Make sure that the IP address mapping is in the ARP table */
-
-      ret = arp_send(conn->u.ipv4.raddr);
-    }
-#endif /* CONFIG_NET_ARP_SEND */
-
-#ifdef CONFIG_NET_ICMPv6_NEIGHBOR
-#ifdef CONFIG_NET_ARP_SEND
-  else
-#endif
-    {
-      /* Make sure that the IP address mapping is in the Neighbor Table */
-
-      ret = icmpv6_neighbor(conn->u.ipv6.raddr);
-    }
-#endif /* CONFIG_NET_ICMPv6_NEIGHBOR */
-
-  /* Did we successfully get the address mapping? */
-
+  ret = sendto_addrmap(psock, conn);
   if (ret < 0)
     {
-      nerr("ERROR: Not reachable\n");
-      return -ENETUNREACH;
+      return ret;
     }
-#endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
   /* Dump the incoming buffer */
 
@@ -706,37 +803,13 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_wrb;
         }
 
-      /* Dump I/O buffer chain */
-
-      UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
-
-      /* sendto_eventhandler() will send data in FIFO order from the
-       * conn->write_q.
-       *
-       * REVISIT:  Why FIFO order?  Because it is easy.  In a real world
-       * environment where there are multiple network devices this might
-       * be inefficient because we could be sending data to different
-       * device out-of-queued-order to optimize performance.  Sending
-       * data to different networks from a single UDP socket is probably
-       * not a very common use case, however.
-       */
-
-      sq_addlast(&wrb->wb_node, &conn->write_q);
-      ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
-            wrb, wrb->wb_iob->io_pktlen,
-            conn->write_q.head, conn->write_q.tail);
-
-      /* Set up for the next packet transfer by setting the connection
-       * address to the address of the next packet now at the header of the
-       * write buffer queue.
-       */
+      /* Queue the datagram and set up the next transfer */
 
-     ret = sendto_next_transfer(psock, conn);
-     if (ret < 0)
-       {
-         (void)sq_remlast(&conn->write_q);
-         goto errout_with_wrb;
-       }
+      ret = sendto_queue(psock, conn, wrb);
+      if (ret < 0)
+        {
+          goto errout_with_wrb;
+        }
 
       net_unlock();
     }
@@ -757,4 +830,99 @@ errout_with_lock:
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_udp_sendtoiob
+ *
+ * Description:
+ *   Queue a caller-provided I/O buffer chain as one UDP datagram.  The
+ *   chain becomes the payload of a write buffer without being copied;
+ *   ownership passes to the network on success.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iob      The I/O buffer chain holding the datagram payload.  io_pktlen
+ *            must be valid in the head buffer.
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes queued.  On failure, a negated
+ *   errno value is returned and the caller still owns the chain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_LOAN
+ssize_t psock_udp_sendtoiob(FAR struct socket *psock, FAR struct iob_s *iob,
+                            FAR const struct sockaddr *to, socklen_t tolen)
+{
+  FAR struct udp_conn_s *conn;
+  FAR struct udp_wrbuffer_s *wrb;
+  ssize_t len;
+  int ret;
+
+  DEBUGASSERT(psock != NULL && iob != NULL && to != NULL);
+
+  conn = (FAR struct udp_conn_s *)psock->s_conn;
+  DEBUGASSERT(conn);
+
+  if (tolen > sizeof(struct sockaddr_storage))
+    {
+      return -EINVAL;
+    }
+
+  ret = sendto_addrmap(psock, conn);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  len = iob->io_pktlen;
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
+
+  /* Allocate a write buffer for the caller's chain.  Do not wait for one:
+   * The caller can free or retry with its own chain.
+   */
+
+  net_lock();
+  wrb = udp_wrbuffer_tryalloc();
+  if (wrb == NULL)
+    {
+      nerr("ERROR: Failed to allocate write buffer\n");
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  memcpy(&wrb->wb_dest, to, tolen);
+#ifdef CONFIG_NET_SOCKOPTS
+  wrb->wb_start = clock_systimer();
+#endif
+
+  wrb->wb_iob = iob;
+
+  ret = sendto_queue(psock, conn, wrb);
+  if (ret < 0)
+    {
+      /* Give the chain back to the caller */
+
+      wrb->wb_iob = NULL;
+      udp_wrbuffer_release(wrb);
+      goto errout_with_lock;
+    }
+
+  net_unlock();
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_IDLE);
+  return len;
+
+errout_with_lock:
+  net_unlock();
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_IDLE);
+  return ret;
+}
+#endif /* CONFIG_NET_IOB_LOAN */
+
 #endif /* CONFIG_NET && CONFIG_NET_UDP && CONFIG_NET_UDP_WRITE_BUFFERS */
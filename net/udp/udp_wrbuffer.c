@@ -52,41 +52,33 @@
 #include <assert.h>
 #include <debug.h>
 
-#include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #include "udp/udp.h"
 
 /****************************************************************************
- * Private Types
+ * Private Data
  ****************************************************************************/
 
-/* Package all globals used by this logic into a structure */
-
-struct wrbuffer_s
-{
-  /* The semaphore to protect the buffers */
-
-  sem_t sem;
+/* These are the pre-allocated write buffers */
 
-  /* This is the list of available write buffers */
+static struct udp_wrbuffer_s g_wrbuffers[CONFIG_NET_UDP_NWRBCHAINS];
 
-  sq_queue_t freebuffers;
+/* This is the pool of available write buffers.  Waiting for a write buffer
+ * must not hold the network lock.
+ */
 
-  /* These are the pre-allocated write buffers */
-
-  struct udp_wrbuffer_s buffers[CONFIG_NET_UDP_NWRBCHAINS];
+static struct mempool_s g_wrbuffer =
+{
+  "udp_wrbuffer",                 /* name */
+  sizeof(struct udp_wrbuffer_s),  /* bsize */
+  0,                              /* nreserve */
+  0,                              /* nexpand */
+  net_lockedwait                  /* wait */
 };
 
-/****************************************************************************
- * Private Data
- ****************************************************************************/
-
-/* This is the state of the global write buffer resource */
-
-static struct wrbuffer_s g_wrbuffer;
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -104,16 +96,7 @@ static struct wrbuffer_s g_wrbuffer;
 
 void udp_wrbuffer_initialize(void)
 {
-  int i;
-
-  sq_init(&g_wrbuffer.freebuffers);
-
-  for (i = 0; i < CONFIG_NET_UDP_NWRBCHAINS; i++)
-    {
-      sq_addfirst(&g_wrbuffer.buffers[i].wb_node, &g_wrbuffer.freebuffers);
-    }
-
-  nxsem_init(&g_wrbuffer.sem, 0, CONFIG_NET_UDP_NWRBCHAINS);
+  mempool_initialize(&g_wrbuffer, g_wrbuffers, CONFIG_NET_UDP_NWRBCHAINS);
 }
 
 /****************************************************************************
@@ -144,14 +127,13 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
    * buffer
    */
 
-  DEBUGVERIFY(net_lockedwait(&g_wrbuffer.sem)); /* TODO: Handle EINTR. */
-
-  /* Now, we are guaranteed to have a write buffer structure reserved
-   * for us in the free list.
-   */
+  wrb = (FAR struct udp_wrbuffer_s *)mempool_alloc(&g_wrbuffer, false);
+  if (wrb == NULL)
+    {
+      nerr("ERROR: Failed to allocate write buffer\n");
+      return NULL;
+    }
 
-  wrb = (FAR struct udp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
-  DEBUGASSERT(wrb);
   memset(wrb, 0, sizeof(struct udp_wrbuffer_s));
 
   /* Now get the first I/O buffer for the write buffer structure */
@@ -167,6 +149,42 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
   return wrb;
 }
 
+/****************************************************************************
+ * Name: udp_wrbuffer_tryalloc
+ *
+ * Description:
+ *   Allocate a UDP write buffer without waiting and without an initial I/O
+ *   buffer.  This is used when the caller already has the I/O buffer chain
+ *   to be sent.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The write buffer with wb_iob set to NULL, or NULL if no write buffer is
+ *   available.
+ *
+ * Assumptions:
+ *   Called from user logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IOB_LOAN
+FAR struct udp_wrbuffer_s *udp_wrbuffer_tryalloc(void)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+
+  wrb = (FAR struct udp_wrbuffer_s *)mempool_tryalloc(&g_wrbuffer, false);
+  if (wrb == NULL)
+    {
+      return NULL;
+    }
+
+  memset(wrb, 0, sizeof(struct udp_wrbuffer_s));
+  return wrb;
+}
+#endif /* CONFIG_NET_IOB_LOAN */
+
 /****************************************************************************
  * Name: udp_wrbuffer_release
  *
@@ -182,18 +200,22 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
 
 void udp_wrbuffer_release(FAR struct udp_wrbuffer_s *wrb)
 {
-  DEBUGASSERT(wrb && wrb->wb_iob);
+  DEBUGASSERT(wrb);
 
   /* To avoid deadlocks, we must following this ordering:  Release the I/O
-   * buffer chain first, then the write buffer structure.
+   * buffer chain first, then the write buffer structure.  There is no
+   * chain if the write buffer was allocated without one and the chain was
+   * handed back to the caller.
    */
 
-  iob_free_chain(wrb->wb_iob);
+  if (wrb->wb_iob != NULL)
+    {
+      iob_free_chain(wrb->wb_iob);
+    }
 
   /* Then free the write buffer structure */
 
-  sq_addlast(&wrb->wb_node, &g_wrbuffer.freebuffers);
-  nxsem_post(&g_wrbuffer.sem);
+  mempool_free(&g_wrbuffer, wrb);
 }
 
 /****************************************************************************
@@ -209,9 +231,7 @@ void udp_wrbuffer_release(FAR struct udp_wrbuffer_s *wrb)
 
 int udp_wrbuffer_test(void)
 {
-  int val = 0;
-  nxsem_getvalue(&g_wrbuffer.sem, &val);
-  return val > 0 ? OK : ERROR;
+  return mempool_navail(&g_wrbuffer, false) > 0 ? OK : ERROR;
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_UDP && CONFIG_NET_UDP_WRITE_BUFFERS */
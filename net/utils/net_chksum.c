@@ -41,6 +41,7 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -82,40 +83,86 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint16_t *wptr;
+  uint32_t acc = 0;
+  bool odd;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (len == 0)
+    {
+      return sum;
+    }
 
-  while (dataptr < last_byte)
+  /* The one's complement sum is independent of byte order (RFC 1071), so
+   * the data is summed as native 16-bit words and the result is converted
+   * to host order at the end.  If the data begins on an odd address, the
+   * first byte is summed alone and the remaining words are then aligned.
+   * They are summed byte-swapped and the result is swapped back.
+   */
+
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd)
     {
-      /* At least two more bytes */
+#ifdef CONFIG_ENDIAN_BIG
+      acc = *data;
+#else
+      acc = (uint32_t)*data << 8;
+#endif
+      data++;
+      len--;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  /* Sum 16 bytes per iteration.  The 32-bit accumulator cannot overflow:
+   * len is at most 65535, i.e., less than 32768 16-bit words.
+   */
 
-      dataptr += 2;
+  wptr = (FAR const uint16_t *)data;
+  while (len >= 16)
+    {
+      acc += wptr[0];
+      acc += wptr[1];
+      acc += wptr[2];
+      acc += wptr[3];
+      acc += wptr[4];
+      acc += wptr[5];
+      acc += wptr[6];
+      acc += wptr[7];
+      wptr += 8;
+      len  -= 16;
     }
 
-  if (dataptr == last_byte)
+  while (len >= 2)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      acc += *wptr++;
+      len -= 2;
     }
 
-  /* Return sum in host byte order. */
+  /* A trailing byte is the high order byte of a zero-padded word */
+
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint32_t)*(FAR const uint8_t *)wptr << 8;
+#else
+      acc += *(FAR const uint8_t *)wptr;
+#endif
+    }
+
+  /* Fold the carries back into 16 bits (twice is always enough) */
+
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  if (odd)
+    {
+      acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+  /* Add the partial sum, in host order, with the end-around carry */
+
+  acc = (uint32_t)ntohs((uint16_t)acc) + sum;
+  acc = (acc >> 16) + (acc & 0xffff);
 
-  return sum;
+  return (uint16_t)acc;
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
@@ -39,11 +39,8 @@
 
 #include <nuttx/config.h>
 
-#include <queue.h>
-
-#include <nuttx/irq.h>
-#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "mqueue/mqueue.h"
 
@@ -69,36 +66,11 @@
 
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
 {
-  irqstate_t flags;
-
-  /* If this is a generally available pre-allocated message,
-   * then just put it back in the free list.
-   */
+  /* If this is a pre-allocated message, then just return it to the pool */
 
   if (mqmsg->type == MQ_ALLOC_FIXED)
     {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
-    }
-
-  /* If this is a message pre-allocated for interrupts,
-   * then put it back in the correct  free list.
-   */
-
-  else if (mqmsg->type == MQ_ALLOC_IRQ)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
-      leave_critical_section(flags);
+      mempool_free(&g_msgpool, mqmsg);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
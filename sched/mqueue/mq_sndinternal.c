@@ -54,6 +54,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/mm/mempool.h>
 
 #include "sched/sched.h"
 #ifndef CONFIG_DISABLE_SIGNALS
@@ -118,18 +119,15 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be allocated from g_msgpool.
  *
- *   If the list is empty AND the message is NOT being allocated from the
- *   interrupt level, then the message will be allocated.  If a message
- *   cannot be obtained, the operating system is dead and therefore cannot
- *   continue.
+ *   Interrupt handlers may take any message in the pool, including those
+ *   reserved for interrupt handlers.  If the pool is empty, the calling
+ *   interrupt handler will be notified.
  *
- *   If the list is empty AND the message IS being allocated from the
- *   interrupt level.  This function will attempt to get a message from
- *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
- *   handler will be notified.
+ *   Tasks may not take the reserved messages.  If no unreserved message is
+ *   available AND the message is NOT being allocated from the interrupt
+ *   level, then the message will be allocated from the heap.
  *
  * Input Parameters:
  *   None
@@ -143,55 +141,34 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
 FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 {
   FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
+  bool inirq = up_interrupt_context();
 
-  /* If we were called from an interrupt handler, then try to get the message
-   * from generally available list of messages. If this fails, then try the
-   * list of messages reserved for interrupt handlers
+  /* Try to get the message from the pool.  Only interrupt handlers may use
+   * the reserved messages.
    */
 
-  if (up_interrupt_context())
+  mqmsg = (FAR struct mqueue_msg_s *)mempool_tryalloc(&g_msgpool, !inirq);
+  if (mqmsg != NULL)
     {
-      /* Try the general free list */
-
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      if (mqmsg == NULL)
-        {
-          /* Try the free list reserved for interrupt handlers */
-
-          mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
-        }
+      mqmsg->type = MQ_ALLOC_FIXED;
     }
 
-  /* We were not called from an interrupt handler. */
+  /* If we cannot get a message from the pool and we were not called from
+   * an interrupt handler, then we will have to allocate one.
+   */
 
-  else
+  else if (!inirq)
     {
-      /* Try to get the message from the generally available free list.
-       * Disable interrupts -- we might be called from an interrupt handler.
-       */
-
-      flags = enter_critical_section();
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
+      mqmsg = (FAR struct mqueue_msg_s *)
+        kmm_malloc((sizeof (struct mqueue_msg_s)));
 
-      /* If we cannot a message from the free list, then we will have to
-       * allocate one.
-       */
+      /* Check if we allocated the message */
 
-      if (mqmsg == NULL)
+      if (mqmsg != NULL)
         {
-          mqmsg = (FAR struct mqueue_msg_s *)
-            kmm_malloc((sizeof (struct mqueue_msg_s)));
-
-          /* Check if we allocated the message */
+          /* Yes... remember that this message was dynamically allocated */
 
-          if (mqmsg != NULL)
-            {
-              /* Yes... remember that this message was dynamically allocated */
-
-              mqmsg->type = MQ_ALLOC_DYN;
-            }
+          mqmsg->type = MQ_ALLOC_DYN;
         }
     }
 
@@ -52,6 +52,7 @@
 #include <signal.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/mm/mempool.h>
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -81,9 +82,8 @@
 
 enum mqalloc_e
 {
-  MQ_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
-  MQ_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_FIXED = 0,  /* From g_msgpool; returned to the pool */
+  MQ_ALLOC_DYN         /* dynamically allocated; free when unused */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -113,17 +113,11 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_msgfree is a list of messages that are available for general use.
- * The number of messages in this list is a system configuration item.
+/* g_msgpool is the pool of pre-allocated messages.  The last
+ * NUM_INTERRUPT_MSGS messages are reserved for use by interrupt handlers.
  */
 
-EXTERN sq_queue_t  g_msgfree;
-
-/* The g_msgfreeInt is a list of messages that are reserved for use by
- * interrupt handlers.
- */
-
-EXTERN sq_queue_t  g_msgfreeirq;
+EXTERN struct mempool_s g_msgpool;
 
 /* The g_desfree data structure is a list of message descriptors available
  * to the operating system for general use. The number of messages in the
@@ -112,6 +112,10 @@
 #  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
 #endif
 
+/* Number of 32-bit words in the priority bitmap of a ready-to-run list */
+
+#define SCHED_PRIOBITMAP_NWORDS  ((SCHED_PRIORITY_MAX + 32) >> 5)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -146,6 +150,21 @@ struct tasklist_s
   uint8_t attr;                   /* List attribute flags */
 };
 
+#ifdef CONFIG_SCHED_PRIOBITMAP
+/* This structure indexes one ready-to-run list by priority.  The list
+ * itself is still a single, prioritized doubly linked list;  the index
+ * records which priority levels are present in the list and the last TCB at
+ * each level so that the insertion point for a new TCB can be found without
+ * walking the list.
+ */
+
+struct sched_prioindex_s
+{
+  uint32_t bitmap[SCHED_PRIOBITMAP_NWORDS];       /* Populated levels */
+  FAR struct tcb_s *last[SCHED_PRIORITY_MAX + 1]; /* Last TCB at each level */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -395,6 +414,24 @@ bool sched_removereadytorun(FAR struct tcb_s *rtrtcb);
 bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
 void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
                             uint8_t task_state);
+
+/* Priority index for the ready-to-run lists */
+
+#ifdef CONFIG_SCHED_PRIOBITMAP
+FAR struct sched_prioindex_s *sched_prioindex(DSEG dq_queue_t *list);
+FAR struct tcb_s *sched_prioindex_last(FAR struct sched_prioindex_s *index,
+                                       uint8_t sched_priority);
+void sched_prioindex_add(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+void sched_prioindex_remove(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+void sched_prioindex_rebuild(DSEG dq_queue_t *list);
+void sched_remprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+#else
+#  define sched_prioindex_add(tcb,list)
+#  define sched_prioindex_remove(tcb,list)
+#  define sched_prioindex_rebuild(list)
+#  define sched_remprioritized(tcb,list) \
+     dq_rem((FAR dq_entry_t *)(tcb), (list))
+#endif
 bool sched_mergepending(void);
 void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
@@ -448,6 +485,11 @@ FAR struct tcb_s *this_task(void);
 int  sched_cpu_select(cpu_set_t affinity);
 int  sched_cpu_pause(FAR struct tcb_s *tcb);
 
+#ifdef CONFIG_SMP_RUNQUEUE
+int  sched_runqueue_cpu(FAR struct tcb_s *tcb, int cpu);
+FAR struct tcb_s *sched_runqueue_steal(int cpu, uint8_t sched_priority);
+#endif
+
 irqstate_t sched_tasklist_lock(void);
 void sched_tasklist_unlock(irqstate_t lock);
 
@@ -78,6 +78,9 @@
 
 bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 {
+#ifdef CONFIG_SCHED_PRIOBITMAP
+  FAR struct sched_prioindex_s *index;
+#endif
   FAR struct tcb_s *next;
   FAR struct tcb_s *prev;
   uint8_t sched_priority = tcb->sched_priority;
@@ -87,13 +90,28 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   ASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
-  /* Search the list to find the location to insert the new Tcb.
-   * Each is list is maintained in descending sched_priority order.
+#ifdef CONFIG_SCHED_PRIOBITMAP
+  /* If the list is indexed, then the new TCB goes just after the last TCB
+   * with the same or higher priority.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
-       next = next->flink);
+  index = sched_prioindex(list);
+  if (index != NULL)
+    {
+      prev = sched_prioindex_last(index, sched_priority);
+      next = prev != NULL ? prev->flink : (FAR struct tcb_s *)list->head;
+    }
+  else
+#endif
+    {
+      /* Search the list to find the location to insert the new Tcb.
+       * Each is list is maintained in descending sched_priority order.
+       */
+
+      for (next = (FAR struct tcb_s *)list->head;
+           (next && sched_priority <= next->sched_priority);
+           next = next->flink);
+    }
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
@@ -151,6 +169,9 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+  /* Update the index of the list, if any */
+
+  sched_prioindex_add(tcb, list);
   return ret;
 }
 
@@ -193,6 +193,12 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
        */
 
       cpu = sched_cpu_select(btcb->affinity);
+
+#ifdef CONFIG_SMP_RUNQUEUE
+      /* Then decide which CPU's run queue should receive the task */
+
+      cpu = sched_runqueue_cpu(btcb, cpu);
+#endif
     }
 
   /* Get the task currently running on the CPU (may be the IDLE task) */
@@ -224,7 +230,9 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
   else
     {
       task_state = TSTATE_TASK_READYTORUN;
+#ifndef CONFIG_SMP_RUNQUEUE
       cpu = 0;  /* CPU does not matter */
+#endif
     }
 
   /* If the selected state is TSTATE_TASK_RUNNING, then we would like to
@@ -262,9 +270,22 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
        * Add the task to the ready-to-run (but not running) task list
        */
 
+#ifdef CONFIG_SMP_RUNQUEUE
+      /* Queue the task on the selected CPU's run queue.  It has no higher
+       * priority than the task running on that CPU, so it will not become
+       * the head of the list and there is no need to pause that CPU.
+       */
+
+      (void)sched_addprioritized(btcb,
+                                 (FAR dq_queue_t *)&g_assignedtasks[cpu]);
+
+      btcb->cpu        = cpu;
+      btcb->task_state = TSTATE_TASK_ASSIGNED;
+#else
       (void)sched_addprioritized(btcb, (FAR dq_queue_t *)&g_readytorun);
 
       btcb->task_state = TSTATE_TASK_READYTORUN;
+#endif
       doswitch         = false;
     }
   else /* (task_state == TSTATE_TASK_ASSIGNED || task_state == TSTATE_TASK_RUNNING) */
@@ -378,11 +399,22 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
               DEBUGASSERT(next->cpu == cpu);
               next->task_state = TSTATE_TASK_ASSIGNED;
             }
+#ifdef CONFIG_SMP_RUNQUEUE
+          else if (!sched_islocked_global())
+            {
+              /* Leave the pre-empted task at the front of this CPU's run
+               * queue.
+               */
+
+              DEBUGASSERT(next->cpu == cpu);
+              next->task_state = TSTATE_TASK_ASSIGNED;
+            }
+#endif
           else
             {
               /* Remove the task from the assigned task list */
 
-              dq_rem((FAR dq_entry_t *)next, tasklist);
+              sched_remprioritized(next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
                * list.  NOTE: That the above operations may cause the
@@ -152,6 +152,10 @@ bool sched_mergepending(void)
           ptcb->task_state  = TSTATE_TASK_READYTORUN;
         }
 
+      /* Update the index of the ready-to-run list, if any */
+
+      sched_prioindex_add(ptcb, (FAR dq_queue_t *)&g_readytorun);
+
       /* Set up for the next time through */
 
       rtcb = ptcb;
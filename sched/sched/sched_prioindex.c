@@ -0,0 +1,315 @@
+/****************************************************************************
+ * sched/sched/sched_prioindex.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIOBITMAP
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* One index for each ready-to-run list */
+
+static struct sched_prioindex_s g_readytorunindex;
+
+#ifdef CONFIG_SMP
+static struct sched_prioindex_s g_assignedindex[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex
+ *
+ * Description:
+ *   Return the priority index associated with a task list.
+ *
+ * Input Parameters:
+ *   list - Points to the task list
+ *
+ * Returned Value:
+ *   The index of the ready-to-run list or NULL if the list is not indexed.
+ *
+ ****************************************************************************/
+
+FAR struct sched_prioindex_s *sched_prioindex(DSEG dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorunindex;
+    }
+
+#ifdef CONFIG_SMP
+  if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+      list < (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedindex[list - (FAR dq_queue_t *)g_assignedtasks];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_last
+ *
+ * Description:
+ *   Find the last TCB in an indexed list with a priority greater than or
+ *   equal to sched_priority.  A new TCB with that priority must be inserted
+ *   immediately after this TCB.
+ *
+ * Input Parameters:
+ *   index - The index of the list
+ *   sched_priority - The priority of the TCB to be inserted
+ *
+ * Returned Value:
+ *   The TCB after which to insert or NULL if the TCB must be inserted at the
+ *   head of the list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_prioindex_last(FAR struct sched_prioindex_s *index,
+                                       uint8_t sched_priority)
+{
+  uint32_t bitset;
+  int ndx;
+
+  /* Is there already a TCB with this priority?  Then the new TCB goes after
+   * the last of them.
+   */
+
+  if (index->last[sched_priority] != NULL)
+    {
+      return index->last[sched_priority];
+    }
+
+  /* Otherwise, it goes after the last TCB of the next higher populated
+   * priority level.  Mask off this priority and all lower levels in the
+   * first word.
+   */
+
+  ndx    = sched_priority >> 5;
+  bitset = index->bitmap[ndx] &
+           ~(((uint32_t)2 << (sched_priority & 31)) - 1);
+
+  for (; ; )
+    {
+      if (bitset != 0)
+        {
+          return index->last[(ndx << 5) + ffsl((long)bitset) - 1];
+        }
+
+      if (++ndx >= SCHED_PRIOBITMAP_NWORDS)
+        {
+          /* No higher priority TCB in the list */
+
+          return NULL;
+        }
+
+      bitset = index->bitmap[ndx];
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_add
+ *
+ * Description:
+ *   Update the index of a list after a TCB has been inserted at its
+ *   prioritized position in the list.
+ *
+ * Input Parameters:
+ *   tcb - The TCB that was added to the list
+ *   list - The list that the TCB was added to
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_add(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+  FAR struct sched_prioindex_s *index = sched_prioindex(list);
+  FAR struct tcb_s *next;
+  uint8_t sched_priority;
+
+  if (index != NULL)
+    {
+      /* The TCB is the last at its level unless it was inserted before
+       * another TCB of the same priority.
+       */
+
+      sched_priority = tcb->sched_priority;
+      next           = tcb->flink;
+
+      if (next == NULL || next->sched_priority != sched_priority)
+        {
+          index->last[sched_priority] = tcb;
+          index->bitmap[sched_priority >> 5] |=
+            (uint32_t)1 << (sched_priority & 31);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_remove
+ *
+ * Description:
+ *   Update the index of a list before a TCB is removed from the list.
+ *
+ * Input Parameters:
+ *   tcb - The TCB that is about to be removed from the list
+ *   list - The list that the TCB resides in
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_remove(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+  FAR struct sched_prioindex_s *index = sched_prioindex(list);
+  FAR struct tcb_s *prev;
+  uint8_t sched_priority;
+
+  if (index != NULL)
+    {
+      sched_priority = tcb->sched_priority;
+      if (index->last[sched_priority] == tcb)
+        {
+          /* The previous TCB becomes the last at this level.  If there is
+           * none, the level is now empty.
+           */
+
+          prev = tcb->blink;
+          if (prev != NULL && prev->sched_priority == sched_priority)
+            {
+              index->last[sched_priority] = prev;
+            }
+          else
+            {
+              index->last[sched_priority] = NULL;
+              index->bitmap[sched_priority >> 5] &=
+                ~((uint32_t)1 << (sched_priority & 31));
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_rebuild
+ *
+ * Description:
+ *   Rebuild the index of a list after the list has been modified as a
+ *   whole, for example, when two lists are merged.
+ *
+ * Input Parameters:
+ *   list - The list to be re-indexed
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_rebuild(DSEG dq_queue_t *list)
+{
+  FAR struct sched_prioindex_s *index = sched_prioindex(list);
+  FAR struct tcb_s *tcb;
+
+  if (index != NULL)
+    {
+      memset(index, 0, sizeof(struct sched_prioindex_s));
+
+      for (tcb = (FAR struct tcb_s *)list->head;
+           tcb != NULL;
+           tcb = tcb->flink)
+        {
+          sched_prioindex_add(tcb, list);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_remprioritized
+ *
+ * Description:
+ *   Remove a TCB from a prioritized task list, keeping the index of the
+ *   list (if any) up to date.
+ *
+ * Input Parameters:
+ *   tcb - Points to the TCB to remove from the list
+ *   list - Points to the prioritized list that contains the TCB
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_remprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+  sched_prioindex_remove(tcb, list);
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+#endif /* CONFIG_SCHED_PRIOBITMAP */
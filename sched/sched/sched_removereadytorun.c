@@ -101,7 +101,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
+  sched_remprioritized(rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -171,6 +171,10 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
     {
       FAR struct tcb_s *nxttcb;
       FAR struct tcb_s *rtrtcb = NULL;
+#ifdef CONFIG_SMP_RUNQUEUE
+      FAR struct tcb_s *stltcb = NULL;
+      uint8_t priority;
+#endif
       int me;
 
       /* There must always be at least one task in the list (the IDLE task)
@@ -198,7 +202,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      sched_remprioritized(rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
        * next tcb in the assigned task list (nxttcb) or a TCB in the
@@ -219,28 +223,65 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
           for (rtrtcb = (FAR struct tcb_s *)g_readytorun.head;
                rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
                rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
+
+#ifdef CONFIG_SMP_RUNQUEUE
+          /* A higher priority task may be waiting in the run queue of some
+           * other, busy CPU.  If so, steal it.
+           */
+
+          priority = nxttcb->sched_priority;
+          if (rtrtcb != NULL && rtrtcb->sched_priority > priority)
+            {
+              priority = rtrtcb->sched_priority;
+            }
+
+          stltcb = sched_runqueue_steal(cpu, priority);
+#endif
         }
 
       /* Did we find a task in the g_readytorun list?  Which task should
        * we use?  We decide strictly by the priority of the two tasks:
        * Either (1) the task currently at the head of the g_assignedtasks[cpu]
        * list (nexttcb) or (2) the highest priority task from the
-       * g_readytorun list with matching affinity (rtrtcb).
+       * g_readytorun list with matching affinity (rtrtcb).  With per-CPU
+       * run queues, (3) a task stolen from another CPU (stltcb) has higher
+       * priority than either.
        */
 
+#ifdef CONFIG_SMP_RUNQUEUE
+      if (stltcb != NULL)
+        {
+          FAR dq_queue_t *stllist;
+
+          /* Move the stolen task to the head of this CPU's list.  It is not
+           * the head of its old list so the other CPU need not be paused.
+           */
+
+          stllist = (FAR dq_queue_t *)&g_assignedtasks[stltcb->cpu];
+          sched_remprioritized(stltcb, stllist);
+
+          dq_addfirst((FAR dq_entry_t *)stltcb, tasklist);
+          sched_prioindex_add(stltcb, tasklist);
+
+          stltcb->cpu = cpu;
+          nxttcb = stltcb;
+        }
+      else
+#endif
       if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority)
         {
           FAR struct tcb_s *tmptcb;
 
-          /* The TCB at the head of the ready to run list has the higher
-           * priority.  Remove that task from the head of the g_readytorun
-           * list and add to the head of the g_assignedtasks[cpu] list.
+          /* The TCB from the ready to run list has the higher priority.
+           * Remove that task from the g_readytorun list and add it to the
+           * head of the g_assignedtasks[cpu] list.
            */
 
-          tmptcb = (FAR struct tcb_s *)
-            dq_remfirst((FAR dq_queue_t *)&g_readytorun);
+          tmptcb = rtrtcb;
+          sched_remprioritized(tmptcb, (FAR dq_queue_t *)&g_readytorun);
 
           dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          sched_prioindex_add(tmptcb, tasklist);
 
           tmptcb->cpu = cpu;
           nxttcb = tmptcb;
@@ -328,7 +369,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      sched_remprioritized(rtcb, tasklist);
     }
 
   /* Since the TCB is no longer in any list, it is now invalid */
@@ -0,0 +1,175 @@
+/****************************************************************************
+ * sched/sched/sched_runqueue.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <sched.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_RUNQUEUE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_runqueue_cpu
+ *
+ * Description:
+ *   Select the CPU whose assigned task list will receive a task that has
+ *   just become ready-to-run.
+ *
+ *   If the task will not run yet, it is queued on the CPU it last ran on,
+ *   provided that its affinity permits.  Any such CPU is running a task of
+ *   higher or equal priority, so the head of that CPU's list is unchanged
+ *   and the CPU need not be paused.
+ *
+ *   If the task will pre-empt, then any CPU running a task with the same
+ *   priority as the lowest priority running task is an equally good choice.
+ *   Prefer the CPU the task last ran on, then the current CPU, to avoid a
+ *   migration or pausing another CPU.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task that is ready-to-run
+ *   cpu - The CPU running the lowest priority task as returned by
+ *         sched_cpu_select()
+ *
+ * Returned Value:
+ *   The index of the selected CPU.
+ *
+ * Assumptions:
+ *   The caller holds the task list lock.
+ *
+ ****************************************************************************/
+
+int sched_runqueue_cpu(FAR struct tcb_s *tcb, int cpu)
+{
+  uint8_t lowest = current_task(cpu)->sched_priority;
+  int prev = tcb->cpu;
+  int me;
+
+  DEBUGASSERT((unsigned int)prev < CONFIG_SMP_NCPUS);
+
+  if (tcb->sched_priority <= lowest)
+    {
+      /* The task will not run yet */
+
+      return CPU_ISSET(prev, &tcb->affinity) ? prev : cpu;
+    }
+
+  /* The task will pre-empt the task running on some CPU */
+
+  if (prev != cpu && CPU_ISSET(prev, &tcb->affinity) &&
+      current_task(prev)->sched_priority == lowest)
+    {
+      return prev;
+    }
+
+  me = this_cpu();
+  if (me != cpu && CPU_ISSET(me, &tcb->affinity) &&
+      current_task(me)->sched_priority == lowest)
+    {
+      return me;
+    }
+
+  return cpu;
+}
+
+/****************************************************************************
+ * Name: sched_runqueue_steal
+ *
+ * Description:
+ *   Find the highest priority task that is queued (but not running) on
+ *   some other CPU, that may run on 'cpu', and that has a priority
+ *   strictly higher than sched_priority.  The TCB is not removed from its
+ *   list.
+ *
+ * Input Parameters:
+ *   cpu - The CPU that is looking for a task to run
+ *   sched_priority - The priority of the best task found so far
+ *
+ * Returned Value:
+ *   The TCB of the task to steal or NULL if there is none.
+ *
+ * Assumptions:
+ *   The caller holds the task list lock.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_runqueue_steal(int cpu, uint8_t sched_priority)
+{
+  FAR struct tcb_s *stltcb = NULL;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      /* Skip over the running task at the head of the list.  The lists are
+       * prioritized so the first eligible TCB is the best one in this list
+       * and the search can stop at the first TCB that is not better than
+       * what we already have.
+       */
+
+      for (tcb  = ((FAR struct tcb_s *)g_assignedtasks[i].head)->flink;
+           tcb != NULL && tcb->sched_priority > sched_priority;
+           tcb  = tcb->flink)
+        {
+          if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+              CPU_ISSET(cpu, &tcb->affinity))
+            {
+              stltcb         = tcb;
+              sched_priority = tcb->sched_priority;
+              break;
+            }
+        }
+    }
+
+  return stltcb;
+}
+
+#endif /* CONFIG_SMP_RUNQUEUE */
@@ -91,18 +91,28 @@ static FAR struct tcb_s *sched_nexttcb(FAR struct tcb_s *tcb)
            rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
            rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
 
-      /* Return the TCB from the readyt-to-run list if it is the next
+      /* Use the TCB from the readyt-to-run list if it is the next
        * highest priority task.
        */
 
       if (rtrtcb != NULL &&
           rtrtcb->sched_priority >= nxttcb->sched_priority)
         {
-          return rtrtcb;
+          nxttcb = rtrtcb;
         }
+
+#ifdef CONFIG_SMP_RUNQUEUE
+      /* Or a higher priority task queued on another CPU */
+
+      rtrtcb = sched_runqueue_steal(cpu, nxttcb->sched_priority);
+      if (rtrtcb != NULL)
+        {
+          nxttcb = rtrtcb;
+        }
+#endif
     }
 
-  /* Otherwise, return the next TCB in the g_assignedtasks[] list...
+  /* Otherwise, the next TCB in the g_assignedtasks[] list...
    * probably the TCB of the IDLE thread.
    * REVISIT:  What if it is not the IDLE thread?
    */
@@ -164,9 +174,29 @@ static inline void sched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_PRIOBITMAP
+      FAR dq_queue_t *tasklist;
+
+      /* The task stays at the head of its list, but it moves to a different
+       * level of the list index.
+       */
+
+#ifdef CONFIG_SMP
+      tasklist = TLIST_HEAD(tcb->task_state, tcb->cpu);
+#else
+      tasklist = TLIST_HEAD(tcb->task_state);
+#endif
+
+      sched_prioindex_remove(tcb, tasklist);
+#endif
+
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+
+#ifdef CONFIG_SCHED_PRIOBITMAP
+      sched_prioindex_add(tcb, tasklist);
+#endif
     }
 }
 
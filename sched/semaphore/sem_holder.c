@@ -45,6 +45,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <nuttx/arch.h>
+#include <nuttx/mm/mempool.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -76,7 +77,17 @@ typedef int (*holderhandler_t)(FAR struct semholder_s *pholder,
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 static struct semholder_s g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS];
-static FAR struct semholder_s *g_freeholders;
+
+/* The pool of free holder structures */
+
+static struct mempool_s g_freeholders =
+{
+  "semholder",                 /* name */
+  sizeof(struct semholder_s),  /* bsize */
+  0,                           /* nreserve */
+  0,                           /* nexpand */
+  NULL                         /* wait */
+};
 #endif
 
 /****************************************************************************
@@ -93,14 +104,11 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
    */
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  pholder = g_freeholders;
+  pholder = (FAR struct semholder_s *)mempool_tryalloc(&g_freeholders, false);
   if (pholder != NULL)
     {
-      /* Remove the holder from the free list an put it into the semaphore's
-       * holder list
-       */
+      /* Put the holder into the semaphore's holder list */
 
-      g_freeholders    = pholder->flink;
       pholder->flink   = sem->hhead;
       sem->hhead       = pholder;
 
@@ -229,10 +237,9 @@ static inline void nxsem_freeholder(sem_t *sem,
           sem->hhead = pholder->flink;
         }
 
-      /* And put it in the free list */
+      /* And return it to the pool */
 
-      pholder->flink = g_freeholders;
-      g_freeholders  = pholder;
+      mempool_free(&g_freeholders, pholder);
     }
 #endif
 }
@@ -858,17 +865,10 @@ static inline void nxsem_restorebaseprio_task(FAR struct tcb_s *stcb,
 void nxsem_initholders(void)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  int i;
-
-  /* Put all of the pre-allocated holder structures into the free list */
-
-  g_freeholders = g_holderalloc;
-  for (i = 0; i < (CONFIG_SEM_PREALLOCHOLDERS - 1); i++)
-    {
-      g_holderalloc[i].flink = &g_holderalloc[i + 1];
-    }
+  /* Put all of the pre-allocated holder structures into the pool */
 
-  g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS - 1].flink = NULL;
+  mempool_initialize(&g_freeholders, g_holderalloc,
+                     CONFIG_SEM_PREALLOCHOLDERS);
 #endif
 }
 
@@ -1188,15 +1188,7 @@ void sem_enumholders(FAR sem_t *sem)
 int nxsem_nfreeholders(void)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  FAR struct semholder_s *pholder;
-  int n;
-
-  for (pholder = g_freeholders, n = 0; pholder; pholder = pholder->flink)
-    {
-      n++;
-    }
-
-  return n;
+  return mempool_navail(&g_freeholders, false);
 #else
   return 0;
 #endif
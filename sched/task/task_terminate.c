@@ -146,9 +146,12 @@ int task_terminate(pid_t pid, bool nonblocking)
 
   cpu = sched_cpu_pause(dtcb);
 
-  /* Get the task list associated with the thread's state and CPU */
+  /* Get the task list associated with the thread's state and CPU.  NOTE:
+   * 'cpu' is negative if the task is not running, but an assigned task is
+   * still in the list of its CPU.
+   */
 
-  tasklist = TLIST_HEAD(dtcb->task_state, cpu);
+  tasklist = TLIST_HEAD(dtcb->task_state, dtcb->cpu);
 #else
   /* In the non-SMP case, we can be assured that the task to be terminated
    * is not running.  get the task list associated with the task state.
@@ -159,7 +162,7 @@ int task_terminate(pid_t pid, bool nonblocking)
 
   /* Remove the task from the task list */
 
-  dq_rem((FAR dq_entry_t *)dtcb, tasklist);
+  sched_remprioritized(dtcb, tasklist);
   dtcb->task_state = TSTATE_TASK_INVALID;
 
   /* At this point, the TCB should no longer be accessible to the system */
@@ -72,8 +72,10 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -89,6 +91,16 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      /* Unlink the watchdog from its wheel slot.  The next expiration time
+       * can only change if that slot is now empty.
+       */
+
+      if (wd_wheel_remove(wdog))
+        {
+          sched_timer_reassess();
+        }
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -138,6 +150,7 @@ int wd_cancel(WDOG_ID wdog)
 
           sched_timer_reassess();
         }
+#endif
 
       /* Mark the watchdog inactive */
 
@@ -43,9 +43,10 @@
 #include <queue.h>
 
 #include <nuttx/irq.h>
-#include <nuttx/wdog.h>
+#include <nuttx/arch.h>
 #include <nuttx/wdog.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "wdog/wdog.h"
 
@@ -72,50 +73,19 @@
 WDOG_ID wd_create (void)
 {
   FAR struct wdog_s *wdog;
-  irqstate_t flags;
+  bool inirq = up_interrupt_context();
 
-  /* These actions must be atomic with respect to other tasks and also with
-   * respect to interrupt handlers that may be allocating or freeing watchdog
-   * timers.
+  /* Take a timer from the pool.  Only interrupt handlers may use the timers
+   * reserved for interrupt handlers.
    */
 
-  flags = enter_critical_section();
-
-  /* If we are in an interrupt handler -OR- if the number of pre-allocated
-   * timer structures exceeds the reserve, then take the next timer from
-   * the head of the free list.
-   */
-
-  if (g_wdnfree > CONFIG_WDOG_INTRESERVE || up_interrupt_context())
+  wdog = (FAR struct wdog_s *)mempool_tryalloc(&g_wdpool, !inirq);
+  if (wdog != NULL)
     {
-      /* Remove the watchdog timer from the free list */
-
-      wdog = (FAR struct wdog_s *)sq_remfirst(&g_wdfreelist);
-
-      /* Did we get one? */
-
-      if (wdog != NULL)
-        {
-          /* Yes.. decrement the count of free, pre-allocated timers (all
-           * with interrupts disabled).
-           */
+      /* Clear the forward link and all flags */
 
-          DEBUGASSERT(g_wdnfree > 0);
-          g_wdnfree--;
-
-          /* Clear the forward link and all flags */
-
-          wdog->next  = NULL;
-          wdog->flags = 0;
-        }
-      else
-        {
-          /* We didn't get one... The count should then be exactly zero */
-
-          DEBUGASSERT(g_wdnfree == 0);
-        }
-
-      leave_critical_section(flags);
+      wdog->next  = NULL;
+      wdog->flags = 0;
     }
 
   /* We are in a normal tasking context AND there are not enough unreserved,
@@ -123,11 +93,8 @@ WDOG_ID wd_create (void)
    * heap.
    */
 
-  else
+  else if (!inirq)
     {
-      /* We do not require that interrupts be disabled to do this. */
-
-      leave_critical_section(flags);
       wdog = (FAR struct wdog_s *)kmm_malloc(sizeof(struct wdog_s));
 
       /* Did we get one? */
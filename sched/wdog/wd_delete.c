@@ -48,6 +48,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "wdog/wdog.h"
 
@@ -119,14 +120,10 @@ int wd_delete(WDOG_ID wdog)
 
   else if (!WDOG_ISSTATIC(wdog))
     {
-      /* Put the timer back on the free list and increment the count of free
-       * timers, all with interrupts disabled.
-       */
+      /* Return the timer to the pool */
 
-      sq_addlast((FAR sq_entry_t *)wdog, &g_wdfreelist);
-      g_wdnfree++;
-      DEBUGASSERT(g_wdnfree <= CONFIG_PREALLOC_WDOGS);
       leave_critical_section(flags);
+      mempool_free(&g_wdpool, wdog);
     }
 
   /* This function should not be called for statically allocated timers. */
@@ -74,6 +74,14 @@ int wd_gettime(WDOG_ID wdog)
   flags = enter_critical_section();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+      /* The watchdog holds its expiration time */
+
+      int delay = wd_wheel_remaining(wdog);
+
+      leave_critical_section(flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -92,6 +100,7 @@ int wd_gettime(WDOG_ID wdog)
               return delay;
             }
         }
+#endif
     }
 
   leave_critical_section(flags);
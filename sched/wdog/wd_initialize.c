@@ -41,41 +41,46 @@
 
 #include <queue.h>
 
+#include <nuttx/mm/mempool.h>
+
 #include "wdog/wdog.h"
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* The g_wdfreelist data structure is a singly linked list of watchdogs
- * available to the system for delayed function use.
+/* g_wdpool is the pool of pre-allocated watchdogs available to the system
+ * for delayed function use.  The last CONFIG_WDOG_INTRESERVE watchdogs are
+ * reserved for interrupt handlers.
  */
 
-sq_queue_t g_wdfreelist;
-
+struct mempool_s g_wdpool =
+{
+  "wdog",                   /* name */
+  sizeof(struct wdog_s),    /* bsize */
+  CONFIG_WDOG_INTRESERVE,   /* nreserve */
+  0,                        /* nexpand */
+  NULL                      /* wait */
+};
+
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
-
-/* This is the number of free, pre-allocated watchdog structures in the
- * g_wdfreelist.  This value is used to enforce a reserve for interrupt
- * handlers.
- */
-
-uint16_t g_wdnfree;
+#endif
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* g_wdpool is a list of pre-allocated watchdogs. The number of watchdogs
+/* g_wdalloc holds the pre-allocated watchdogs. The number of watchdogs
  * in the pool is a configuration item.
  */
 
-static struct wdog_s g_wdpool[CONFIG_PREALLOC_WDOGS];
+static struct wdog_s g_wdalloc[CONFIG_PREALLOC_WDOGS];
 
 /****************************************************************************
  * Public Functions
@@ -102,24 +107,17 @@ static struct wdog_s g_wdpool[CONFIG_PREALLOC_WDOGS];
 
 void wd_initialize(void)
 {
-  FAR struct wdog_s *wdog = g_wdpool;
-  int i;
-
   /* Initialize watchdog lists */
 
-  sq_init(&g_wdfreelist);
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  wd_wheel_initialize();
+#else
   sq_init(&g_wdactivelist);
+#endif
 
-  /* The g_wdfreelist must be loaded at initialization time to hold the
-   * configured number of watchdogs.
+  /* The pool must be loaded at initialization time to hold the configured
+   * number of watchdogs.
    */
 
-  for (i = 0; i < CONFIG_PREALLOC_WDOGS; i++)
-    {
-      sq_addlast((FAR sq_entry_t *)wdog++, &g_wdfreelist);
-    }
-
-  /* All watchdogs are free */
-
-  g_wdnfree = CONFIG_PREALLOC_WDOGS;
+  mempool_initialize(&g_wdpool, g_wdalloc, CONFIG_PREALLOC_WDOGS);
 }
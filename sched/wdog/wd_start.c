@@ -91,6 +91,64 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_dispatch
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog.  It has already been removed from the
+ *          active watchdogs.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void wd_dispatch(FAR struct wdog_s *wdog)
+{
+  /* Execute the watchdog function */
+
+  up_setpicbase(wdog->picbase);
+  switch (wdog->argc)
+    {
+      default:
+        DEBUGPANIC();
+        break;
+
+      case 0:
+        (*((wdentry0_t)(wdog->func)))(0);
+        break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+      case 1:
+        (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+      case 2:
+        (*((wdentry2_t)(wdog->func)))(2,
+                        wdog->parm[0], wdog->parm[1]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+      case 3:
+        (*((wdentry3_t)(wdog->func)))(3,
+                        wdog->parm[0], wdog->parm[1],
+                        wdog->parm[2]);
+        break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+      case 4:
+        (*((wdentry4_t)(wdog->func)))(4,
+                        wdog->parm[0], wdog->parm[1],
+                        wdog->parm[2], wdog->parm[3]);
+        break;
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -98,6 +156,9 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run.  If so, remove the watchdog from the list and execute it.
  *
+ *   With CONFIG_WDOG_TIMERWHEEL, wd_wheel_tick() has already collected the
+ *   expired watchdogs in g_wdexpired.  Remove and execute each of them.
+ *
  * Input Parameters:
  *   None
  *
@@ -106,6 +167,27 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+static inline void wd_expiration(void)
+{
+  FAR struct wdog_s *wdog;
+
+  /* The expiration functions may start or cancel other watchdogs,
+   * including the ones still waiting in g_wdexpired.
+   */
+
+  while ((wdog = (FAR struct wdog_s *)dq_remfirst(&g_wdexpired)) != NULL)
+    {
+      /* Indicate that the watchdog is no longer active. */
+
+      WDOG_CLRACTIVE(wdog);
+
+      /* Execute the watchdog function */
+
+      wd_dispatch(wdog);
+    }
+}
+#else
 static inline void wd_expiration(void)
 {
   FAR struct wdog_s *wdog;
@@ -140,46 +222,11 @@ static inline void wd_expiration(void)
 
           /* Execute the watchdog function */
 
-          up_setpicbase(wdog->picbase);
-          switch (wdog->argc)
-            {
-              default:
-                DEBUGPANIC();
-                break;
-
-              case 0:
-                (*((wdentry0_t)(wdog->func)))(0);
-                break;
-
-#if CONFIG_MAX_WDOGPARMS > 0
-              case 1:
-                (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-              case 2:
-                (*((wdentry2_t)(wdog->func)))(2,
-                                wdog->parm[0], wdog->parm[1]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 2
-              case 3:
-                (*((wdentry3_t)(wdog->func)))(3,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2]);
-                break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 3
-              case 4:
-                (*((wdentry4_t)(wdog->func)))(4,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2], wdog->parm[3]);
-                break;
-#endif
-            }
+          wd_dispatch(wdog);
         }
     }
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -222,10 +269,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
   int i;
 
@@ -288,6 +337,15 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
   (void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  /* Put the watchdog in the wheel slot that corresponds to its expiration
+   * time and mark it as active.
+   */
+
+  wd_wheel_add(wdog, delay);
+  WDOG_SETACTIVE(wdog);
+
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -377,6 +435,7 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 
   wdog->lag = delay;
   WDOG_SETACTIVE(wdog);
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Resume the interval timer that will generate the next interval event.
@@ -416,7 +475,94 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
  *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_WDOG_TIMERWHEEL) && defined(CONFIG_SCHED_TICKLESS)
+unsigned int wd_timer(int ticks)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+#endif
+  unsigned int ret;
+  uint32_t next;
+
+#ifdef CONFIG_SMP
+  /* We are in an interrupt handler as, as a consequence, interrupts are
+   * disabled.  But in the SMP case, interrupst MAY be disabled only on
+   * the local CPU since most architectures do not permit disabling
+   * interrupts on other CPUS.
+   *
+   * Hence, we must follow rules for critical sections even here in the
+   * SMP case.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Advance the wheel by the elapsed ticks, stopping only on the ticks on
+   * which there is something to do.
+   */
+
+  while (ticks > 0)
+    {
+      next = wd_wheel_next();
+      if (next >= (uint32_t)ticks)
+        {
+          wd_wheel_advance(ticks);
+          break;
+        }
+
+      wd_wheel_advance(next);
+      ticks -= next + 1;
+
+      /* Process that tick and run the watchdogs that expired */
+
+      wd_wheel_tick();
+      wd_expiration();
+    }
+
+  /* Return the delay for the next watchdog to expire.  This may also be
+   * the time when a watchdog must move down the wheel; the interval will
+   * be re-assessed then.
+   */
+
+  next = wd_wheel_next();
+  ret  = next == WDOG_WHEEL_IDLE ? 0 : (unsigned int)next + 1;
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+
+  return ret;
+}
+
+#elif defined(CONFIG_WDOG_TIMERWHEEL)
+void wd_timer(void)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+
+  /* We are in an interrupt handler as, as a consequence, interrupts are
+   * disabled.  But in the SMP case, interrupst MAY be disabled only on
+   * the local CPU since most architectures do not permit disabling
+   * interrupts on other CPUS.
+   *
+   * Hence, we must follow rules for critical sections even here in the
+   * SMP case.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Process this tick and run the watchdogs that expired */
+
+  wd_wheel_tick();
+  wd_expiration();
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+}
+
+#elif defined(CONFIG_SCHED_TICKLESS)
 unsigned int wd_timer(int ticks)
 {
   FAR struct wdog_s *wdog;
@@ -518,4 +664,4 @@ void wd_timer(void)
   leave_critical_section(flags);
 #endif
 }
-#endif /* CONFIG_SCHED_TICKLESS */
+#endif
@@ -0,0 +1,435 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each slot of level n spans 32^n clock ticks.  The whole wheel spans
+ * 32^WDOG_WHEEL_LEVELS clock ticks.
+ */
+
+#define WDOG_LEVEL_SHIFT(n) ((n) * WDOG_WHEEL_BITS)
+#define WDOG_LEVEL_SPAN(n)  ((uint32_t)1 << WDOG_LEVEL_SHIFT(n))
+#define WDOG_WHEEL_RANGE    WDOG_LEVEL_SPAN(WDOG_WHEEL_LEVELS)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* g_wdexpired holds the watchdogs that have been removed from the wheel by
+ * wd_wheel_tick() but whose functions have not yet been called.
+ */
+
+dq_queue_t g_wdexpired;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The wheel slots.  Slot s of level n is g_wdwheel[n * 32 + s] */
+
+static dq_queue_t g_wdwheel[WDOG_WHEEL_NSLOTS];
+
+/* One bit for each non-empty slot in each level of the wheel */
+
+static uint32_t g_wdbitmap[WDOG_WHEEL_LEVELS];
+
+/* The next clock tick to be processed by wd_wheel_tick() */
+
+static uint32_t g_wdbase;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Put an active watchdog in the wheel slot that corresponds to its
+ *   expiration time relative to the current position of the wheel.
+ *   Watchdogs that expire beyond the reach of the wheel are parked in the
+ *   last level and re-inserted when that slot is cascaded.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  uint32_t expire = wdog->expire;
+  int32_t delta   = (int32_t)(expire - g_wdbase);
+  int level;
+  int slot;
+
+  if (delta < 0)
+    {
+      /* Already due.  Run it on the next clock tick */
+
+      expire = g_wdbase;
+      level  = 0;
+    }
+  else
+    {
+      if ((uint32_t)delta >= WDOG_WHEEL_RANGE)
+        {
+          expire = g_wdbase + WDOG_WHEEL_RANGE - 1;
+          delta  = WDOG_WHEEL_RANGE - 1;
+        }
+
+      level = 0;
+      while ((uint32_t)delta >= WDOG_LEVEL_SPAN(level + 1))
+        {
+          level++;
+        }
+    }
+
+  slot       = (expire >> WDOG_LEVEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+  wdog->slot = (level << WDOG_WHEEL_BITS) + slot;
+
+  dq_addlast((FAR dq_entry_t *)wdog, &g_wdwheel[wdog->slot]);
+  g_wdbitmap[level] |= (uint32_t)1 << slot;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-insert all of the watchdogs in one slot of a higher level of the
+ *   wheel.  They will move to lower levels of the wheel.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level, int slot)
+{
+  FAR struct wdog_s *wdog;
+  FAR dq_queue_t *queue;
+  uint32_t bit = (uint32_t)1 << slot;
+
+  if ((g_wdbitmap[level] & bit) != 0)
+    {
+      g_wdbitmap[level] &= ~bit;
+
+      queue = &g_wdwheel[(level << WDOG_WHEEL_BITS) + slot];
+      while ((wdog = (FAR struct wdog_s *)dq_remfirst(queue)) != NULL)
+        {
+          wd_wheel_insert(wdog);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timer wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  int i;
+
+  for (i = 0; i < WDOG_WHEEL_NSLOTS; i++)
+    {
+      dq_init(&g_wdwheel[i]);
+    }
+
+  for (i = 0; i < WDOG_WHEEL_LEVELS; i++)
+    {
+      g_wdbitmap[i] = 0;
+    }
+
+  dq_init(&g_wdexpired);
+  g_wdbase = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Add a watchdog to the timer wheel.  The watchdog will expire on the
+ *   'delay'th call to wd_wheel_tick() (or the equivalent number of ticks
+ *   passed to wd_wheel_advance()).
+ *
+ * Input Parameters:
+ *   wdog  - The watchdog to add.
+ *   delay - The delay in clock ticks.  Must be at least one.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog, int32_t delay)
+{
+  DEBUGASSERT(delay > 0);
+
+  wdog->expire = g_wdbase + (uint32_t)delay - 1;
+  wd_wheel_insert(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timer wheel (or from the list of
+ *   expired watchdogs).
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to remove.
+ *
+ * Returned Value:
+ *   True if the removal emptied a slot of the wheel so that the next
+ *   expiration time may have changed.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  FAR dq_queue_t *queue;
+
+  if (wdog->slot == WDOG_SLOT_EXPIRED)
+    {
+      dq_rem((FAR dq_entry_t *)wdog, &g_wdexpired);
+      return false;
+    }
+
+  DEBUGASSERT(wdog->slot < WDOG_WHEEL_NSLOTS);
+
+  queue = &g_wdwheel[wdog->slot];
+  dq_rem((FAR dq_entry_t *)wdog, queue);
+
+  if (dq_empty(queue))
+    {
+      g_wdbitmap[wdog->slot >> WDOG_WHEEL_BITS] &=
+        ~((uint32_t)1 << (wdog->slot & WDOG_WHEEL_MASK));
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of clock ticks remaining before an active watchdog
+ *   expires.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+  int32_t delta;
+
+  if (wdog->slot == WDOG_SLOT_EXPIRED)
+    {
+      return 0;
+    }
+
+  delta = (int32_t)(wdog->expire - g_wdbase) + 1;
+  return delta > 0 ? (int)delta : 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of clock ticks that may be skipped with
+ *   wd_wheel_advance() before wd_wheel_tick() has some work to do:  Either
+ *   an expiration or a cascade of a non-empty slot.  The first non-empty
+ *   slot of each level is found with a single bit scan so this is cheap
+ *   enough to be used to program the interval timer in tickless mode.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The number of ticks that may be skipped or WDOG_WHEEL_IDLE if the
+ *   wheel is empty.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+uint32_t wd_wheel_next(void)
+{
+  uint32_t next = WDOG_WHEEL_IDLE;
+  uint32_t bitmap;
+  uint32_t first;
+  uint32_t delay;
+  int index;
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      bitmap = g_wdbitmap[level];
+      if (bitmap != 0)
+        {
+          /* Slots of this level are processed on the clock ticks that are
+           * multiples of the slot span.  Find the first such tick and
+           * rotate the bitmap so that bit 0 is the slot processed then.
+           */
+
+          first = (g_wdbase + WDOG_LEVEL_SPAN(level) - 1) &
+                  ~(WDOG_LEVEL_SPAN(level) - 1);
+          index = (first >> WDOG_LEVEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+
+          if (index != 0)
+            {
+              bitmap = (bitmap >> index) |
+                       (bitmap << (WDOG_WHEEL_SLOTS - index));
+            }
+
+          delay = first - g_wdbase +
+                  ((uint32_t)(ffsl((long)bitmap) - 1) <<
+                   WDOG_LEVEL_SHIFT(level));
+
+          if (delay < next)
+            {
+              next = delay;
+            }
+        }
+    }
+
+  return next;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_advance
+ *
+ * Description:
+ *   Skip clock ticks on which there is nothing to do.  'ticks' must not
+ *   exceed the value returned by wd_wheel_next().
+ *
+ ****************************************************************************/
+
+void wd_wheel_advance(uint32_t ticks)
+{
+  g_wdbase += ticks;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_tick
+ *
+ * Description:
+ *   Process one clock tick:  Cascade the higher level slots that come due
+ *   at this tick and move the watchdogs that expire at this tick to
+ *   g_wdexpired.  The caller is responsible for running them.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_tick(void)
+{
+  FAR struct wdog_s *wdog;
+  uint32_t now = g_wdbase;
+  uint32_t bit;
+  int level;
+  int slot;
+
+  /* Move the watchdogs in the higher level slots that start at this tick
+   * down the wheel.
+   */
+
+  for (level = 1;
+       level < WDOG_WHEEL_LEVELS &&
+       (now & (WDOG_LEVEL_SPAN(level) - 1)) == 0;
+       level++)
+    {
+      wd_wheel_cascade(level,
+                       (now >> WDOG_LEVEL_SHIFT(level)) & WDOG_WHEEL_MASK);
+    }
+
+  /* Advance the wheel before collecting the expired watchdogs so that
+   * watchdogs restarted by the expiration functions are not confused with
+   * the ones that expire now.
+   */
+
+  g_wdbase = now + 1;
+  slot     = now & WDOG_WHEEL_MASK;
+  bit      = (uint32_t)1 << slot;
+
+  if ((g_wdbitmap[0] & bit) != 0)
+    {
+      g_wdbitmap[0] &= ~bit;
+
+      while ((wdog = (FAR struct wdog_s *)dq_remfirst(&g_wdwheel[slot]))
+             != NULL)
+        {
+          wdog->slot = WDOG_SLOT_EXPIRED;
+          dq_addlast((FAR dq_entry_t *)wdog, &g_wdexpired);
+        }
+    }
+}
+
+#endif /* CONFIG_WDOG_TIMERWHEEL */
@@ -47,6 +47,31 @@
 
 #include <nuttx/compiler.h>
 #include <nuttx/wdog.h>
+#include <nuttx/mm/mempool.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/* Geometry of the timer wheel:  CONFIG_WDOG_WHEEL_LEVELS levels of 32 slots
+ * so that the non-empty slots of one level fit in a 32-bit bitmap.
+ */
+
+#  define WDOG_WHEEL_BITS    5
+#  define WDOG_WHEEL_SLOTS   (1 << WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK    (WDOG_WHEEL_SLOTS - 1)
+#  define WDOG_WHEEL_LEVELS  CONFIG_WDOG_WHEEL_LEVELS
+#  define WDOG_WHEEL_NSLOTS  (WDOG_WHEEL_LEVELS * WDOG_WHEEL_SLOTS)
+
+/* Value of wdog_s::slot for watchdogs that are waiting in g_wdexpired */
+
+#  define WDOG_SLOT_EXPIRED  0xff
+
+/* Returned by wd_wheel_next() when there are no active watchdogs */
+
+#  define WDOG_WHEEL_IDLE    UINT32_MAX
+#endif
 
 /****************************************************************************
  * Public Data
@@ -60,25 +85,27 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_wdfreelist data structure is a singly linked list of watchdogs
- * available to the system for delayed function use.
+/* g_wdpool is the pool of pre-allocated watchdogs available to the system
+ * for delayed function use.  The last CONFIG_WDOG_INTRESERVE watchdogs are
+ * reserved for interrupt handlers.
  */
 
-extern sq_queue_t g_wdfreelist;
+extern struct mempool_s g_wdpool;
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/* g_wdexpired holds the watchdogs that have been removed from the timer
+ * wheel by wd_wheel_tick() but whose functions have not yet been called.
+ */
+
+extern dq_queue_t g_wdexpired;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
-
-/* This is the number of free, pre-allocated watchdog structures in the
- * g_wdfreelist.  This value is used to enforce a reserve for interrupt
- * handlers.
- */
-
-extern uint16_t g_wdnfree;
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -136,6 +163,28 @@ unsigned int wd_timer(int ticks);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_wheel_*
+ *
+ * Description:
+ *   Timer wheel operations used by wd_start(), wd_cancel(), wd_gettime()
+ *   and wd_timer().  See sched/wdog/wd_wheel.c.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+void wd_wheel_initialize(void);
+void wd_wheel_add(FAR struct wdog_s *wdog, int32_t delay);
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+int wd_wheel_remaining(FAR struct wdog_s *wdog);
+uint32_t wd_wheel_next(void);
+void wd_wheel_advance(uint32_t ticks);
+void wd_wheel_tick(void);
+#endif
+
 /****************************************************************************
  * Name: wd_recover
  *
@@ -92,6 +92,14 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   flags = enter_critical_section();
   if (work->worker != NULL)
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+      /* Remove the entry from the ready or delayed work list (re-arming
+       * the timer if necessary) and make sure that it is marked as
+       * available (i.e., the worker field is nullified).
+       */
+
+      work_evremove(wqueue, work);
+#else
       /* A little test of the integrity of the work queue */
 
       DEBUGASSERT(work->dq.flink != NULL ||
@@ -104,6 +112,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
        */
 
       dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+#endif
       work->worker = NULL;
       ret = OK;
     }
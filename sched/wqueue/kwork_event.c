@@ -0,0 +1,480 @@
+/****************************************************************************
+ * sched/wqueue/kwork_event.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <signal.h>
+#include <assert.h>
+#include <queue.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/signal.h>
+#include <nuttx/wdog.h>
+#include <nuttx/wqueue.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_WORKQUEUE_EVENT)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_evqueue
+ *
+ * Description:
+ *   Map a work queue ID to the work queue structure.
+ *
+ ****************************************************************************/
+
+static FAR struct kwork_wqueue_s *work_evqueue(int qid)
+{
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_hpwork;
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+  else
+#endif
+    {
+      return NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: work_remaining
+ *
+ * Description:
+ *   Return the number of clock ticks until delayed work expires.  Zero is
+ *   returned if the work has already expired.
+ *
+ ****************************************************************************/
+
+static inline systime_t work_remaining(FAR struct work_s *work,
+                                       systime_t now)
+{
+  systime_t elapsed = now - work->qtime;
+  return elapsed >= work->delay ? 0 : work->delay - elapsed;
+}
+
+/****************************************************************************
+ * Name: work_timeout
+ *
+ * Description:
+ *   The watchdog timer handler.  Moves all expired work from the delayed
+ *   list to the list of ready work, re-arms the timer for the next delayed
+ *   work (if any) and wakes up a worker thread.
+ *
+ * Input Parameters:
+ *   argc   - The number of arguments (should be 1)
+ *   arg1   - The work queue
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Runs in the context of the timer interrupt handler.
+ *
+ ****************************************************************************/
+
+static void work_timeout(int argc, wdparm_t arg1, ...)
+{
+  FAR struct kwork_wqueue_s *wqueue = (FAR struct kwork_wqueue_s *)arg1;
+  FAR struct work_s *work;
+  irqstate_t flags;
+  systime_t now;
+  bool ready = false;
+
+  DEBUGASSERT(argc == 1 && wqueue != NULL);
+
+  flags = enter_critical_section();
+  now   = clock_systimer();
+
+  /* Move all of the expired work to the list of ready work, preserving the
+   * order of expiration.  The queue time becomes the time of expiration so
+   * that the latency measured by the worker is the dispatch latency only.
+   */
+
+  while ((work = (FAR struct work_s *)wqueue->ev.delayed.head) != NULL &&
+         work_remaining(work, now) == 0)
+    {
+      (void)dq_remfirst(&wqueue->ev.delayed);
+
+      work->qtime += work->delay;
+      work->delay  = 0;
+
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+      ready = true;
+    }
+
+  /* Re-arm the timer for the next delayed work */
+
+  if (work != NULL)
+    {
+      (void)wd_start(wqueue->ev.timer, work_remaining(work, now),
+                     (wdentry_t)work_timeout, 1, (wdparm_t)wqueue);
+    }
+
+  leave_critical_section(flags);
+
+  if (ready)
+    {
+      (void)work_signal(wqueue->ev.qid);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_evinitialize
+ *
+ * Description:
+ *   Initialize the event-driven dispatch state of a work queue.
+ *
+ * Input Parameters:
+ *   wqueue   - Describes the work queue
+ *   qid      - The work queue ID
+ *   nthreads - The number of worker threads
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure.
+ *
+ ****************************************************************************/
+
+int work_evinitialize(FAR struct kwork_wqueue_s *wqueue, int qid,
+                      int nthreads)
+{
+  memset(&wqueue->ev, 0, sizeof(struct kwork_event_s));
+  dq_init(&wqueue->ev.delayed);
+
+  wqueue->ev.qid      = (uint8_t)qid;
+  wqueue->ev.nthreads = (uint8_t)nthreads;
+  wqueue->ev.timer    = wd_create();
+
+  return wqueue->ev.timer != NULL ? OK : -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: work_evinsert
+ *
+ * Description:
+ *   Add work to an event-driven work queue:  to the list of ready work if
+ *   it has no delay or, otherwise, to the list of delayed work.  The
+ *   watchdog timer is re-armed if the work expires before any other delayed
+ *   work.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue
+ *   work   - The work to add.  The qtime and delay fields must be valid.
+ *
+ * Returned Value:
+ *   True if the work is ready to run and a worker should be signalled.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool work_evinsert(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work)
+{
+  FAR struct work_s *next;
+  systime_t remaining;
+  systime_t now;
+
+  if (work->delay == 0)
+    {
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+      return true;
+    }
+
+  /* Find the first delayed work that expires after this one.  Work that
+   * expires at the same time is performed in the order that it was queued.
+   */
+
+  now       = clock_systimer();
+  remaining = work_remaining(work, now);
+
+  for (next = (FAR struct work_s *)wqueue->ev.delayed.head;
+       next != NULL && work_remaining(next, now) <= remaining;
+       next = (FAR struct work_s *)next->dq.flink);
+
+  if (next != NULL)
+    {
+      dq_addbefore((FAR dq_entry_t *)next, (FAR dq_entry_t *)work,
+                   &wqueue->ev.delayed);
+    }
+  else
+    {
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->ev.delayed);
+    }
+
+  /* Re-arm the timer if this is now the first work to expire */
+
+  if (wqueue->ev.delayed.head == (FAR dq_entry_t *)work)
+    {
+      (void)wd_start(wqueue->ev.timer, remaining > 0 ? remaining : 1,
+                     (wdentry_t)work_timeout, 1, (wdparm_t)wqueue);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: work_evremove
+ *
+ * Description:
+ *   Remove queued work from an event-driven work queue, re-arming or
+ *   cancelling the watchdog timer as needed.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue
+ *   work   - The work to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void work_evremove(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work)
+{
+  FAR struct work_s *next;
+  systime_t remaining;
+
+  /* Work with no delay is (or has been moved to) the list of ready work */
+
+  if (work->delay == 0)
+    {
+      (void)dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      return;
+    }
+
+  if (wqueue->ev.delayed.head != (FAR dq_entry_t *)work)
+    {
+      (void)dq_rem((FAR dq_entry_t *)work, &wqueue->ev.delayed);
+      return;
+    }
+
+  /* The work that determines the timer expiration is being removed */
+
+  (void)dq_rem((FAR dq_entry_t *)work, &wqueue->ev.delayed);
+
+  next = (FAR struct work_s *)wqueue->ev.delayed.head;
+  if (next == NULL)
+    {
+      (void)wd_cancel(wqueue->ev.timer);
+    }
+  else
+    {
+      remaining = work_remaining(next, clock_systimer());
+      (void)wd_start(wqueue->ev.timer, remaining > 0 ? remaining : 1,
+                     (wdentry_t)work_timeout, 1, (wdparm_t)wqueue);
+    }
+}
+
+/****************************************************************************
+ * Name: work_process
+ *
+ * Description:
+ *   This is the logic that performs actions placed on any work list.  This
+ *   is the event-driven version:  Delayed work is kept in a separate list,
+ *   ordered by expiration, and is moved to the list of ready work by a
+ *   watchdog timer.  The worker thread sleeps until it is signalled that
+ *   there is ready work;  there is no periodic polling of the work queue.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue to be processed
+ *   period - Not used
+ *   wndx   - The index of the worker thread
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void work_process(FAR struct kwork_wqueue_s *wqueue, systime_t period, int wndx)
+{
+  FAR struct work_s *work;
+  worker_t worker;
+  irqstate_t flags;
+  FAR void *arg;
+  systime_t latency;
+
+  flags = enter_critical_section();
+
+  /* Wait until signalled if there is no ready work.  The worker thread
+   * may also be signalled for reasons other than ready work (such as
+   * garbage collection), in which case we simply return.
+   */
+
+  if (dq_empty(&wqueue->q))
+    {
+      sigset_t set;
+
+      sigemptyset(&set);
+      sigaddset(&set, SIGWORK);
+
+      wqueue->worker[wndx].busy = false;
+      (void)nxsig_waitinfo(&set, NULL);
+      wqueue->worker[wndx].busy = true;
+
+      wqueue->ev.nwakeups++;
+    }
+
+  /* Perform all of the ready work */
+
+  while ((work = (FAR struct work_s *)dq_remfirst(&wqueue->q)) != NULL)
+    {
+      /* Check for a race condition where the work may be nullified
+       * before it is removed from the queue.
+       */
+
+      worker = work->worker;
+      if (worker != NULL)
+        {
+          /* Extract the work argument and mark the work as no longer
+           * being queued (before re-enabling interrupts).
+           */
+
+          arg          = work->arg;
+          work->worker = NULL;
+
+          latency = clock_systimer() - work->qtime;
+          if (latency > wqueue->ev.latmax)
+            {
+              wqueue->ev.latmax = latency;
+            }
+
+          wqueue->ev.latsum += latency;
+          wqueue->ev.nrun++;
+
+          /* Do the work with interrupts re-enabled */
+
+          leave_critical_section(flags);
+          worker(arg);
+          flags = enter_critical_section();
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: work_info
+ *
+ * Description:
+ *   Return statistics for one kernel work queue.
+ *
+ * Input Parameters:
+ *   qid  - The work queue ID
+ *   info - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the work queue does not exist.
+ *
+ ****************************************************************************/
+
+int work_info(int qid, FAR struct work_info_s *info)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  FAR dq_entry_t *entry;
+  irqstate_t flags;
+
+  DEBUGASSERT(info != NULL);
+
+  wqueue = work_evqueue(qid);
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  memset(info, 0, sizeof(struct work_info_s));
+#ifdef CONFIG_SCHED_HPWORK
+  info->name = qid == HPWORK ? HPWORKNAME : LPWORKNAME;
+#else
+  info->name = LPWORKNAME;
+#endif
+
+  flags = enter_critical_section();
+
+  info->nthreads = wqueue->ev.nthreads;
+  info->nrun     = wqueue->ev.nrun;
+  info->nwakeups = wqueue->ev.nwakeups;
+  info->latmax   = TICK2USEC(wqueue->ev.latmax);
+
+  if (wqueue->ev.nrun > 0)
+    {
+      info->latavg = TICK2USEC(wqueue->ev.latsum / wqueue->ev.nrun);
+    }
+
+  for (entry = wqueue->q.head; entry != NULL; entry = entry->flink)
+    {
+      info->nready++;
+    }
+
+  for (entry = wqueue->ev.delayed.head; entry != NULL; entry = entry->flink)
+    {
+      info->ndelayed++;
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE && CONFIG_SCHED_WORKQUEUE_EVENT */
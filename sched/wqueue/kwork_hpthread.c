@@ -144,12 +144,24 @@ static int work_hpthread(int argc, char *argv[])
 int work_hpstart(void)
 {
   pid_t pid;
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  int ret;
+#endif
 
   /* Initialize work queue data structures */
 
   g_hpwork.delay          = CONFIG_SCHED_HPWORKPERIOD / USEC_PER_TICK;
   dq_init(&g_hpwork.q);
 
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  ret = work_evinitialize((FAR struct kwork_wqueue_s *)&g_hpwork, HPWORK, 1);
+  if (ret < 0)
+    {
+      serr("ERROR: work_evinitialize failed: %d\n", ret);
+      return ret;
+    }
+#endif
+
   /* Start the high-priority, kernel mode worker thread */
 
   sinfo("Starting high-priority kernel worker thread\n");
@@ -117,6 +117,15 @@ static int work_lpthread(int argc, char *argv[])
 
   for (; ; )
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+      /* There is no polling thread in the event-driven work queue.  Any
+       * thread may be the one that is signalled, so every thread performs
+       * garbage collection before waiting for the next work.
+       */
+
+      sched_garbage_collection();
+      work_process((FAR struct kwork_wqueue_s *)&g_lpwork, 0, wndx);
+#else
 #if CONFIG_SCHED_LPNTHREADS > 0
       /* Thread 0 is special.  Only thread 0 performs period garbage collection */
 
@@ -153,6 +162,7 @@ static int work_lpthread(int argc, char *argv[])
 
           work_process((FAR struct kwork_wqueue_s *)&g_lpwork, g_lpwork.delay, 0);
         }
+#endif /* CONFIG_SCHED_WORKQUEUE_EVENT */
     }
 
   return OK; /* To keep some compilers happy */
@@ -181,6 +191,9 @@ int work_lpstart(void)
 {
   pid_t pid;
   int wndx;
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  int ret;
+#endif
 
   /* Initialize work queue data structures */
 
@@ -189,6 +202,16 @@ int work_lpstart(void)
   g_lpwork.delay = CONFIG_SCHED_LPWORKPERIOD / USEC_PER_TICK;
   dq_init(&g_lpwork.q);
 
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  ret = work_evinitialize((FAR struct kwork_wqueue_s *)&g_lpwork, LPWORK,
+                          CONFIG_SCHED_LPNTHREADS);
+  if (ret < 0)
+    {
+      serr("ERROR: work_evinitialize failed: %d\n", ret);
+      return ret;
+    }
+#endif
+
   /* Don't permit any of the threads to run until we have fully initialized
    * g_lpwork.
    */
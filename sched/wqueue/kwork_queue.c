@@ -108,7 +108,11 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
        * end of the work queue.
        */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+      work_evremove(wqueue, work);
+#else
       dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+#endif
     }
 
   /* Initialize the work structure. */
@@ -121,7 +125,13 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 
   work->qtime  = clock_systimer(); /* Time work queued */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  /* Delayed work is held back until its watchdog timer expires */
+
+  (void)work_evinsert(wqueue, work);
+#else
   dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#endif
 
   leave_critical_section(flags);
 }
@@ -170,6 +180,15 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
       /* Queue high priority work */
 
       work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+      /* The worker is signalled by the watchdog when delayed work expires */
+
+      if (delay > 0)
+        {
+          return OK;
+        }
+#endif
+
       return work_signal(HPWORK);
     }
   else
@@ -180,6 +199,15 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
       /* Queue low priority work */
 
       work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker, arg, delay);
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+      /* The worker is signalled by the watchdog when delayed work expires */
+
+      if (delay > 0)
+        {
+          return OK;
+        }
+#endif
+
       return work_signal(LPWORK);
     }
   else
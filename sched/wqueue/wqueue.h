@@ -47,6 +47,7 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -62,6 +63,26 @@
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+/* This is the state of an event-driven work queue.  Work that is ready to
+ * run is kept in the q list of the work queue;  delayed work is kept here,
+ * in order of expiration.
+ */
+
+struct kwork_event_s
+{
+  struct dq_queue_s delayed;   /* Delayed work, in order of expiration */
+  WDOG_ID           timer;     /* Expires with the first delayed work */
+  uint8_t           qid;       /* The work queue ID */
+  uint8_t           nthreads;  /* Number of worker threads */
+  uint32_t          nrun;      /* Number of work items run */
+  uint32_t          nwakeups;  /* Number of worker thread wake-ups */
+  systime_t         latsum;    /* Sum of all queuing latencies (ticks) */
+  systime_t         latmax;    /* Maximum queuing latency (ticks) */
+};
+#endif
+
 /* This represents one worker */
 
 struct kworker_s
@@ -76,6 +97,9 @@ struct kwork_wqueue_s
 {
   systime_t         delay;     /* Delay between polling cycles (ticks) */
   struct dq_queue_s q;         /* The queue of pending work */
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  struct kwork_event_s ev;     /* Event-driven dispatch state */
+#endif
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -88,6 +112,9 @@ struct hp_wqueue_s
 {
   systime_t         delay;     /* Delay between polling cycles (ticks) */
   struct dq_queue_s q;         /* The queue of pending work */
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  struct kwork_event_s ev;     /* Event-driven dispatch state */
+#endif
   struct kworker_s  worker[1]; /* Describes the single high priority worker */
 };
 #endif
@@ -101,6 +128,9 @@ struct lp_wqueue_s
 {
   systime_t         delay;  /* Delay between polling cycles (ticks) */
   struct dq_queue_s q;      /* The queue of pending work */
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+  struct kwork_event_s ev;  /* Event-driven dispatch state */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -187,5 +217,76 @@ int work_lpstart(void);
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, systime_t period, int wndx);
 
+/****************************************************************************
+ * Name: work_evinitialize
+ *
+ * Description:
+ *   Initialize the event-driven dispatch state of a work queue.
+ *
+ * Input Parameters:
+ *   wqueue   - Describes the work queue
+ *   qid      - The work queue ID
+ *   nthreads - The number of worker threads
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+int work_evinitialize(FAR struct kwork_wqueue_s *wqueue, int qid,
+                      int nthreads);
+#endif
+
+/****************************************************************************
+ * Name: work_evinsert
+ *
+ * Description:
+ *   Add work to an event-driven work queue:  to the list of ready work if
+ *   it has no delay or, otherwise, to the list of delayed work.  The
+ *   watchdog timer is re-armed if the work expires before any other delayed
+ *   work.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue
+ *   work   - The work to add.  The qtime and delay fields must be valid.
+ *
+ * Returned Value:
+ *   True if the work is ready to run and a worker should be signalled.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+bool work_evinsert(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work);
+#endif
+
+/****************************************************************************
+ * Name: work_evremove
+ *
+ * Description:
+ *   Remove queued work from an event-driven work queue, re-arming or
+ *   cancelling the watchdog timer as needed.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue
+ *   work   - The work to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_EVENT
+void work_evremove(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work);
+#endif
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
 #endif /* __SCHED_WQUEUE_WQUEUE_H */
@@ -381,6 +381,10 @@ uintptr_t STUB_setsockopt(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 uintptr_t STUB_socket(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3);
+uintptr_t STUB_recvmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
+uintptr_t STUB_sendmsg(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
 
 /* The following is defined only if CONFIG_TASK_NAME_SIZE > 0 */
 
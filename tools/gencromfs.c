@@ -47,6 +47,7 @@
 
 #define _GNU_SOURCE 1
 #include <sys/stat.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -112,7 +113,13 @@
 #define CROMFS_MAGIC       0x4d4f5243
 #define CROMFS_BLOCKSIZE   512
 
+#define CROMFS_NODE_BLKTAB 0x0001 /* Regular file with a block offset table */
+
 #define LZF_BUFSIZE        512
+
+#if LZF_BUFSIZE != CROMFS_BLOCKSIZE
+#  error The block offset table requires one LZF block per CROMFS block
+#endif
 #define LZF_HLOG           13
 #define LZF_HSIZE          (1 << LZF_HLOG)
 
@@ -160,7 +167,7 @@ struct cromfs_volume_s
 struct cromfs_node_s
 {
   uint16_t cn_mode;       /* File type, attributes, and access mode bits */
-  uint16_t cn_pad;        /* Not used */
+  uint16_t cn_flags;      /* See CROMFS_NODE_* definitions */
   uint32_t cn_name;       /* Offset from the beginning of the volume header to the
                            * node name string.  NUL-terminated. */
   uint32_t cn_size;       /* Size of the uncompressed data (in bytes) */
@@ -908,7 +915,7 @@ static void gen_dirlink(const char *name, uint32_t tgtoffs, bool dirempty)
           (unsigned long)g_offset, name);
 
   node.cn_mode    = TGT_UINT16(DIRLINK_MODEFLAGS);
-  node.cn_pad     = 0;
+  node.cn_flags   = 0;
 
   g_offset       += sizeof(struct cromfs_node_s);
   node.cn_name    = TGT_UINT32(g_offset);
@@ -991,7 +998,7 @@ static void gen_directory(const char *path, const char *name, mode_t mode,
           (unsigned long)save_offset, path);
 
   node.cn_mode    = TGT_UINT16(NUTTX_IFDIR | get_mode(mode));
-  node.cn_pad     = 0;
+  node.cn_flags   = 0;
 
   save_offset    += sizeof(struct cromfs_node_s);
   node.cn_name    = TGT_UINT32(save_offset);
@@ -1020,22 +1027,20 @@ static void gen_file(const char *path, const char *name, mode_t mode,
   FILE *save_tmpstream = g_tmpstream;
   FILE *outstream;
   FILE *instream;
+  struct stat buf;
   uint8_t iobuffer[LZF_BUFSIZE];
+  uint32_t *blktab;
   size_t nread;
   size_t ntotal;
   size_t blklen;
   size_t blktotal;
+  size_t tabsize;
+  unsigned int nblocks;
   unsigned int blkno;
   int namlen;
 
   namlen      = strlen(name) + 1;
 
-  /* Open a new temporary file */
-
-  outstream   = open_tmpfile();
-  g_tmpstream = outstream;
-  g_offset    = nodeoffs + sizeof(struct cromfs_node_s) + namlen;
-
   /* Open the source data file */
 
   instream    = fopen(path, "r");
@@ -1046,6 +1051,37 @@ static void gen_file(const char *path, const char *name, mode_t mode,
       exit(1);
     }
 
+  /* The block offset table that precedes the data needs the number of
+   * blocks up front.
+   */
+
+  if (fstat(fileno(instream), &buf) < 0)
+    {
+      fprintf(stderr, "fstat for source file %s failed: %s\n",
+              path, strerror(errno));
+      exit(1);
+    }
+
+  nblocks     = (buf.st_size + CROMFS_BLOCKSIZE - 1) / CROMFS_BLOCKSIZE;
+  tabsize     = nblocks * sizeof(uint32_t);
+  blktab      = NULL;
+
+  if (nblocks > 0)
+    {
+      blktab  = (uint32_t *)malloc(tabsize);
+      if (blktab == NULL)
+        {
+          fprintf(stderr, "Failed to allocate block table for %s\n", path);
+          exit(1);
+        }
+    }
+
+  /* Open a new temporary file */
+
+  outstream   = open_tmpfile();
+  g_tmpstream = outstream;
+  g_offset    = nodeoffs + sizeof(struct cromfs_node_s) + namlen + tabsize;
+
   /* Then read data from the file, compress it, and write it to the new
    * temporary file
    */
@@ -1063,6 +1099,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
         {
           uint16_t clen;
 
+          if (blkno >= nblocks)
+            {
+              fprintf(stderr, "Source file %s grew while reading\n", path);
+              exit(1);
+            }
+
+          blktab[blkno] = TGT_UINT32(g_offset);
+
           /* Compress the chunk */
 
           blklen = lzf_compress(iobuffer, nread, &result);
@@ -1094,6 +1138,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
     }
   while (nread > 0);
 
+  fclose(instream);
+
+  if (blkno != nblocks)
+    {
+      fprintf(stderr, "Source file %s shrank while reading\n", path);
+      exit(1);
+    }
+
   /* Restore the old tmpfile context */
 
   g_tmpstream        = save_tmpstream;
@@ -1108,14 +1160,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
           (unsigned long)blktotal);
 
   node.cn_mode       = TGT_UINT16(NUTTX_IFREG | get_mode(mode));
-  node.cn_pad        = 0;
+  node.cn_flags      = TGT_UINT16(CROMFS_NODE_BLKTAB);
 
   nodeoffs          += sizeof(struct cromfs_node_s);
   node.cn_name       = TGT_UINT32(nodeoffs);
 
   node.cn_size       = TGT_UINT32(ntotal);
 
-  nodeoffs          += namlen;
+  nodeoffs          += namlen + tabsize;
   node.u.cn_blocks   = TGT_UINT32(nodeoffs);
 
   nodeoffs          += blktotal;
@@ -1124,6 +1176,15 @@ static void gen_file(const char *path, const char *name, mode_t mode,
   dump_hexbuffer(g_tmpstream, &node, sizeof(struct cromfs_node_s));
   dump_hexbuffer(g_tmpstream, name, namlen);
 
+  if (nblocks > 0)
+    {
+      dump_nextline(g_tmpstream);
+      fprintf(g_tmpstream, "\n  /* Block offset table: %u blocks */\n\n",
+              nblocks);
+      dump_hexbuffer(g_tmpstream, blktab, tabsize);
+      free(blktab);
+    }
+
   g_nnodes++;
 
   /* Now append the sub-tree nodes in the new tmpfile to the previous tmpfile */